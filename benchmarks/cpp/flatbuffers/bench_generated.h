@@ -8,9 +8,9 @@
 
 // Ensure the included flatbuffers.h is the same version as when this file was
 // generated, otherwise it may not be compatible.
-static_assert(FLATBUFFERS_VERSION_MAJOR == 2 &&
-              FLATBUFFERS_VERSION_MINOR == 0 &&
-              FLATBUFFERS_VERSION_REVISION == 6,
+static_assert(FLATBUFFERS_VERSION_MAJOR == 22 &&
+              FLATBUFFERS_VERSION_MINOR == 9 &&
+              FLATBUFFERS_VERSION_REVISION == 29,
              "Non-compatible flatbuffers version included");
 
 namespace benchmarks_flatbuffers {
@@ -21,9 +21,11 @@ struct Bar;
 
 struct FooBar;
 struct FooBarBuilder;
+struct FooBarT;
 
 struct FooBarContainer;
 struct FooBarContainerBuilder;
+struct FooBarContainerT;
 
 enum Enum : int16_t {
   Enum_Apples = 0,
@@ -142,7 +144,20 @@ FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(8) Bar FLATBUFFERS_FINAL_CLASS {
 };
 FLATBUFFERS_STRUCT_END(Bar, 32);
 
+struct FooBarT : public flatbuffers::NativeTable {
+  typedef FooBar TableType;
+  std::unique_ptr<benchmarks_flatbuffers::Bar> sibling{};
+  std::string name{};
+  double rating = 0.0;
+  uint8_t postfix = 0;
+  FooBarT() = default;
+  FooBarT(const FooBarT &o);
+  FooBarT(FooBarT&&) FLATBUFFERS_NOEXCEPT = default;
+  FooBarT &operator=(FooBarT o) FLATBUFFERS_NOEXCEPT;
+};
+
 struct FooBar FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef FooBarT NativeTableType;
   typedef FooBarBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
     VT_SIBLING = 4,
@@ -171,6 +186,9 @@ struct FooBar FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            VerifyField<uint8_t>(verifier, VT_POSTFIX, 1) &&
            verifier.EndTable();
   }
+  FooBarT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(FooBarT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<FooBar> Pack(flatbuffers::FlatBufferBuilder &_fbb, const FooBarT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
 };
 
 struct FooBarBuilder {
@@ -229,7 +247,22 @@ inline flatbuffers::Offset<FooBar> CreateFooBarDirect(
       postfix);
 }
 
+flatbuffers::Offset<FooBar> CreateFooBar(flatbuffers::FlatBufferBuilder &_fbb, const FooBarT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
+struct FooBarContainerT : public flatbuffers::NativeTable {
+  typedef FooBarContainer TableType;
+  std::vector<std::unique_ptr<benchmarks_flatbuffers::FooBarT>> list{};
+  bool initialized = false;
+  benchmarks_flatbuffers::Enum fruit = benchmarks_flatbuffers::Enum_Apples;
+  std::string location{};
+  FooBarContainerT() = default;
+  FooBarContainerT(const FooBarContainerT &o);
+  FooBarContainerT(FooBarContainerT&&) FLATBUFFERS_NOEXCEPT = default;
+  FooBarContainerT &operator=(FooBarContainerT o) FLATBUFFERS_NOEXCEPT;
+};
+
 struct FooBarContainer FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef FooBarContainerT NativeTableType;
   typedef FooBarContainerBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
     VT_LIST = 4,
@@ -260,6 +293,9 @@ struct FooBarContainer FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            verifier.VerifyString(location()) &&
            verifier.EndTable();
   }
+  FooBarContainerT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(FooBarContainerT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<FooBarContainer> Pack(flatbuffers::FlatBufferBuilder &_fbb, const FooBarContainerT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
 };
 
 struct FooBarContainerBuilder {
@@ -319,6 +355,109 @@ inline flatbuffers::Offset<FooBarContainer> CreateFooBarContainerDirect(
       location__);
 }
 
+flatbuffers::Offset<FooBarContainer> CreateFooBarContainer(flatbuffers::FlatBufferBuilder &_fbb, const FooBarContainerT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
+inline FooBarT::FooBarT(const FooBarT &o)
+      : sibling((o.sibling) ? new benchmarks_flatbuffers::Bar(*o.sibling) : nullptr),
+        name(o.name),
+        rating(o.rating),
+        postfix(o.postfix) {
+}
+
+inline FooBarT &FooBarT::operator=(FooBarT o) FLATBUFFERS_NOEXCEPT {
+  std::swap(sibling, o.sibling);
+  std::swap(name, o.name);
+  std::swap(rating, o.rating);
+  std::swap(postfix, o.postfix);
+  return *this;
+}
+
+inline FooBarT *FooBar::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = std::unique_ptr<FooBarT>(new FooBarT());
+  UnPackTo(_o.get(), _resolver);
+  return _o.release();
+}
+
+inline void FooBar::UnPackTo(FooBarT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = sibling(); if (_e) { if (_o->sibling) { *_o->sibling = *_e; } else { _o->sibling = std::unique_ptr<benchmarks_flatbuffers::Bar>(new benchmarks_flatbuffers::Bar(*_e)); } } else if (_o->sibling) { _o->sibling.reset(); } }
+  { auto _e = name(); if (_e) _o->name.assign(_e->c_str(), _e->size()); else _o->name.clear(); }
+  { auto _e = rating(); _o->rating = _e; }
+  { auto _e = postfix(); _o->postfix = _e; }
+}
+
+inline flatbuffers::Offset<FooBar> FooBar::Pack(flatbuffers::FlatBufferBuilder &_fbb, const FooBarT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateFooBar(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<FooBar> CreateFooBar(flatbuffers::FlatBufferBuilder &_fbb, const FooBarT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  struct _VectorArgs { flatbuffers::FlatBufferBuilder *__fbb; const FooBarT* __o; const flatbuffers::rehasher_function_t *__rehasher; } _va = { &_fbb, _o, _rehasher}; (void)_va;
+  auto _sibling = _o->sibling ? _o->sibling.get() : nullptr;
+  auto _name = _o->name.empty() ? 0 : _fbb.CreateString(_o->name);
+  auto _rating = _o->rating;
+  auto _postfix = _o->postfix;
+  return benchmarks_flatbuffers::CreateFooBar(
+      _fbb,
+      _sibling,
+      _name,
+      _rating,
+      _postfix);
+}
+
+inline FooBarContainerT::FooBarContainerT(const FooBarContainerT &o)
+      : initialized(o.initialized),
+        fruit(o.fruit),
+        location(o.location) {
+  list.reserve(o.list.size());
+  for (const auto &list_ : o.list) { list.emplace_back((list_) ? new benchmarks_flatbuffers::FooBarT(*list_) : nullptr); }
+}
+
+inline FooBarContainerT &FooBarContainerT::operator=(FooBarContainerT o) FLATBUFFERS_NOEXCEPT {
+  std::swap(list, o.list);
+  std::swap(initialized, o.initialized);
+  std::swap(fruit, o.fruit);
+  std::swap(location, o.location);
+  return *this;
+}
+
+inline FooBarContainerT *FooBarContainer::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = std::unique_ptr<FooBarContainerT>(new FooBarContainerT());
+  UnPackTo(_o.get(), _resolver);
+  return _o.release();
+}
+
+inline void FooBarContainer::UnPackTo(FooBarContainerT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = list(); if (_e) { _o->list.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { if(_o->list[_i]) { _e->Get(_i)->UnPackTo(_o->list[_i].get(), _resolver); } else { _o->list[_i] = std::unique_ptr<benchmarks_flatbuffers::FooBarT>(_e->Get(_i)->UnPack(_resolver)); }; } } else { _o->list.resize(0); } }
+  { auto _e = initialized(); _o->initialized = _e; }
+  { auto _e = fruit(); _o->fruit = _e; }
+  { auto _e = location(); if (_e) _o->location.assign(_e->c_str(), _e->size()); else _o->location.clear(); }
+}
+
+inline flatbuffers::Offset<FooBarContainer> FooBarContainer::Pack(flatbuffers::FlatBufferBuilder &_fbb, const FooBarContainerT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateFooBarContainer(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<FooBarContainer> CreateFooBarContainer(flatbuffers::FlatBufferBuilder &_fbb, const FooBarContainerT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  struct _VectorArgs { flatbuffers::FlatBufferBuilder *__fbb; const FooBarContainerT* __o; const flatbuffers::rehasher_function_t *__rehasher; } _va = { &_fbb, _o, _rehasher}; (void)_va;
+  auto _list = _o->list.size() ? _fbb.CreateVector<flatbuffers::Offset<benchmarks_flatbuffers::FooBar>> (_o->list.size(), [](size_t i, _VectorArgs *__va) { return CreateFooBar(*__va->__fbb, __va->__o->list[i].get(), __va->__rehasher); }, &_va ) : 0;
+  auto _initialized = _o->initialized;
+  auto _fruit = _o->fruit;
+  auto _location = _o->location.empty() ? 0 : _fbb.CreateString(_o->location);
+  return benchmarks_flatbuffers::CreateFooBarContainer(
+      _fbb,
+      _list,
+      _initialized,
+      _fruit,
+      _location);
+}
+
 inline const benchmarks_flatbuffers::FooBarContainer *GetFooBarContainer(const void *buf) {
   return flatbuffers::GetRoot<benchmarks_flatbuffers::FooBarContainer>(buf);
 }
@@ -349,6 +488,30 @@ inline void FinishSizePrefixedFooBarContainerBuffer(
   fbb.FinishSizePrefixed(root);
 }
 
+inline std::unique_ptr<benchmarks_flatbuffers::FooBarContainerT> UnPackFooBarContainer(
+    const void *buf,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  return std::unique_ptr<benchmarks_flatbuffers::FooBarContainerT>(GetFooBarContainer(buf)->UnPack(res));
+}
+
+inline std::unique_ptr<benchmarks_flatbuffers::FooBarContainerT> UnPackSizePrefixedFooBarContainer(
+    const void *buf,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  return std::unique_ptr<benchmarks_flatbuffers::FooBarContainerT>(GetSizePrefixedFooBarContainer(buf)->UnPack(res));
+}
+
+inline void UnPackToFooBarContainer(
+    const void *buf, benchmarks_flatbuffers::FooBarContainerT *_o,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  GetFooBarContainer(buf)->UnPackTo(_o, res);
+}
+
+inline void UnPackToSizePrefixedFooBarContainer(
+    const void *buf, benchmarks_flatbuffers::FooBarContainerT *_o,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  GetSizePrefixedFooBarContainer(buf)->UnPackTo(_o, res);
+}
+
 }  // namespace benchmarks_flatbuffers
 
 #endif  // FLATBUFFERS_GENERATED_BENCH_BENCHMARKS_FLATBUFFERS_H_
@@ -0,0 +1,254 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "flatbuffers/arena_allocator.h"
+#include "flatbuffers/builder_pool.h"
+#include "flatbuffers/flatbuffers.h"
+#include "flatbuffers/virtual_memory_allocator.h"
+
+using namespace flatbuffers;
+
+// Builds 4 tables for each of `num_vtables` distinct layouts, made from up to
+// 16 optional int fields.
+static void BuildDistinctVtables(FlatBufferBuilder &fbb, int64_t num_vtables) {
+  std::vector<Offset<Table>> tables;
+  for (int64_t i = 0; i < 4 * num_vtables; i++) {
+    const int64_t shape = i % num_vtables + 1;
+    const uoffset_t start = fbb.StartTable();
+    for (voffset_t field = 0; field < 16; field++) {
+      if (shape & (1 << field)) {
+        fbb.AddElement<int32_t>(FieldIndexToOffset(field),
+                                static_cast<int32_t>(i), 0);
+      }
+    }
+    tables.push_back(Offset<Table>(fbb.EndTable(start)));
+  }
+  fbb.Finish(fbb.CreateVector(tables));
+}
+
+static void BuildVtables(benchmark::State &state, bool index_vtables) {
+  const int64_t num_vtables = state.range(0);
+  FlatBufferBuilder fbb;
+  fbb.IndexVtables(index_vtables);
+  for (auto _ : state) {
+    fbb.Clear();
+    BuildDistinctVtables(fbb, num_vtables);
+    benchmark::DoNotOptimize(fbb.GetBufferPointer());
+  }
+  state.SetItemsProcessed(state.iterations() * 4 * num_vtables);
+}
+
+static void BM_Flatbuffers_EndTable_ScanVtables(benchmark::State &state) {
+  BuildVtables(state, false);
+}
+BENCHMARK(BM_Flatbuffers_EndTable_ScanVtables)
+    ->RangeMultiplier(4)
+    ->Range(16, 4096);
+
+static void BM_Flatbuffers_EndTable_IndexVtables(benchmark::State &state) {
+  BuildVtables(state, true);
+}
+BENCHMARK(BM_Flatbuffers_EndTable_IndexVtables)
+    ->RangeMultiplier(4)
+    ->Range(16, 4096);
+
+enum StringDedup { kNoDedup, kSetDedup, kIndexDedup };
+
+// Builds a vector of 10000 strings drawn from `num_distinct` tag values, like
+// repeated tag fields of log records.
+static void BuildTagStrings(benchmark::State &state, StringDedup dedup) {
+  const int64_t num_distinct = state.range(0);
+  const int64_t kNumStrings = 10000;
+  std::vector<std::string> tags;
+  for (int64_t i = 0; i < num_distinct; i++) {
+    tags.push_back("service.tag.value-" + std::to_string(i));
+  }
+  FlatBufferBuilder fbb;
+  fbb.IndexSharedStrings(dedup == kIndexDedup);
+  std::vector<Offset<String>> strings(kNumStrings);
+  for (auto _ : state) {
+    fbb.Clear();
+    for (int64_t i = 0; i < kNumStrings; i++) {
+      // Spread the repeats, so the same tag is not shared back to back.
+      const std::string &tag = tags[(i * 7919) % num_distinct];
+      strings[i] = dedup == kNoDedup ? fbb.CreateString(tag)
+                                     : fbb.CreateSharedString(tag);
+    }
+    fbb.Finish(fbb.CreateVector(strings));
+    benchmark::DoNotOptimize(fbb.GetBufferPointer());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumStrings);
+  state.counters["bytes"] = fbb.GetSize();
+}
+
+static void BM_Flatbuffers_CreateString(benchmark::State &state) {
+  BuildTagStrings(state, kNoDedup);
+}
+BENCHMARK(BM_Flatbuffers_CreateString)->RangeMultiplier(16)->Range(16, 4096);
+
+static void BM_Flatbuffers_CreateSharedString_Set(benchmark::State &state) {
+  BuildTagStrings(state, kSetDedup);
+}
+BENCHMARK(BM_Flatbuffers_CreateSharedString_Set)
+    ->RangeMultiplier(16)
+    ->Range(16, 4096);
+
+static void BM_Flatbuffers_CreateSharedString_Index(benchmark::State &state) {
+  BuildTagStrings(state, kIndexDedup);
+}
+BENCHMARK(BM_Flatbuffers_CreateSharedString_Index)
+    ->RangeMultiplier(16)
+    ->Range(16, 4096);
+
+// Builds and releases a small message, like a request handler would.
+static void BuildAndRelease(FlatBufferBuilder &fbb, int64_t i) {
+  std::vector<Offset<Table>> tables;
+  for (int t = 0; t < 16; t++) {
+    const auto name = fbb.CreateString("request-" + std::to_string(i));
+    const uoffset_t start = fbb.StartTable();
+    fbb.AddOffset(FieldIndexToOffset(0), name);
+    fbb.AddElement<int64_t>(FieldIndexToOffset(1), i, 0);
+    tables.push_back(Offset<Table>(fbb.EndTable(start)));
+  }
+  fbb.Finish(fbb.CreateVector(tables));
+  DetachedBuffer buffer = fbb.Release();
+  benchmark::DoNotOptimize(buffer.data());
+}
+
+static void BM_Flatbuffers_Builder_Fresh(benchmark::State &state) {
+  int64_t i = 0;
+  for (auto _ : state) {
+    FlatBufferBuilder fbb;
+    BuildAndRelease(fbb, i++);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Flatbuffers_Builder_Fresh)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_Flatbuffers_Builder_Pooled(benchmark::State &state) {
+  static FlatBufferBuilderPool pool;
+  int64_t i = 0;
+  for (auto _ : state) {
+    auto fbb = pool.Acquire();
+    BuildAndRelease(*fbb, i++);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Flatbuffers_Builder_Pooled)->ThreadRange(1, 64)->UseRealTime();
+
+// Builds a batch of 1000 small messages, keeping all of them until the batch
+// is done, like a batching producer would.
+static void BuildBatch(benchmark::State &state, ArenaAllocator *arena) {
+  const int kBatchSize = 1000;
+  std::vector<DetachedBuffer> batch;
+  batch.reserve(kBatchSize);
+  for (auto _ : state) {
+    for (int i = 0; i < kBatchSize; i++) {
+      FlatBufferBuilder fbb(256, arena);
+      const auto name = fbb.CreateString("message");
+      const uoffset_t start = fbb.StartTable();
+      fbb.AddOffset(FieldIndexToOffset(0), name);
+      fbb.AddElement<int32_t>(FieldIndexToOffset(1), i, 0);
+      fbb.Finish(Offset<Table>(fbb.EndTable(start)));
+      batch.push_back(fbb.Release());
+    }
+    batch.clear();
+    if (arena) arena->reset();
+  }
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+
+static void BM_Flatbuffers_Batch_DefaultAllocator(benchmark::State &state) {
+  BuildBatch(state, nullptr);
+}
+BENCHMARK(BM_Flatbuffers_Batch_DefaultAllocator);
+
+static void BM_Flatbuffers_Batch_ArenaAllocator(benchmark::State &state) {
+  ArenaAllocator arena(1024 * 1024);
+  BuildBatch(state, &arena);
+}
+BENCHMARK(BM_Flatbuffers_Batch_ArenaAllocator);
+
+// Forwards to another allocator, keeping track of the peak number of bytes
+// allocated at once. For VirtualMemoryAllocator that is address space, of
+// which only the pages written to are backed by memory.
+struct PeakTrackingAllocator : public Allocator {
+  explicit PeakTrackingAllocator(Allocator *upstream, bool grows_in_place)
+      : upstream_(upstream),
+        grows_in_place_(grows_in_place),
+        in_use_(0),
+        peak_(0) {}
+
+  uint8_t *allocate(size_t size) override {
+    Track(static_cast<int64_t>(size));
+    return upstream_->allocate(size);
+  }
+
+  void deallocate(uint8_t *p, size_t size) override {
+    Track(-static_cast<int64_t>(size));
+    upstream_->deallocate(p, size);
+  }
+
+  uint8_t *reallocate_downward(uint8_t *old_p, size_t old_size,
+                               size_t new_size, size_t in_use_back,
+                               size_t in_use_front) override {
+    // Copying goes through allocate() and deallocate() above.
+    if (!grows_in_place_) {
+      return Allocator::reallocate_downward(old_p, old_size, new_size,
+                                            in_use_back, in_use_front);
+    }
+    Track(static_cast<int64_t>(new_size - old_size));
+    return upstream_->reallocate_downward(old_p, old_size, new_size,
+                                          in_use_back, in_use_front);
+  }
+
+  void Track(int64_t delta) {
+    in_use_ += delta;
+    if (in_use_ > peak_) peak_ = in_use_;
+  }
+
+  Allocator *upstream_;
+  bool grows_in_place_;
+  int64_t in_use_;
+  int64_t peak_;
+};
+
+// Builds a 256 MB buffer out of 64 KB byte vectors.
+static void BuildLargeBuffer(benchmark::State &state, Allocator *upstream,
+                             bool grows_in_place) {
+  const size_t kChunkSize = 64 * 1024;
+  const size_t kNumChunks = 4096;
+  const std::vector<uint8_t> chunk(kChunkSize, 0xAB);
+  std::vector<Offset<Vector<uint8_t>>> chunks(kNumChunks);
+  int64_t peak = 0;
+  for (auto _ : state) {
+    PeakTrackingAllocator allocator(upstream, grows_in_place);
+    {
+      FlatBufferBuilder fbb(1024, &allocator);
+      for (size_t i = 0; i < kNumChunks; i++) {
+        chunks[i] = fbb.CreateVector(chunk);
+      }
+      fbb.Finish(fbb.CreateVector(chunks));
+      benchmark::DoNotOptimize(fbb.GetBufferPointer());
+    }
+    peak = allocator.peak_;
+  }
+  state.SetBytesProcessed(state.iterations() * kChunkSize * kNumChunks);
+  state.counters["peak_allocated_MB"] = static_cast<double>(peak) / (1024 * 1024);
+}
+
+static void BM_Flatbuffers_Build256MB_Default(benchmark::State &state) {
+  DefaultAllocator allocator;
+  BuildLargeBuffer(state, &allocator, false);
+}
+BENCHMARK(BM_Flatbuffers_Build256MB_Default)->Unit(benchmark::kMillisecond);
+
+static void BM_Flatbuffers_Build256MB_VirtualMemory(benchmark::State &state) {
+  VirtualMemoryAllocator allocator;
+  BuildLargeBuffer(state, &allocator, true);
+}
+BENCHMARK(BM_Flatbuffers_Build256MB_VirtualMemory)
+    ->Unit(benchmark::kMillisecond);
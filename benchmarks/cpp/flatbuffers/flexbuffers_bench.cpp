@@ -0,0 +1,230 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "flatbuffers/flexbuffers.h"
+#include "flatbuffers/idl.h"
+#include "flatbuffers/json_lines.h"
+
+// Keys like those of a telemetry record.
+static std::string MetricName(int64_t i) {
+  return "service.requests.latency_" + std::to_string(i);
+}
+
+// Builds a map of `num_keys` ints, with `flags`.
+static std::vector<uint8_t> BuildWideMap(int64_t num_keys,
+                                         flexbuffers::BuilderFlag flags) {
+  flexbuffers::Builder fbb(512, flags);
+  fbb.Map([&]() {
+    for (int64_t i = 0; i < num_keys; i++) {
+      fbb.Int(MetricName(i).c_str(), i);
+    }
+  });
+  fbb.Finish();
+  return fbb.GetBuffer();
+}
+
+static void LookupWideMap(benchmark::State &state,
+                          flexbuffers::BuilderFlag flags) {
+  const int64_t num_keys = state.range(0);
+  const auto buffer = BuildWideMap(num_keys, flags);
+  const auto map = flexbuffers::GetRoot(buffer).AsMap();
+  // Present keys in a scattered order.
+  std::vector<std::string> keys;
+  for (int64_t i = 0; i < num_keys; i++) {
+    keys.push_back(MetricName((i * 7919) % num_keys));
+  }
+  size_t i = 0;
+  int64_t sum = 0;
+  for (auto _ : state) {
+    sum += map[keys[i++ % keys.size()].c_str()].AsInt64();
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_Flexbuffers_MapLookup(benchmark::State &state) {
+  LookupWideMap(state, flexbuffers::BUILDER_FLAG_SHARE_KEYS);
+}
+BENCHMARK(BM_Flexbuffers_MapLookup)->Arg(20)->Arg(200)->Arg(2000);
+
+static void BM_Flexbuffers_MapLookup_KeyHashes(benchmark::State &state) {
+  LookupWideMap(state, static_cast<flexbuffers::BuilderFlag>(
+                           flexbuffers::BUILDER_FLAG_SHARE_KEYS |
+                           flexbuffers::BUILDER_FLAG_MAP_KEY_HASHES));
+}
+BENCHMARK(BM_Flexbuffers_MapLookup_KeyHashes)
+    ->Arg(20)
+    ->Arg(200)
+    ->Arg(2000);
+
+static void BM_Flexbuffers_BuildMap(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        BuildWideMap(state.range(0), flexbuffers::BUILDER_FLAG_SHARE_KEYS));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Flexbuffers_BuildMap)->Arg(2000);
+
+static void BM_Flexbuffers_BuildMap_KeyHashes(benchmark::State &state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(BuildWideMap(
+        state.range(0), static_cast<flexbuffers::BuilderFlag>(
+                            flexbuffers::BUILDER_FLAG_SHARE_KEYS |
+                            flexbuffers::BUILDER_FLAG_MAP_KEY_HASHES)));
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Flexbuffers_BuildMap_KeyHashes)->Arg(2000);
+
+// Keys that are already in order, as from a std::map.
+static std::vector<std::string> SortedMetricNames(int64_t num_keys) {
+  std::vector<std::string> names;
+  for (int64_t i = 0; i < num_keys; i++) names.push_back(MetricName(i));
+  std::sort(names.begin(), names.end());
+  return names;
+}
+
+static void BM_Flexbuffers_BuildSortedMap(benchmark::State &state) {
+  const auto names = SortedMetricNames(state.range(0));
+  flexbuffers::Builder fbb(512, flexbuffers::BUILDER_FLAG_NONE);
+  for (auto _ : state) {
+    fbb.Clear();
+    const size_t start = fbb.StartMap();
+    for (size_t i = 0; i < names.size(); i++) fbb.Int(names[i].c_str(), i);
+    fbb.EndMap(start);
+    fbb.Finish();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Flexbuffers_BuildSortedMap)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Arg(10000);
+
+// The same keys, in reverse.
+static void BM_Flexbuffers_BuildUnsortedMap(benchmark::State &state) {
+  const auto names = SortedMetricNames(state.range(0));
+  flexbuffers::Builder fbb(512, flexbuffers::BUILDER_FLAG_NONE);
+  for (auto _ : state) {
+    fbb.Clear();
+    const size_t start = fbb.StartMap();
+    for (size_t i = names.size(); i-- > 0;) fbb.Int(names[i].c_str(), i);
+    fbb.EndMap(start);
+    fbb.Finish();
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Flexbuffers_BuildUnsortedMap)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Arg(10000);
+
+// A vector of `num_records` log records that all have the same keys, like a
+// JSON-lines file.
+static size_t BuildRecords(flexbuffers::Builder &fbb, int64_t num_records) {
+  fbb.Clear();
+  fbb.Vector([&]() {
+    for (int64_t i = 0; i < num_records; i++) {
+      fbb.Map([&]() {
+        fbb.UInt("timestamp", 1600000000000ULL + i);
+        fbb.String("host", "web-01");
+        fbb.String("service", "frontend");
+        fbb.String("level", i % 10 ? "info" : "warn");
+        fbb.UInt("latency_ms", i % 1000);
+        fbb.UInt("status", 200);
+        fbb.UInt("bytes", i * 37 % 65536);
+        fbb.String("method", "GET");
+      });
+    }
+  });
+  fbb.Finish();
+  return fbb.GetSize();
+}
+
+static void BuildRecordsWithFlags(benchmark::State &state,
+                                  flexbuffers::BuilderFlag flags) {
+  flexbuffers::Builder fbb(512, flags);
+  size_t size = 0;
+  for (auto _ : state) size = BuildRecords(fbb, state.range(0));
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+  state.counters["bytes_per_record"] =
+      static_cast<double>(size) / static_cast<double>(state.range(0));
+}
+
+static void BM_Flexbuffers_BuildRecords(benchmark::State &state) {
+  BuildRecordsWithFlags(state,
+                        flexbuffers::BUILDER_FLAG_SHARE_KEYS_AND_STRINGS);
+}
+BENCHMARK(BM_Flexbuffers_BuildRecords)->Arg(100000);
+
+static void BM_Flexbuffers_BuildRecords_ShareKeyVectors(
+    benchmark::State &state) {
+  BuildRecordsWithFlags(state, flexbuffers::BUILDER_FLAG_SHARE_ALL);
+}
+BENCHMARK(BM_Flexbuffers_BuildRecords_ShareKeyVectors)->Arg(100000);
+
+// About 16MB of JSON Lines log records.
+static const std::string &JsonLinesCorpus() {
+  static const std::string corpus = [] {
+    std::string text;
+    for (int64_t i = 0; text.size() < (16 << 20); i++) {
+      text += "{\"timestamp\": " + std::to_string(1600000000000LL + i) +
+              ", \"host\": \"web-0" + std::to_string(i % 8) +
+              "\", \"level\": \"" + (i % 10 ? "info" : "warn") +
+              "\", \"latency_ms\": " + std::to_string((i * 7) % 1000) +
+              ".25, \"path\": \"/api/v1/items/" + std::to_string(i) +
+              "\", \"tags\": [\"a\", \"b\"], \"ok\": true}\n";
+    }
+    return text;
+  }();
+  return corpus;
+}
+
+static void BM_Flexbuffers_JsonLinesParser(benchmark::State &state) {
+  const std::string &corpus = JsonLinesCorpus();
+  const size_t chunk = 64 * 1024;
+  // Records this small have few strings to share.
+  flexbuffers::Builder fbb(512, flexbuffers::BUILDER_FLAG_NONE);
+  size_t bytes = 0;
+  for (auto _ : state) {
+    flexbuffers::JsonLinesParser parser(
+        &fbb, [&](flexbuffers::Builder &b) { bytes += b.GetSize(); });
+    for (size_t i = 0; i < corpus.size(); i += chunk) {
+      parser.Feed(corpus.data() + i, std::min(chunk, corpus.size() - i));
+    }
+    if (!parser.Finish()) state.SkipWithError(parser.error().c_str());
+  }
+  benchmark::DoNotOptimize(bytes);
+  state.SetBytesProcessed(state.iterations() * corpus.size());
+}
+BENCHMARK(BM_Flexbuffers_JsonLinesParser)->Unit(benchmark::kMillisecond);
+
+// The same corpus with flatbuffers::Parser, one line at a time.
+static void BM_Flexbuffers_ParseFlexBuffer(benchmark::State &state) {
+  const std::string &corpus = JsonLinesCorpus();
+  flexbuffers::Builder fbb(512, flexbuffers::BUILDER_FLAG_NONE);
+  size_t bytes = 0;
+  for (auto _ : state) {
+    flatbuffers::Parser parser;
+    std::string line;
+    for (size_t i = 0, eol; i < corpus.size(); i = eol + 1) {
+      eol = corpus.find('\n', i);
+      line.assign(corpus, i, eol - i);
+      fbb.Clear();
+      if (!parser.ParseFlexBuffer(line.c_str(), nullptr, &fbb)) {
+        state.SkipWithError(parser.error_.c_str());
+      }
+      bytes += fbb.GetSize();
+    }
+  }
+  benchmark::DoNotOptimize(bytes);
+  state.SetBytesProcessed(state.iterations() * corpus.size());
+}
+BENCHMARK(BM_Flexbuffers_ParseFlexBuffer)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,228 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "benchmarks/cpp/flatbuffers/bench_generated.h"
+#include "flatbuffers/flatbuffers.h"
+#include "flatbuffers/idl.h"
+
+using namespace flatbuffers;
+using namespace benchmarks_flatbuffers;
+
+// The schema of bench.fbs.
+static const char kBenchSchema[] =
+    "namespace benchmarks_flatbuffers;"
+    "enum Enum : short { Apples, Pears, Bananas }"
+    "struct Foo { id:ulong; count:short; prefix:byte; length:uint; }"
+    "struct Bar { parent:Foo; time:int; ratio:float; size:ushort; }"
+    "table FooBar { sibling:Bar; name:string; rating:double; postfix:ubyte; }"
+    "table FooBarContainer { list:[FooBar]; initialized:bool; fruit:Enum;"
+    "  location:string; }"
+    "root_type FooBarContainer;";
+
+// A container of 1000 FooBars, with assorted numbers and a name that needs
+// escaping every few tables.
+static const DetachedBuffer &JsonContainer() {
+  static const DetachedBuffer buffer = [] {
+    FlatBufferBuilder fbb;
+    std::vector<Offset<FooBar>> list;
+    for (int i = 0; i < 1000; i++) {
+      const Bar bar(Foo(0xABADCAFEABADCAFE + i, static_cast<int16_t>(i), '@',
+                        1000000 + i),
+                    123456 * i, 3.14159f * i, static_cast<uint16_t>(i));
+      const auto name = fbb.CreateString(
+          "Hello, World! " + std::to_string(i) + (i % 8 ? "" : "\t\"quoted\""));
+      list.push_back(CreateFooBar(fbb, &bar, name, 1.0 / (i + 1), '!'));
+    }
+    fbb.Finish(CreateFooBarContainer(fbb, fbb.CreateVector(list), true,
+                                     Enum_Bananas,
+                                     fbb.CreateString("location")));
+    return fbb.Release();
+  }();
+  return buffer;
+}
+
+static void GenerateJson(benchmark::State &state, bool strict_json,
+                         int indent_step) {
+  const DetachedBuffer &buffer = JsonContainer();
+  IDLOptions opts;
+  opts.strict_json = strict_json;
+  opts.indent_step = indent_step;
+  Parser parser(opts);
+  if (!parser.Parse(kBenchSchema)) state.SkipWithError(parser.error_.c_str());
+  // Reused, so only the first iteration allocates.
+  std::string json;
+  for (auto _ : state) {
+    json.clear();
+    if (!GenerateText(parser, buffer.data(), &json)) {
+      state.SkipWithError("GenerateText failed");
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+
+static void BM_Flatbuffers_GenerateText(benchmark::State &state) {
+  GenerateJson(state, false, 2);
+}
+BENCHMARK(BM_Flatbuffers_GenerateText);
+
+static void BM_Flatbuffers_GenerateText_StrictCompact(benchmark::State &state) {
+  GenerateJson(state, true, -1);
+}
+BENCHMARK(BM_Flatbuffers_GenerateText_StrictCompact);
+
+// About 40MB of indented JSON, as written by flatc, from a container of
+// 100000 FooBars.
+static const std::string &LargeJson() {
+  static const std::string json = [] {
+    FlatBufferBuilder fbb;
+    std::vector<Offset<FooBar>> list;
+    for (int i = 0; i < 100000; i++) {
+      const Bar bar(Foo(0xABADCAFEABADCAFE + i, static_cast<int16_t>(i), '@',
+                        1000000 + i),
+                    123456 * (i % 10000), 3.14159f * i, static_cast<uint16_t>(i));
+      const auto name = fbb.CreateString(
+          "Hello, World! " + std::to_string(i) + (i % 8 ? "" : "\t\"quoted\""));
+      list.push_back(CreateFooBar(fbb, &bar, name, 1.0 / (i + 1), '!'));
+    }
+    fbb.Finish(CreateFooBarContainer(fbb, fbb.CreateVector(list), true,
+                                     Enum_Bananas,
+                                     fbb.CreateString("location")));
+    Parser parser;
+    parser.opts.strict_json = true;
+    std::string text;
+    if (!parser.Parse(kBenchSchema) ||
+        !GenerateText(parser, fbb.GetBufferPointer(), &text)) {
+      text.clear();
+    }
+    return text;
+  }();
+  return json;
+}
+
+static void BM_Flatbuffers_ParseJson_Large(benchmark::State &state) {
+  const std::string &json = LargeJson();
+  Parser parser;
+  if (!parser.Parse(kBenchSchema)) {
+    state.SkipWithError(parser.error_.c_str());
+  }
+  for (auto _ : state) {
+    if (!parser.Parse(json.c_str())) {
+      state.SkipWithError(parser.error_.c_str());
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_Flatbuffers_ParseJson_Large)->Unit(benchmark::kMillisecond);
+
+// About 9MB of JSON from a container of 20000 FooBars with 200 character
+// names, indented with tabs, so most of the parse is skipping blanks and
+// copying strings.
+static const std::string &LongStringJson() {
+  static const std::string json = [] {
+    FlatBufferBuilder fbb;
+    std::vector<Offset<FooBar>> list;
+    for (int i = 0; i < 20000; i++) {
+      const Bar bar(Foo(0xABADCAFEABADCAFE + i, static_cast<int16_t>(i), '@',
+                        1000000 + i),
+                    123456 * (i % 10000), 3.14159f * i, static_cast<uint16_t>(i));
+      std::string name = "Hello, World! " + std::to_string(i) + " ";
+      while (name.size() < 200) name += name;
+      name.resize(200);
+      list.push_back(
+          CreateFooBar(fbb, &bar, fbb.CreateString(name), 1.0 / (i + 1), '!'));
+    }
+    fbb.Finish(CreateFooBarContainer(fbb, fbb.CreateVector(list), true,
+                                     Enum_Bananas,
+                                     fbb.CreateString("location")));
+    Parser parser;
+    parser.opts.strict_json = true;
+    parser.opts.indent_step = 1;
+    std::string text;
+    if (!parser.Parse(kBenchSchema) ||
+        !GenerateText(parser, fbb.GetBufferPointer(), &text)) {
+      return std::string();
+    }
+    // One tab per level instead of a space.
+    bool indenting = true;
+    for (auto &c : text) {
+      if (c == '\n') {
+        indenting = true;
+      } else if (indenting && c == ' ') {
+        c = '\t';
+      } else {
+        indenting = false;
+      }
+    }
+    return text;
+  }();
+  return json;
+}
+
+static void BM_Flatbuffers_ParseJson_LongStrings(benchmark::State &state) {
+  const std::string &json = LongStringJson();
+  Parser parser;
+  if (!parser.Parse(kBenchSchema)) {
+    state.SkipWithError(parser.error_.c_str());
+  }
+  for (auto _ : state) {
+    if (!parser.Parse(json.c_str())) {
+      state.SkipWithError(parser.error_.c_str());
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_Flatbuffers_ParseJson_LongStrings)
+    ->Unit(benchmark::kMillisecond);
+
+// A table of 100000 doubles and 100000 longs, as from a sensor.
+static const char kSamplesSchema[] =
+    "table Samples { values:[double]; counts:[long]; }"
+    "root_type Samples;";
+
+static const std::string &NumericJson() {
+  static const std::string json = [] {
+    std::string text = "{ values: [";
+    for (int i = 0; i < 100000; i++) {
+      text += (i ? ", " : "") + std::to_string(i % 1000) + "." +
+              std::to_string(100000 + i * 37 % 100000).substr(1);
+      if (i % 10 == 0) text += "e-3";
+    }
+    text += "], counts: [";
+    for (int64_t i = 0; i < 100000; i++) {
+      text += (i ? ", " : "") + std::to_string(i * i * 7919 - 1000000);
+    }
+    return text + "] }";
+  }();
+  return json;
+}
+
+static void BM_Flatbuffers_ParseJson_Numbers(benchmark::State &state) {
+  const std::string &json = NumericJson();
+  Parser parser;
+  if (!parser.Parse(kSamplesSchema)) {
+    state.SkipWithError(parser.error_.c_str());
+  }
+  for (auto _ : state) {
+    if (!parser.Parse(json.c_str())) {
+      state.SkipWithError(parser.error_.c_str());
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_Flatbuffers_ParseJson_Numbers)->Unit(benchmark::kMillisecond);
+
+static void BM_Flexbuffers_ParseJson_Numbers(benchmark::State &state) {
+  const std::string &json = NumericJson();
+  Parser parser;
+  flexbuffers::Builder fbb;
+  for (auto _ : state) {
+    fbb.Clear();
+    if (!parser.ParseFlexBuffer(json.c_str(), nullptr, &fbb)) {
+      state.SkipWithError(parser.error_.c_str());
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_Flexbuffers_ParseJson_Numbers)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,272 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "flatbuffers/flatbuffers.h"
+#include "flatbuffers/hash_index.h"
+#include "flatbuffers/key_index.h"
+
+using namespace flatbuffers;
+
+// A table with a single uint64 key field, like a generated table with
+// `id:ulong (key)`.
+struct Entry : private Table {
+  uint64_t id() const { return GetField<uint64_t>(FieldIndexToOffset(0), 0); }
+  uint64_t KeyIndexKey() const { return id(); }
+  bool KeyCompareLessThan(const Entry *o) const { return id() < o->id(); }
+  int KeyCompareWithValue(uint64_t val) const {
+    return static_cast<int>(id() > val) - static_cast<int>(id() < val);
+  }
+};
+
+// Builds a sorted vector of `num_entries` tables with the keys 0, 2, 4...
+static const DetachedBuffer &SortedEntries(int64_t num_entries) {
+  static std::map<int64_t, DetachedBuffer> buffers;
+  auto &buffer = buffers[num_entries];
+  if (buffer.size()) return buffer;
+  FlatBufferBuilder fbb;
+  std::vector<Offset<Entry>> entries(static_cast<size_t>(num_entries));
+  for (int64_t i = 0; i < num_entries; i++) {
+    const uoffset_t start = fbb.StartTable();
+    fbb.AddElement<uint64_t>(FieldIndexToOffset(0), 2 * i, 1);
+    entries[i] = Offset<Entry>(fbb.EndTable(start));
+  }
+  fbb.Finish(fbb.CreateVector(entries));
+  buffer = fbb.Release();
+  return buffer;
+}
+
+// Random keys below 2 * `num_entries`, half of which are present.
+static std::vector<uint64_t> RandomKeys(int64_t num_entries) {
+  std::vector<uint64_t> keys(4096);
+  uint64_t x = 88172645463325252ULL;
+  for (auto &key : keys) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    key = x % static_cast<uint64_t>(2 * num_entries);
+  }
+  return keys;
+}
+
+template<typename Lookup>
+static void LookupRandomKeys(benchmark::State &state, const Lookup &lookup) {
+  const auto keys = RandomKeys(state.range(0));
+  size_t i = 0, found = 0;
+  for (auto _ : state) {
+    found += lookup(keys[i++ % keys.size()]) != nullptr;
+  }
+  benchmark::DoNotOptimize(found);
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_Flatbuffers_LookupByKey(benchmark::State &state) {
+  const auto vec =
+      GetRoot<Vector<Offset<Entry>>>(SortedEntries(state.range(0)).data());
+  LookupRandomKeys(state,
+                   [vec](uint64_t key) { return vec->LookupByKey(key); });
+}
+BENCHMARK(BM_Flatbuffers_LookupByKey)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Arg(10000000);
+
+static void BM_Flatbuffers_KeyIndex_LookupByKey(benchmark::State &state) {
+  const auto vec =
+      GetRoot<Vector<Offset<Entry>>>(SortedEntries(state.range(0)).data());
+  const auto index = MakeKeyIndex(vec, &Entry::id);
+  LookupRandomKeys(state,
+                   [&index](uint64_t key) { return index.LookupByKey(key); });
+}
+BENCHMARK(BM_Flatbuffers_KeyIndex_LookupByKey)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(10000000);
+
+// The vector of SortedEntries() as field 0 of a table, and its key index, as
+// built with the `key_index` attribute, as field 1.
+static const DetachedBuffer &IndexedEntries(int64_t num_entries) {
+  static std::map<int64_t, DetachedBuffer> buffers;
+  auto &buffer = buffers[num_entries];
+  if (buffer.size()) return buffer;
+  const auto entries =
+      GetRoot<Vector<Offset<Entry>>>(SortedEntries(num_entries).data());
+  std::vector<uint64_t> index;
+  BuildKeyIndex(entries, &index);
+  FlatBufferBuilder fbb;
+  std::vector<Offset<Entry>> offsets;
+  for (uoffset_t i = 0; i < entries->size(); i++) {
+    const uoffset_t start = fbb.StartTable();
+    fbb.AddElement<uint64_t>(FieldIndexToOffset(0), entries->Get(i)->id(), 1);
+    offsets.push_back(Offset<Entry>(fbb.EndTable(start)));
+  }
+  const auto vec = fbb.CreateVector(offsets);
+  const auto index_vec = fbb.CreateVector(index);
+  const uoffset_t start = fbb.StartTable();
+  fbb.AddOffset(FieldIndexToOffset(0), vec);
+  fbb.AddOffset(FieldIndexToOffset(1), index_vec);
+  fbb.Finish(Offset<Table>(fbb.EndTable(start)));
+  buffer = fbb.Release();
+  return buffer;
+}
+
+static void BM_Flatbuffers_KeyIndex_InBuffer(benchmark::State &state) {
+  const auto root = GetRoot<Table>(IndexedEntries(state.range(0)).data());
+  const auto vec =
+      root->GetPointer<const Vector<Offset<Entry>> *>(FieldIndexToOffset(0));
+  const auto index =
+      root->GetPointer<const Vector<uint64_t> *>(FieldIndexToOffset(1));
+  LookupRandomKeys(state, [vec, index](uint64_t key) {
+    return LookupByKeyIndex(vec, index, key);
+  });
+}
+BENCHMARK(BM_Flatbuffers_KeyIndex_InBuffer)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(10000000);
+
+// The same keys as BM_Flatbuffers_LookupByKey, in batches of 4096.
+static void BM_Flatbuffers_LookupByKeys(benchmark::State &state) {
+  const auto vec =
+      GetRoot<Vector<Offset<Entry>>>(SortedEntries(state.range(0)).data());
+  const auto keys = RandomKeys(state.range(0));
+  std::vector<const Entry *> found(keys.size());
+  for (auto _ : state) {
+    vec->LookupByKeys(span<const uint64_t>(keys.data(), keys.size()),
+                      span<const Entry *>(found.data(), found.size()));
+    benchmark::DoNotOptimize(found.data());
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_Flatbuffers_LookupByKeys)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Arg(10000000);
+
+// The same batches, sorted.
+static void BM_Flatbuffers_LookupBySortedKeys(benchmark::State &state) {
+  const auto vec =
+      GetRoot<Vector<Offset<Entry>>>(SortedEntries(state.range(0)).data());
+  auto keys = RandomKeys(state.range(0));
+  std::sort(keys.begin(), keys.end());
+  std::vector<const Entry *> found(keys.size());
+  for (auto _ : state) {
+    vec->LookupBySortedKeys(span<const uint64_t>(keys.data(), keys.size()),
+                            span<const Entry *>(found.data(), found.size()));
+    benchmark::DoNotOptimize(found.data());
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_Flatbuffers_LookupBySortedKeys)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(10000000);
+
+// A table with a single string key field, like a generated table with
+// `word:string (key)` indexed with `hash_index`.
+struct WordEntry : private Table {
+  const String *word() const {
+    return GetPointer<const String *>(FieldIndexToOffset(0));
+  }
+  const String *HashIndexKey() const { return word(); }
+  bool KeyCompareLessThan(const WordEntry *o) const {
+    return *word() < *o->word();
+  }
+  int KeyCompareWithValue(const char *val) const {
+    return strcmp(word()->c_str(), val);
+  }
+};
+
+static std::string Word(uint64_t i) {
+  return "dictionary.word." + std::to_string(i);
+}
+
+// Builds a dictionary of `num_words` words: a sorted vector of WordEntry
+// (field 0), and its hash index (field 1).
+static const DetachedBuffer &Dictionary(int64_t num_words) {
+  static std::map<int64_t, DetachedBuffer> buffers;
+  auto &buffer = buffers[num_words];
+  if (buffer.size()) return buffer;
+  FlatBufferBuilder fbb;
+  std::vector<Offset<WordEntry>> entries;
+  for (int64_t i = 0; i < num_words; i++) {
+    const auto word = fbb.CreateString(Word(2 * i));
+    const uoffset_t start = fbb.StartTable();
+    fbb.AddOffset(FieldIndexToOffset(0), word);
+    entries.push_back(Offset<WordEntry>(fbb.EndTable(start)));
+  }
+  const auto vec = fbb.CreateVectorOfSortedTables(&entries);
+  const auto index = CreateHashIndex(fbb, vec);
+  const uoffset_t start = fbb.StartTable();
+  fbb.AddOffset(FieldIndexToOffset(0), vec);
+  fbb.AddOffset(FieldIndexToOffset(1), index);
+  fbb.Finish(Offset<Table>(fbb.EndTable(start)));
+  buffer = fbb.Release();
+  return buffer;
+}
+
+// Looks up random words, half of which are present.
+template<typename Lookup>
+static void LookupRandomWords(benchmark::State &state, const Lookup &lookup) {
+  std::vector<std::string> words;
+  for (auto key : RandomKeys(state.range(0))) words.push_back(Word(key));
+  size_t i = 0, found = 0;
+  for (auto _ : state) {
+    found += lookup(words[i++ % words.size()].c_str()) != nullptr;
+  }
+  benchmark::DoNotOptimize(found);
+  state.SetItemsProcessed(state.iterations());
+}
+
+static const Vector<Offset<WordEntry>> *Words(const DetachedBuffer &buffer) {
+  return GetRoot<Table>(buffer.data())
+      ->GetPointer<const Vector<Offset<WordEntry>> *>(FieldIndexToOffset(0));
+}
+
+static const Vector<uint32_t> *WordIndex(const DetachedBuffer &buffer) {
+  return GetRoot<Table>(buffer.data())
+      ->GetPointer<const Vector<uint32_t> *>(FieldIndexToOffset(1));
+}
+
+static void BM_Flatbuffers_Dictionary_LookupByKey(benchmark::State &state) {
+  const auto words = Words(Dictionary(state.range(0)));
+  LookupRandomWords(state,
+                    [words](const char *w) { return words->LookupByKey(w); });
+}
+BENCHMARK(BM_Flatbuffers_Dictionary_LookupByKey)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000);
+
+static void BM_Flatbuffers_Dictionary_HashIndex(benchmark::State &state) {
+  const DetachedBuffer &buffer = Dictionary(state.range(0));
+  const auto words = Words(buffer);
+  const auto index = WordIndex(buffer);
+  LookupRandomWords(state, [words, index](const char *w) {
+    return LookupByHashIndex(words, index, w);
+  });
+}
+BENCHMARK(BM_Flatbuffers_Dictionary_HashIndex)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000);
+
+static void BM_Flatbuffers_Dictionary_BuildHashIndex(benchmark::State &state) {
+  const auto words = Words(Dictionary(state.range(0)));
+  std::vector<uint32_t> index;
+  for (auto _ : state) {
+    if (!BuildHashIndex(words, &index)) state.SkipWithError("no index");
+  }
+  state.SetItemsProcessed(state.iterations() * words->size());
+}
+BENCHMARK(BM_Flatbuffers_Dictionary_BuildHashIndex)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "benchmarks/cpp/flatbuffers/bench_generated.h"
+#include "flatbuffers/flatbuffers.h"
+
+using namespace flatbuffers;
+using namespace benchmarks_flatbuffers;
+
+// Counts every heap allocation, so the benchmarks below can report how many
+// allocations an unpack does. This is why they are built into an executable
+// of their own, flatbenchmark_object_api.
+static std::atomic<size_t> num_allocations(0);
+
+void *operator new(size_t size) {
+  num_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = std::malloc(size ? size : 1)) return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+// A container of `num_foobars` FooBars, with names too long to be stored
+// inline in a std::string.
+static std::vector<uint8_t> MakeContainer(int num_foobars) {
+  FlatBufferBuilder fbb;
+  std::vector<Offset<FooBar>> list;
+  for (int i = 0; i < num_foobars; i++) {
+    const Bar bar(Foo(0xABADCAFEABADCAFE + i, static_cast<int16_t>(i), '@',
+                      1000000 + i),
+                  i, 3.14159f * i, static_cast<uint16_t>(i));
+    const auto name =
+        fbb.CreateString("Hello, World! Hello, World! " + std::to_string(i));
+    list.push_back(CreateFooBar(fbb, &bar, name, 1.0 / (i + 1), '!'));
+  }
+  fbb.Finish(CreateFooBarContainer(fbb, fbb.CreateVector(list), true,
+                                   Enum_Bananas,
+                                   fbb.CreateString("A location far away")));
+  return std::vector<uint8_t>(fbb.GetBufferPointer(),
+                              fbb.GetBufferPointer() + fbb.GetSize());
+}
+
+static const std::vector<uint8_t> &Container() {
+  static const std::vector<uint8_t> buffer = MakeContainer(100);
+  return buffer;
+}
+
+static const std::vector<uint8_t> &SmallContainer() {
+  static const std::vector<uint8_t> buffer = MakeContainer(10);
+  return buffer;
+}
+
+// Reports the allocations done since `start`, per iteration.
+static void SetAllocations(benchmark::State &state, size_t start) {
+  state.counters["allocs"] =
+      benchmark::Counter(static_cast<double>(num_allocations - start),
+                         benchmark::Counter::kAvgIterations);
+}
+
+// Unpacks into a new object every time.
+static void BM_ObjectApi_UnPack(benchmark::State &state) {
+  const auto &buf = Container();
+  const size_t start = num_allocations;
+  for (auto _ : state) {
+    auto container = UnPackFooBarContainer(buf.data());
+    benchmark::DoNotOptimize(container.get());
+  }
+  SetAllocations(state, start);
+  state.SetBytesProcessed(state.iterations() * buf.size());
+}
+BENCHMARK(BM_ObjectApi_UnPack);
+
+// Unpacks into the same object every time, as a decode loop would.
+static void BM_ObjectApi_UnPackTo(benchmark::State &state) {
+  const auto &buf = Container();
+  FooBarContainerT container;
+  UnPackToFooBarContainer(buf.data(), &container);
+  const size_t start = num_allocations;
+  for (auto _ : state) {
+    UnPackToFooBarContainer(buf.data(), &container);
+    benchmark::DoNotOptimize(&container);
+  }
+  SetAllocations(state, start);
+  state.SetBytesProcessed(state.iterations() * buf.size());
+}
+BENCHMARK(BM_ObjectApi_UnPackTo);
+
+// The same, alternating between a large and a small container, so the object
+// has to shrink and grow again.
+static void BM_ObjectApi_UnPackTo_Alternating(benchmark::State &state) {
+  const std::vector<uint8_t> *bufs[] = { &Container(), &SmallContainer() };
+  FooBarContainerT container;
+  UnPackToFooBarContainer(bufs[0]->data(), &container);
+  const size_t start = num_allocations;
+  size_t i = 0;
+  for (auto _ : state) {
+    UnPackToFooBarContainer(bufs[i++ % 2]->data(), &container);
+    benchmark::DoNotOptimize(&container);
+  }
+  SetAllocations(state, start);
+}
+BENCHMARK(BM_ObjectApi_UnPackTo_Alternating);
@@ -0,0 +1,273 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "benchmarks/cpp/flatbuffers/bench_generated.h"
+#include "flatbuffers/compiled_schema.h"
+#include "flatbuffers/flatbuffers.h"
+#include "flatbuffers/idl.h"
+#include "flatbuffers/reflection.h"
+
+using namespace flatbuffers;
+using namespace benchmarks_flatbuffers;
+
+// The schema of bench.fbs.
+static const char kBenchSchema[] =
+    "namespace benchmarks_flatbuffers;"
+    "enum Enum : short { Apples, Pears, Bananas }"
+    "struct Foo { id:ulong; count:short; prefix:byte; length:uint; }"
+    "struct Bar { parent:Foo; time:int; ratio:float; size:ushort; }"
+    "table FooBar { sibling:Bar; name:string; rating:double; postfix:ubyte; }"
+    "table FooBarContainer { list:[FooBar]; initialized:bool; fruit:Enum;"
+    "  location:string; }"
+    "root_type FooBarContainer;";
+
+// The same, with every scalar that could be widened widened.
+static const char kWidenedBenchSchema[] =
+    "namespace benchmarks_flatbuffers;"
+    "enum Enum : int { Apples, Pears, Bananas }"
+    "struct Foo { id:ulong; count:int; prefix:short; length:ulong; }"
+    "struct Bar { parent:Foo; time:long; ratio:double; size:uint; }"
+    "table FooBar { sibling:Bar; name:string; rating:double; postfix:ushort; }"
+    "table FooBarContainer { list:[FooBar]; initialized:bool; fruit:Enum;"
+    "  location:string; }"
+    "root_type FooBarContainer;";
+
+static std::vector<uint8_t> SerializeSchema(const char *source) {
+  Parser parser;
+  parser.Parse(source);
+  parser.Serialize();
+  return std::vector<uint8_t>(
+      parser.builder_.GetBufferPointer(),
+      parser.builder_.GetBufferPointer() + parser.builder_.GetSize());
+}
+
+// The schema of bench.fbs, as a binary schema.
+static const reflection::Schema &BenchSchema() {
+  static const std::vector<uint8_t> bfbs = SerializeSchema(kBenchSchema);
+  return *reflection::GetSchema(bfbs.data());
+}
+
+static const reflection::Schema &WidenedBenchSchema() {
+  static const std::vector<uint8_t> bfbs = SerializeSchema(kWidenedBenchSchema);
+  return *reflection::GetSchema(bfbs.data());
+}
+
+static std::vector<uint8_t> MakeContainer(int num_foobars) {
+  FlatBufferBuilder fbb;
+  std::vector<Offset<FooBar>> list;
+  for (int i = 0; i < num_foobars; i++) {
+    const Bar bar(Foo(0xABADCAFEABADCAFE + i, static_cast<int16_t>(i), '@',
+                      1000000 + i),
+                  i, 3.14159f * i, static_cast<uint16_t>(i));
+    const auto name = fbb.CreateString("Hello, World! " + std::to_string(i));
+    list.push_back(CreateFooBar(fbb, &bar, name, 1.0 / (i + 1), '!'));
+  }
+  fbb.Finish(CreateFooBarContainer(fbb, fbb.CreateVector(list), true,
+                                   Enum_Bananas, fbb.CreateString("location")));
+  return std::vector<uint8_t>(fbb.GetBufferPointer(),
+                              fbb.GetBufferPointer() + fbb.GetSize());
+}
+
+// A container of 10000 FooBars, about 600KB.
+static const std::vector<uint8_t> &Container() {
+  static const std::vector<uint8_t> buffer = MakeContainer(10000);
+  return buffer;
+}
+
+// Renames state.range(0) FooBars, spread over the whole container, one at a
+// time.
+static void BM_Reflection_SetString(benchmark::State &state) {
+  const auto &schema = BenchSchema();
+  const auto num_edits = static_cast<int>(state.range(0));
+  const int stride = 10000 / num_edits;
+  std::vector<uint8_t> buf;
+  for (auto _ : state) {
+    buf = Container();
+    for (int i = 0; i < num_edits; i++) {
+      auto list = GetFooBarContainer(buf.data())->list();
+      SetString(schema, "Goodbye, cruel World! " + std::to_string(i),
+                list->Get(i * stride)->name(), &buf);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * num_edits);
+}
+BENCHMARK(BM_Reflection_SetString)
+    ->Arg(1)
+    ->Arg(100)
+    ->Arg(10000)
+    ->Unit(benchmark::kMicrosecond);
+
+// Same as above, but all at once.
+static void BM_Reflection_ResizeSession(benchmark::State &state) {
+  const auto &schema = BenchSchema();
+  const auto num_edits = static_cast<int>(state.range(0));
+  const int stride = 10000 / num_edits;
+  std::vector<uint8_t> buf;
+  ResizeSession session(schema, &buf);
+  for (auto _ : state) {
+    buf = Container();
+    auto list = GetFooBarContainer(buf.data())->list();
+    for (int i = 0; i < num_edits; i++) {
+      session.SetString("Goodbye, cruel World! " + std::to_string(i),
+                        list->Get(i * stride)->name());
+    }
+    session.Apply();
+  }
+  state.SetItemsProcessed(state.iterations() * num_edits);
+}
+BENCHMARK(BM_Reflection_ResizeSession)
+    ->Arg(1)
+    ->Arg(100)
+    ->Arg(10000)
+    ->Unit(benchmark::kMicrosecond);
+
+// Sums a field of every FooBar, as a tool working from a schema would.
+static void BM_Reflection_GetAnyField(benchmark::State &state) {
+  const auto &schema = BenchSchema();
+  auto &foobar =
+      *schema.objects()->LookupByKey("benchmarks_flatbuffers.FooBar");
+  auto &rating = *foobar.fields()->LookupByKey("rating");
+  auto &list = *schema.root_table()->fields()->LookupByKey("list");
+  const auto &buf = Container();
+  for (auto _ : state) {
+    auto vec = GetFieldV<Offset<Table>>(*GetAnyRoot(buf.data()), list);
+    double sum = 0;
+    for (uoffset_t i = 0; i < vec->size(); i++) {
+      sum += GetAnyFieldF(*vec->Get(i), rating);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * 10000);
+}
+BENCHMARK(BM_Reflection_GetAnyField)->Unit(benchmark::kMicrosecond);
+
+static void BM_CompiledSchema_GetField(benchmark::State &state) {
+  const CompiledSchema schema(BenchSchema());
+  auto &list = *schema.root()->LookupField("list");
+  auto &rating = *list.object->LookupField("rating");
+  const auto &buf = Container();
+  for (auto _ : state) {
+    auto vec = GetFieldV<Offset<Table>>(*GetAnyRoot(buf.data()), *list.def);
+    double sum = 0;
+    for (uoffset_t i = 0; i < vec->size(); i++) {
+      sum += CompiledSchema::GetFieldF(*vec->Get(i), rating);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * 10000);
+}
+BENCHMARK(BM_CompiledSchema_GetField)->Unit(benchmark::kMicrosecond);
+
+static void BM_Reflection_Verify(benchmark::State &state) {
+  const auto &schema = BenchSchema();
+  const auto &buf = Container();
+  for (auto _ : state) {
+    if (!Verify(schema, *schema.root_table(), buf.data(), buf.size())) {
+      state.SkipWithError("Verify failed");
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * buf.size());
+}
+BENCHMARK(BM_Reflection_Verify)->Unit(benchmark::kMicrosecond);
+
+static void BM_CompiledSchema_Verify(benchmark::State &state) {
+  const CompiledSchema schema(BenchSchema());
+  const auto &buf = Container();
+  for (auto _ : state) {
+    if (!schema.Verify(*schema.root(), buf.data(), buf.size())) {
+      state.SkipWithError("Verify failed");
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * buf.size());
+}
+BENCHMARK(BM_CompiledSchema_Verify)->Unit(benchmark::kMicrosecond);
+
+static void BM_Reflection_CopyTable(benchmark::State &state) {
+  const auto &schema = BenchSchema();
+  const auto &buf = Container();
+  FlatBufferBuilder fbb;
+  for (auto _ : state) {
+    fbb.Clear();
+    fbb.Finish(CopyTable(fbb, schema, *schema.root_table(),
+                         *GetAnyRoot(buf.data())));
+  }
+  state.SetBytesProcessed(state.iterations() * buf.size());
+}
+BENCHMARK(BM_Reflection_CopyTable)->Unit(benchmark::kMicrosecond);
+
+static void BM_CompiledSchema_CopyTable(benchmark::State &state) {
+  const CompiledSchema schema(BenchSchema());
+  const auto &buf = Container();
+  FlatBufferBuilder fbb;
+  for (auto _ : state) {
+    fbb.Clear();
+    fbb.Finish(
+        schema.CopyTable(fbb, *schema.root(), *GetAnyRoot(buf.data())));
+  }
+  state.SetBytesProcessed(state.iterations() * buf.size());
+}
+BENCHMARK(BM_CompiledSchema_CopyTable)->Unit(benchmark::kMicrosecond);
+
+// About 10MB, copied out of a buffer that holds it and nothing else.
+static void BM_Reflection_CopyTable_Large(benchmark::State &state) {
+  const auto &schema = BenchSchema();
+  static const std::vector<uint8_t> buf = MakeContainer(170000);
+  FlatBufferBuilder fbb;
+  for (auto _ : state) {
+    fbb.Clear();
+    fbb.Finish(CopyTable(fbb, schema, *schema.root_table(),
+                         *GetAnyRoot(buf.data())));
+  }
+  state.SetBytesProcessed(state.iterations() * buf.size());
+}
+BENCHMARK(BM_Reflection_CopyTable_Large)->Unit(benchmark::kMillisecond);
+
+// Upgrades the container to the widened schema.
+static void BM_SchemaConverter_Convert(benchmark::State &state) {
+  const SchemaConverter converter(BenchSchema(), WidenedBenchSchema());
+  if (!converter.error().empty()) {
+    state.SkipWithError(converter.error().c_str());
+  }
+  const auto &buf = Container();
+  FlatBufferBuilder fbb;
+  for (auto _ : state) {
+    fbb.Clear();
+    converter.Convert(fbb, buf.data());
+  }
+  state.SetBytesProcessed(state.iterations() * buf.size());
+}
+BENCHMARK(BM_SchemaConverter_Convert)->Unit(benchmark::kMicrosecond);
+
+// The same, the way it is done without a converter: through JSON.
+static void BM_SchemaConverter_ConvertViaJson(benchmark::State &state) {
+  Parser from;
+  Parser to;
+  if (!from.Parse(kBenchSchema) || !to.Parse(kWidenedBenchSchema)) {
+    state.SkipWithError("Parse failed");
+  }
+  const auto &buf = Container();
+  std::string json;
+  for (auto _ : state) {
+    json.clear();
+    if (!GenerateText(from, buf.data(), &json) || !to.Parse(json.c_str())) {
+      state.SkipWithError("Conversion failed");
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * buf.size());
+}
+BENCHMARK(BM_SchemaConverter_ConvertViaJson)->Unit(benchmark::kMicrosecond);
+
+// A schema that didn't change, so the container is copied as is.
+static void BM_SchemaConverter_Convert_Unchanged(benchmark::State &state) {
+  const SchemaConverter converter(BenchSchema(), BenchSchema());
+  const auto &buf = Container();
+  FlatBufferBuilder fbb;
+  for (auto _ : state) {
+    fbb.Clear();
+    converter.Convert(fbb, buf.data());
+  }
+  state.SetBytesProcessed(state.iterations() * buf.size());
+}
+BENCHMARK(BM_SchemaConverter_Convert_Unchanged)->Unit(benchmark::kMicrosecond);
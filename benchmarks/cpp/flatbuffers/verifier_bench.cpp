@@ -0,0 +1,152 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmarks/cpp/flatbuffers/bench_generated.h"
+#include "flatbuffers/flatbuffers.h"
+#include "flatbuffers/verification_cache.h"
+
+using namespace flatbuffers;
+using namespace benchmarks_flatbuffers;
+
+// Builds a container with `num_tables` FooBars, each with its own name.
+static DetachedBuffer BuildLargeContainer(uoffset_t num_tables) {
+  FlatBufferBuilder fbb;
+  std::vector<Offset<FooBar>> list(num_tables);
+  for (uoffset_t i = 0; i < num_tables; i++) {
+    const Bar bar(Foo(0xABADCAFEABADCAFE + i, 10000 + i, '@', 1000000 + i),
+                  123456 + i, 3.14159f + i, 10000 + i);
+    const auto name = fbb.CreateString("Hello, World! " + std::to_string(i));
+    list[i] = CreateFooBar(fbb, &bar, name, 3.1415432432445543543 + i, '!' + i);
+  }
+  fbb.Finish(CreateFooBarContainer(fbb, fbb.CreateVector(list), true,
+                                   Enum_Bananas, fbb.CreateString("location")));
+  return fbb.Release();
+}
+
+// Runs the tasks on `num_threads` threads, which are started for every batch
+// of tasks. A real thread pool would keep them around.
+static Verifier::Executor ThreadExecutor(int num_threads) {
+  return [num_threads](size_t num_tasks,
+                       const std::function<void(size_t)> &task) {
+    std::atomic<size_t> next(0);
+    auto work = [&]() {
+      for (size_t i; (i = next.fetch_add(1)) < num_tasks;) task(i);
+    };
+    std::vector<std::thread> threads;
+    for (int t = 1; t < num_threads; t++) threads.emplace_back(work);
+    work();
+    for (auto &thread : threads) thread.join();
+  };
+}
+
+static const DetachedBuffer &LargeContainer() {
+  static const DetachedBuffer buffer = BuildLargeContainer(1000000);
+  return buffer;
+}
+
+static void BM_Flatbuffers_Verify_LargeVector(benchmark::State &state) {
+  const auto num_threads = static_cast<int>(state.range(0));
+  const DetachedBuffer &buffer = LargeContainer();
+  const Verifier::Executor executor = ThreadExecutor(num_threads);
+  Verifier::Options opts;
+  opts.max_tables = 10000000;
+  for (auto _ : state) {
+    Verifier verifier(buffer.data(), buffer.size(), opts);
+    if (num_threads > 1) verifier.SetExecutor(&executor, 16 * 1024);
+    if (!VerifyFooBarContainerBuffer(verifier)) state.SkipWithError("invalid");
+  }
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(BM_Flatbuffers_Verify_LargeVector)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(16)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+static void BM_Flatbuffers_Verify_Cached(benchmark::State &state) {
+  const DetachedBuffer &buffer = LargeContainer();
+  Verifier::Options opts;
+  opts.max_tables = 10000000;
+  VerificationCache cache("benchmarks_flatbuffers.FooBarContainer");
+  for (auto _ : state) {
+    if (!cache.VerifyBuffer<FooBarContainer>(buffer.data(), buffer.size(),
+                                             nullptr, opts)) {
+      state.SkipWithError("invalid");
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(BM_Flatbuffers_Verify_Cached)->Unit(benchmark::kMillisecond);
+
+// Builds a table holding a vector of 200000 short strings.
+static const DetachedBuffer &StringVectorBuffer() {
+  static const DetachedBuffer buffer = [] {
+    FlatBufferBuilder fbb;
+    std::vector<std::string> strings;
+    for (int i = 0; i < 200000; i++) strings.push_back(std::to_string(i));
+    const auto vec = fbb.CreateVectorOfStrings(strings);
+    const uoffset_t start = fbb.StartTable();
+    fbb.AddOffset(FieldIndexToOffset(0), vec);
+    fbb.Finish(Offset<Table>(fbb.EndTable(start)));
+    return fbb.Release();
+  }();
+  return buffer;
+}
+
+static const Vector<Offset<String>> *GetStrings(const DetachedBuffer &buffer) {
+  return GetRoot<Table>(buffer.data())
+      ->GetPointer<const Vector<Offset<String>> *>(FieldIndexToOffset(0));
+}
+
+static void BM_Flatbuffers_Verify_VectorOfStrings(benchmark::State &state) {
+  const DetachedBuffer &buffer = StringVectorBuffer();
+  const auto strings = GetStrings(buffer);
+  for (auto _ : state) {
+    Verifier verifier(buffer.data(), buffer.size());
+    if (!verifier.VerifyVector(strings) ||
+        !verifier.VerifyVectorOfStrings(strings)) {
+      state.SkipWithError("invalid");
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * strings->size());
+}
+BENCHMARK(BM_Flatbuffers_Verify_VectorOfStrings);
+
+// The same checks, one string at a time.
+static void BM_Flatbuffers_Verify_EachString(benchmark::State &state) {
+  const DetachedBuffer &buffer = StringVectorBuffer();
+  const auto strings = GetStrings(buffer);
+  for (auto _ : state) {
+    Verifier verifier(buffer.data(), buffer.size());
+    bool ok = verifier.VerifyVector(strings);
+    for (uoffset_t i = 0; i < strings->size() && ok; i++) {
+      ok = verifier.VerifyString(strings->Get(i));
+    }
+    if (!ok) state.SkipWithError("invalid");
+  }
+  state.SetItemsProcessed(state.iterations() * strings->size());
+}
+BENCHMARK(BM_Flatbuffers_Verify_EachString);
+
+// Checks the offsets of a vector of 200000 tables, without the tables.
+static void BM_Flatbuffers_Verify_OffsetTargets(benchmark::State &state) {
+  const DetachedBuffer &buffer = LargeContainer();
+  const auto list = GetFooBarContainer(buffer.data())->list();
+  const auto elems = static_cast<size_t>(
+      reinterpret_cast<const uint8_t *>(list->Data()) - buffer.data());
+  const uoffset_t count = 200000;
+  for (auto _ : state) {
+    Verifier verifier(buffer.data(), buffer.size());
+    if (!verifier.VerifyOffsetTargets(elems, count, sizeof(uoffset_t))) {
+      state.SkipWithError("invalid");
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_Flatbuffers_Verify_OffsetTargets);
@@ -0,0 +1,190 @@
+/*
+ * Copyright 2021 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLATBUFFERS_ARENA_ALLOCATOR_H_
+#define FLATBUFFERS_ARENA_ALLOCATOR_H_
+
+#include "flatbuffers/allocator.h"
+#include "flatbuffers/base.h"
+#include "flatbuffers/default_allocator.h"
+
+namespace flatbuffers {
+
+// ArenaAllocator hands out memory by bumping a pointer through large blocks,
+// and frees it all at once in reset(). It is meant for building many small
+// FlatBuffers per batch without a trip to malloc for each of them.
+// Memory comes from an optional caller-supplied region first, then from blocks
+// requested from an upstream allocator (nullptr means `DefaultAllocator`).
+// Deallocating the most recent allocation gives its memory back, anything
+// else is only reclaimed by reset(). Growing the most recent allocation (which
+// is what `vector_downward` keeps doing while a buffer is being built) extends
+// it into the free space of the block instead of copying it to a new region.
+// This class is not thread-safe.
+class ArenaAllocator : public Allocator {
+ public:
+  // Takes blocks of `block_size` bytes (or larger, for large requests) from
+  // `upstream`.
+  explicit ArenaAllocator(size_t block_size = 64 * 1024,
+                          Allocator *upstream = nullptr)
+      : upstream_(upstream),
+        block_size_(block_size),
+        initial_(nullptr),
+        initial_size_(0),
+        blocks_(nullptr),
+        begin_(nullptr),
+        cur_(nullptr),
+        end_(nullptr) {}
+
+  // Serves allocations from `buffer` of `size` bytes (not owned) until it is
+  // exhausted, then falls back to blocks taken from `upstream`.
+  ArenaAllocator(uint8_t *buffer, size_t size, size_t block_size = 64 * 1024,
+                 Allocator *upstream = nullptr)
+      : upstream_(upstream),
+        block_size_(block_size),
+        initial_(buffer),
+        initial_size_(size),
+        blocks_(nullptr),
+        begin_(nullptr),
+        cur_(nullptr),
+        end_(nullptr) {
+    UseRegion(buffer, size);
+  }
+
+  ~ArenaAllocator() { FreeBlocks(nullptr); }
+
+  uint8_t *allocate(size_t size) FLATBUFFERS_OVERRIDE {
+    const size_t aligned = AlignUp(size);
+    if (aligned > static_cast<size_t>(end_ - cur_)) AddBlock(aligned);
+    auto p = cur_;
+    cur_ += aligned;
+    return p;
+  }
+
+  void deallocate(uint8_t *p, size_t size) FLATBUFFERS_OVERRIDE {
+    if (IsLast(p, size)) cur_ = p;
+  }
+
+  uint8_t *reallocate_downward(uint8_t *old_p, size_t old_size,
+                               size_t new_size, size_t in_use_back,
+                               size_t in_use_front) FLATBUFFERS_OVERRIDE {
+    FLATBUFFERS_ASSERT(new_size > old_size);  // vector_downward only grows
+    if (IsLast(old_p, old_size) &&
+        AlignUp(new_size) <= static_cast<size_t>(end_ - old_p)) {
+      // The front stays where it is, only the back moves up to the new end.
+      memmove(old_p + new_size - in_use_back, old_p + old_size - in_use_back,
+              in_use_back);
+      cur_ = old_p + AlignUp(new_size);
+      return old_p;
+    }
+    return Allocator::reallocate_downward(old_p, old_size, new_size,
+                                          in_use_back, in_use_front);
+  }
+
+  // Makes all memory available again. Keeps the caller-supplied region or, if
+  // there is none, the most recent block, and frees all other blocks.
+  // @warning Everything allocated before is invalid afterwards, and must not
+  // be deallocated anymore (e.g. by destroying a `DetachedBuffer`).
+  void reset() {
+    if (initial_) {
+      FreeBlocks(nullptr);
+      UseRegion(initial_, initial_size_);
+    } else if (blocks_) {
+      FreeBlocks(blocks_);
+      UseRegion(BlockData(blocks_), blocks_->size);
+    }
+  }
+
+  // The number of bytes handed out from the current block or region.
+  size_t bytes_in_use() const { return static_cast<size_t>(cur_ - begin_); }
+
+ private:
+  // Precedes the memory of each block taken from upstream.
+  struct BlockHeader {
+    BlockHeader *prev;
+    size_t size;  // Not including this header.
+  };
+
+  // Allocations are aligned to this, so buffers built in the arena can hold
+  // any scalar. Also keeps memory after a `BlockHeader` aligned.
+  static const size_t kAlignment = 2 * sizeof(void *) > sizeof(largest_scalar_t)
+                                       ? 2 * sizeof(void *)
+                                       : sizeof(largest_scalar_t);
+
+  Allocator *upstream_;
+  size_t block_size_;
+  uint8_t *initial_;
+  size_t initial_size_;
+  BlockHeader *blocks_;  // Most recent first.
+  uint8_t *begin_;
+  uint8_t *cur_;
+  uint8_t *end_;
+
+  static size_t AlignUp(size_t size) {
+    return (size + kAlignment - 1) & ~(kAlignment - 1);
+  }
+
+  // Whether `p` is the most recent allocation that is still alive. Blocks
+  // start past their header, so this can't match the end of another block.
+  bool IsLast(const uint8_t *p, size_t size) const {
+    return p && p + AlignUp(size) == cur_;
+  }
+
+  void UseRegion(uint8_t *region, size_t size) {
+    // Only use aligned memory of the region.
+    const size_t skip = static_cast<size_t>(
+        (0 - reinterpret_cast<uintptr_t>(region)) & (kAlignment - 1));
+    uint8_t *aligned = region + skip;
+    begin_ = cur_ = aligned;
+    end_ = size > skip ? aligned + ((size - skip) & ~(kAlignment - 1))
+                       : aligned;
+  }
+
+  static uint8_t *BlockData(BlockHeader *block) {
+    return reinterpret_cast<uint8_t *>(block) + AlignUp(sizeof(BlockHeader));
+  }
+
+  void AddBlock(size_t min_size) {
+    const size_t size = (std::max)(min_size, AlignUp(block_size_));
+    auto block = reinterpret_cast<BlockHeader *>(
+        Allocate(upstream_, AlignUp(sizeof(BlockHeader)) + size));
+    block->prev = blocks_;
+    block->size = size;
+    blocks_ = block;
+    UseRegion(BlockData(block), size);
+  }
+
+  // Frees all blocks taken from upstream, except for `keep`.
+  void FreeBlocks(BlockHeader *keep) {
+    for (auto block = blocks_; block;) {
+      auto prev = block->prev;
+      if (block != keep) {
+        Deallocate(upstream_, reinterpret_cast<uint8_t *>(block),
+                   AlignUp(sizeof(BlockHeader)) + block->size);
+      }
+      block = prev;
+    }
+    blocks_ = keep;
+    if (keep) keep->prev = nullptr;
+  }
+
+  // You shouldn't really be copying instances of this class.
+  FLATBUFFERS_DELETE_FUNC(ArenaAllocator(const ArenaAllocator &));
+  FLATBUFFERS_DELETE_FUNC(ArenaAllocator &operator=(const ArenaAllocator &));
+};
+
+}  // namespace flatbuffers
+
+#endif  // FLATBUFFERS_ARENA_ALLOCATOR_H_
@@ -248,6 +248,16 @@ namespace flatbuffers {
   #define FLATBUFFERS_GENERAL_HEAP_ALLOC_OK 1
 #endif // !FLATBUFFERS_GENERAL_HEAP_ALLOC_OK
 
+#ifndef FLATBUFFERS_HAS_EXCEPTIONS
+  // Whether the code is compiled with exceptions enabled.
+  #if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || \
+      defined(_CPPUNWIND)
+    #define FLATBUFFERS_HAS_EXCEPTIONS 1
+  #else
+    #define FLATBUFFERS_HAS_EXCEPTIONS 0
+  #endif
+#endif // !FLATBUFFERS_HAS_EXCEPTIONS
+
 #ifndef FLATBUFFERS_HAS_NEW_STRTOD
   // Modern (C++11) strtod and strtof functions are available for use.
   // 1) nan/inf strings as argument of strtod;
@@ -308,6 +318,13 @@ template<typename T> FLATBUFFERS_CONSTEXPR inline bool IsConstTrue(T t) {
   #endif
 #endif
 
+// Hint to start loading the cache line at address `p`, which doesn't fault.
+#if defined(__GNUC__) || defined(__clang__)
+  #define FLATBUFFERS_PREFETCH(p) __builtin_prefetch(p)
+#else
+  #define FLATBUFFERS_PREFETCH(p) ((void)(p))
+#endif
+
 /// @endcond
 
 /// @file
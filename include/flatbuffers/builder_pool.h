@@ -0,0 +1,224 @@
+/*
+ * Copyright 2021 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLATBUFFERS_BUILDER_POOL_H_
+#define FLATBUFFERS_BUILDER_POOL_H_
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "flatbuffers/allocator.h"
+#include "flatbuffers/base.h"
+#include "flatbuffers/flatbuffer_builder.h"
+
+namespace flatbuffers {
+
+/// @addtogroup flatbuffers_cpp_api
+/// @{
+/// @class FlatBufferBuilderPool
+/// @brief A thread-safe pool of `FlatBufferBuilder`s for producers that build
+/// many buffers concurrently.
+/// Builders handed out by `Acquire()` come back cleared when their handle goes
+/// out of scope, but keep their grown buffer, vtable scratch and string pool.
+/// All builders allocate through the pool, which keeps the memory of buffers
+/// given away with `Release()` once their `DetachedBuffer` is destroyed, so
+/// steady state producers do not touch the general heap.
+/// The free lists are sharded by thread, so threads rarely contend on a lock.
+/// @warning The pool must outlive all its builders and all `DetachedBuffer`s
+/// released from them.
+class FlatBufferBuilderPool {
+ public:
+  struct Options {
+    // The initial buffer size of newly created builders.
+    size_t initial_size = 1024;
+    // Builders whose buffer grew beyond this are returned without it.
+    size_t max_retained_size = 16 * 1024 * 1024;
+    // The maximum number of idle builders kept per shard.
+    size_t max_builders_per_shard = 16;
+    // The maximum number of released buffers kept per shard for reuse.
+    size_t max_blocks_per_shard = 16;
+  };
+
+  // Returns a builder to its pool when going out of scope.
+  struct Returner {
+    Returner() : pool(nullptr) {}
+    explicit Returner(FlatBufferBuilderPool *p) : pool(p) {}
+    void operator()(FlatBufferBuilder *fbb) const { pool->Return(fbb); }
+    FlatBufferBuilderPool *pool;
+  };
+
+  typedef std::unique_ptr<FlatBufferBuilder, Returner> BuilderPtr;
+
+  FlatBufferBuilderPool() : FlatBufferBuilderPool(Options()) {}
+
+  explicit FlatBufferBuilderPool(const Options &opts)
+      : opts_(opts), allocator_(this) {}
+
+  ~FlatBufferBuilderPool() {
+    // Builders first, they may still hold blocks from allocator_.
+    for (size_t i = 0; i < kNumShards; i++) {
+      for (auto fbb : shards_[i].builders) delete fbb;
+      shards_[i].builders.clear();
+    }
+    for (size_t i = 0; i < kNumShards; i++) {
+      for (auto block : shards_[i].blocks) FreeBlock(block);
+      shards_[i].blocks.clear();
+    }
+  }
+
+  /// @brief Get a cleared builder, reusing an idle one if possible.
+  /// @return Returns a handle that puts the builder back into the pool when
+  /// destroyed.
+  BuilderPtr Acquire() {
+    FlatBufferBuilder *fbb = nullptr;
+    const size_t home = HomeShard();
+    for (size_t i = 0; i < kNumShards && !fbb; i++) {
+      Shard &shard = shards_[(home + i) % kNumShards];
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      if (!shard.builders.empty()) {
+        fbb = shard.builders.back();
+        shard.builders.pop_back();
+      }
+    }
+    if (!fbb) fbb = new FlatBufferBuilder(opts_.initial_size, &allocator_);
+    return BuilderPtr(fbb, Returner(this));
+  }
+
+  /// @brief The allocator all builders of this pool use. Can also be passed
+  /// to other builders so their released buffers get recycled here.
+  Allocator *GetAllocator() { return &allocator_; }
+
+ private:
+  // Each allocated block is preceded by a header recording its capacity, so
+  // blocks can be handed out for any request they are large enough for.
+  struct BlockHeader {
+    size_t capacity;
+    // Keeps the memory after the header aligned like the memory before it.
+    size_t padding;
+  };
+
+  struct Shard {
+    std::mutex mutex;
+    std::vector<FlatBufferBuilder *> builders;
+    std::vector<BlockHeader *> blocks;
+  };
+
+  class PoolAllocator : public Allocator {
+   public:
+    explicit PoolAllocator(FlatBufferBuilderPool *pool) : pool_(pool) {}
+
+    uint8_t *allocate(size_t size) FLATBUFFERS_OVERRIDE {
+      return pool_->AllocateBlock(size);
+    }
+
+    void deallocate(uint8_t *p, size_t) FLATBUFFERS_OVERRIDE {
+      pool_->DeallocateBlock(p);
+    }
+
+   private:
+    FlatBufferBuilderPool *pool_;
+  };
+
+  static const size_t kNumShards = 16;
+
+  const Options opts_;
+  PoolAllocator allocator_;
+  Shard shards_[kNumShards];
+
+  static size_t HomeShard() {
+    return std::hash<std::thread::id>()(std::this_thread::get_id()) %
+           kNumShards;
+  }
+
+  void Return(FlatBufferBuilder *fbb) {
+    // Like DeallocateBlock(), by what the buffer holds on to, even if the
+    // builder was cleared before.
+    if (fbb->GetBufferCapacity() > opts_.max_retained_size) {
+      fbb->Reset();
+    } else {
+      fbb->Clear();
+    }
+    Shard &shard = shards_[HomeShard()];
+    {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      if (shard.builders.size() < opts_.max_builders_per_shard) {
+        shard.builders.push_back(fbb);
+        return;
+      }
+    }
+    delete fbb;
+  }
+
+  uint8_t *AllocateBlock(size_t size) {
+    BlockHeader *block = nullptr;
+    Shard &shard = shards_[HomeShard()];
+    {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      // Take the smallest block that fits, but don't waste more than half.
+      size_t best = shard.blocks.size();
+      for (size_t i = 0; i < shard.blocks.size(); i++) {
+        const size_t capacity = shard.blocks[i]->capacity;
+        if (capacity < size || capacity / 2 > size) continue;
+        if (best == shard.blocks.size() ||
+            capacity < shard.blocks[best]->capacity) {
+          best = i;
+        }
+      }
+      if (best != shard.blocks.size()) {
+        block = shard.blocks[best];
+        shard.blocks[best] = shard.blocks.back();
+        shard.blocks.pop_back();
+      }
+    }
+    if (!block) {
+      block = reinterpret_cast<BlockHeader *>(
+          new uint8_t[sizeof(BlockHeader) + size]);
+      block->capacity = size;
+    }
+    return reinterpret_cast<uint8_t *>(block + 1);
+  }
+
+  void DeallocateBlock(uint8_t *p) {
+    auto block = reinterpret_cast<BlockHeader *>(p) - 1;
+    if (block->capacity <= opts_.max_retained_size) {
+      Shard &shard = shards_[HomeShard()];
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      if (shard.blocks.size() < opts_.max_blocks_per_shard) {
+        shard.blocks.push_back(block);
+        return;
+      }
+    }
+    FreeBlock(block);
+  }
+
+  static void FreeBlock(BlockHeader *block) {
+    delete[] reinterpret_cast<uint8_t *>(block);
+  }
+
+  // You shouldn't really be copying instances of this class.
+  FLATBUFFERS_DELETE_FUNC(
+      FlatBufferBuilderPool(const FlatBufferBuilderPool &));
+  FLATBUFFERS_DELETE_FUNC(
+      FlatBufferBuilderPool &operator=(const FlatBufferBuilderPool &));
+};
+/// @}
+
+}  // namespace flatbuffers
+
+#endif  // FLATBUFFERS_BUILDER_POOL_H_
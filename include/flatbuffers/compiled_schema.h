@@ -0,0 +1,591 @@
+/*
+ * Copyright 2021 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLATBUFFERS_COMPILED_SCHEMA_H_
+#define FLATBUFFERS_COMPILED_SCHEMA_H_
+
+#include <algorithm>
+#include <vector>
+
+#include "flatbuffers/flatbuffer_builder.h"
+#include "flatbuffers/reflection.h"
+#include "flatbuffers/verifier.h"
+
+namespace flatbuffers {
+
+namespace compiled_schema_internal {
+
+template<typename T> int64_t ReadInteger(const uint8_t *p) {
+  return static_cast<int64_t>(ReadScalar<T>(p));
+}
+
+template<typename T> double ReadReal(const uint8_t *p) {
+  return static_cast<double>(ReadScalar<T>(p));
+}
+
+}  // namespace compiled_schema_internal
+
+// A reflection::Schema turned, once, into plain per-object field plans.
+// The functions in reflection.h look up each field's type, child object and
+// default in the schema (itself a FlatBuffer) and switch on its BaseType every
+// time they touch it. That adds up when handling millions of tables of types
+// only known at runtime. CompiledSchema resolves all of that in its
+// constructor, so visiting, extracting, copying and verifying only read the
+// data itself.
+// The schema must outlive the CompiledSchema.
+class CompiledSchema {
+ public:
+  struct Object;
+
+  // How a field is stored, which decides how it is handled.
+  enum FieldKind : uint8_t {
+    kScalar,
+    kStruct,  // Also fixed length arrays, inside structs.
+    kString,
+    kTable,
+    kUnion,
+    kVectorOfScalars,
+    kVectorOfStructs,
+    kVectorOfStrings,
+    kVectorOfTables,
+    kVectorOfUnions,
+  };
+
+  // What a union type value refers to: a table, struct or string.
+  struct UnionMember {
+    reflection::BaseType base_type;  // None if the value isn't a member.
+    const Object *object;            // For Obj.
+  };
+
+  struct Field {
+    const reflection::Field *def;
+    voffset_t offset;  // Vtable slot, or byte offset in a struct.
+    FieldKind kind;
+    reflection::BaseType type;  // Of the value, or of vector elements.
+    bool required;
+    // Inline size and alignment of the value (scalars and structs) or of a
+    // vector element (vectors of scalars and structs).
+    uint32_t size;
+    uint32_t align;
+    const Object *object;  // Tables and structs, or vectors of them.
+    const std::vector<UnionMember> *union_members;  // Indexed by union type.
+    // Defaults of scalars, each also converted to the other type.
+    int64_t default_integer;
+    double default_real;
+    // Read a scalar, or a vector of scalars element, of this type.
+    int64_t (*read_integer)(const uint8_t *);
+    double (*read_real)(const uint8_t *);
+  };
+
+  struct Object {
+    const reflection::Object *def;
+    bool is_struct;
+    uint32_t bytesize;
+    uint32_t minalign;
+    std::vector<Field> fields;  // In id order.
+    // Fields by vtable slot, nullptr for slots not in the schema.
+    std::vector<const Field *> slots;
+    // What CopyTable() needs: fields stored out of line, then fields stored
+    // inline with the largest alignment first, so they pack without padding.
+    std::vector<const Field *> offset_fields;
+    std::vector<const Field *> inline_fields;
+
+    // Returns nullptr if there's no such field.
+    const Field *LookupField(const char *name) const {
+      auto fielddef = def->fields()->LookupByKey(name);
+      return fielddef ? &fields[fielddef->id()] : nullptr;
+    }
+  };
+
+  explicit CompiledSchema(const reflection::Schema &schema)
+      : schema_(schema) {
+    auto objectdefs = schema.objects();
+    auto enumdefs = schema.enums();
+    objects_.resize(objectdefs->size());
+    unions_.resize(enumdefs->size());
+    for (uoffset_t i = 0; i < enumdefs->size(); i++) {
+      auto enumdef = enumdefs->Get(i);
+      if (!enumdef->is_union()) continue;
+      auto &members = unions_[i];
+      for (auto it = enumdef->values()->begin(); it != enumdef->values()->end();
+           ++it) {
+        auto value = static_cast<size_t>(it->value());
+        if (value >= members.size()) {
+          UnionMember none = { reflection::None, nullptr };
+          members.resize(value + 1, none);
+        }
+        auto union_type = it->union_type();
+        members[value].base_type = union_type->base_type();
+        if (union_type->base_type() == reflection::Obj) {
+          members[value].object = &objects_[union_type->index()];
+        }
+      }
+    }
+    for (uoffset_t i = 0; i < objectdefs->size(); i++) {
+      CompileObject(*objectdefs->Get(i), &objects_[i]);
+    }
+  }
+
+  const reflection::Schema &schema() const { return schema_; }
+
+  // In the same order as schema().objects().
+  const std::vector<Object> &objects() const { return objects_; }
+
+  // Returns nullptr if the schema has no root type.
+  const Object *root() const {
+    auto root_table = schema_.root_table();
+    return root_table ? &objects_[ObjectIndex(*root_table)] : nullptr;
+  }
+
+  // Takes a fully qualified name, returns nullptr if there's no such object.
+  const Object *LookupObject(const char *name) const {
+    auto objectdef = schema_.objects()->LookupByKey(name);
+    return objectdef ? &objects_[ObjectIndex(*objectdef)] : nullptr;
+  }
+
+  // Calls visitor(field, data) for each field stored in "table", in id
+  // order. "data" points to the value inline in the table: for strings,
+  // vectors, tables and unions that is their offset.
+  template<typename F>
+  static void ForAllFields(const Table &table, const Object &object,
+                           F visitor) {
+    auto data = reinterpret_cast<const uint8_t *>(&table);
+    auto vtable = table.GetVTable();
+    // The verifier accepts vtables too short to hold even their two sizes.
+    const size_t vsize = ReadScalar<voffset_t>(vtable) / sizeof(voffset_t);
+    const size_t num_slots =
+        std::min(vsize < 2 ? 0 : vsize - 2, object.slots.size());
+    for (size_t i = 0; i < num_slots; i++) {
+      auto field_offset =
+          ReadScalar<voffset_t>(vtable + (i + 2) * sizeof(voffset_t));
+      if (field_offset && object.slots[i]) {
+        visitor(*object.slots[i], data + field_offset);
+      }
+    }
+  }
+
+  // Scalar fields as a 64bit int or a double, like GetAnyFieldI/F, except
+  // that defaults are converted too: an absent int field with default 2 reads
+  // as 2.0 from GetFieldF(), where GetAnyFieldF() returns 0.0.
+  static int64_t GetFieldI(const Table &table, const Field &field) {
+    FLATBUFFERS_ASSERT(field.kind == kScalar);
+    auto p = table.GetAddressOf(field.offset);
+    return p ? field.read_integer(p) : field.default_integer;
+  }
+  static double GetFieldF(const Table &table, const Field &field) {
+    FLATBUFFERS_ASSERT(field.kind == kScalar);
+    auto p = table.GetAddressOf(field.offset);
+    return p ? field.read_real(p) : field.default_real;
+  }
+  static int64_t GetFieldI(const Struct &st, const Field &field) {
+    FLATBUFFERS_ASSERT(field.kind == kScalar);
+    return field.read_integer(st.GetAddressOf(field.offset));
+  }
+  static double GetFieldF(const Struct &st, const Field &field) {
+    FLATBUFFERS_ASSERT(field.kind == kScalar);
+    return field.read_real(st.GetAddressOf(field.offset));
+  }
+
+  static const String *GetFieldS(const Table &table, const Field &field) {
+    FLATBUFFERS_ASSERT(field.kind == kString);
+    return table.GetPointer<const String *>(field.offset);
+  }
+
+  // Tables, and union values of any type.
+  static const Table *GetFieldT(const Table &table, const Field &field) {
+    FLATBUFFERS_ASSERT(field.kind == kTable || field.kind == kUnion);
+    return table.GetPointer<const Table *>(field.offset);
+  }
+
+  static const VectorOfAny *GetFieldAnyV(const Table &table,
+                                         const Field &field) {
+    return table.GetPointer<const VectorOfAny *>(field.offset);
+  }
+
+  // What the union in "field" currently holds, with base_type None if
+  // nothing (or something unknown to this schema).
+  static UnionMember GetUnionMember(const Table &table, const Field &field) {
+    FLATBUFFERS_ASSERT(field.kind == kUnion);
+    return Member(field, table.GetField<uint8_t>(
+                             field.offset - sizeof(voffset_t), 0));
+  }
+
+  // Like CopyTable() in reflection.h. Also copies vectors of unions, and
+  // packs the inline fields of each table by alignment.
+  Offset<const Table *> CopyTable(FlatBufferBuilder &fbb, const Object &object,
+                                  const Table &table,
+                                  bool use_string_pooling = false) const {
+    std::vector<Offset<void>> stack;
+    return CopyTable(fbb, object, table, use_string_pooling, stack);
+  }
+
+  // Like Verify() in reflection.h. Also checks that offsets are in range and
+  // that required fields are present, like generated code does.
+  bool Verify(const Object &root, const uint8_t *buf, size_t length,
+              uoffset_t max_depth = 64, uoffset_t max_tables = 1000000) const {
+    Verifier v(buf, length, max_depth, max_tables);
+    return v.VerifyOffset(0) && VerifyTable(v, root, GetAnyRoot(buf));
+  }
+
+ private:
+  size_t ObjectIndex(const reflection::Object &objectdef) const {
+    auto objectdefs = schema_.objects();
+    for (uoffset_t i = 0; i < objectdefs->size(); i++) {
+      if (objectdefs->Get(i) == &objectdef) return i;
+    }
+    FLATBUFFERS_ASSERT(false);
+    return 0;
+  }
+
+  static UnionMember Member(const Field &field, uint8_t union_type) {
+    auto &members = *field.union_members;
+    if (union_type < members.size()) return members[union_type];
+    UnionMember none = { reflection::None, nullptr };
+    return none;
+  }
+
+  void CompileObject(const reflection::Object &objectdef, Object *object) {
+    object->def = &objectdef;
+    object->is_struct = objectdef.is_struct();
+    object->bytesize = static_cast<uint32_t>(objectdef.bytesize());
+    object->minalign = static_cast<uint32_t>(objectdef.minalign());
+    auto fielddefs = objectdef.fields();
+    object->fields.resize(fielddefs->size());
+    for (uoffset_t i = 0; i < fielddefs->size(); i++) {
+      auto fielddef = fielddefs->Get(i);
+      FLATBUFFERS_ASSERT(fielddef->id() < fielddefs->size());
+      CompileField(*fielddef, &object->fields[fielddef->id()]);
+    }
+    for (auto it = object->fields.begin(); it != object->fields.end(); ++it) {
+      if (!object->is_struct) {
+        auto slot = (it->offset - FieldIndexToOffset(0)) / sizeof(voffset_t);
+        if (slot >= object->slots.size()) object->slots.resize(slot + 1);
+        object->slots[slot] = &*it;
+      }
+      auto is_inline = it->kind == kScalar || it->kind == kStruct;
+      (is_inline ? object->inline_fields : object->offset_fields)
+          .push_back(&*it);
+    }
+    std::stable_sort(object->inline_fields.begin(),
+                     object->inline_fields.end(),
+                     [](const Field *a, const Field *b) {
+                       return a->align > b->align;
+                     });
+  }
+
+  void CompileField(const reflection::Field &fielddef, Field *field) {
+    using namespace compiled_schema_internal;
+    auto type = fielddef.type();
+    auto base_type = type->base_type();
+    field->def = &fielddef;
+    field->offset = fielddef.offset();
+    auto is_series =
+        base_type == reflection::Vector || base_type == reflection::Array;
+    field->type = is_series ? type->element() : base_type;
+    field->required = fielddef.required();
+    field->size = 0;
+    field->align = 1;
+    field->object = nullptr;
+    field->union_members = nullptr;
+    field->default_integer = fielddef.default_integer();
+    field->default_real = fielddef.default_real();
+    field->read_integer = nullptr;
+    field->read_real = nullptr;
+    if (IsScalar(field->type)) {
+      field->size = field->align =
+          static_cast<uint32_t>(GetTypeSize(field->type));
+      // clang-format off
+      #define FLATBUFFERS_READERS(T) \
+        field->read_integer = ReadInteger<T>; \
+        field->read_real = ReadReal<T>
+      switch (field->type) {
+        case reflection::UType:
+        case reflection::Bool:
+        case reflection::UByte:  FLATBUFFERS_READERS(uint8_t ); break;
+        case reflection::Byte:   FLATBUFFERS_READERS(int8_t  ); break;
+        case reflection::Short:  FLATBUFFERS_READERS(int16_t ); break;
+        case reflection::UShort: FLATBUFFERS_READERS(uint16_t); break;
+        case reflection::Int:    FLATBUFFERS_READERS(int32_t ); break;
+        case reflection::UInt:   FLATBUFFERS_READERS(uint32_t); break;
+        case reflection::Long:   FLATBUFFERS_READERS(int64_t ); break;
+        case reflection::ULong:  FLATBUFFERS_READERS(uint64_t); break;
+        case reflection::Float:  FLATBUFFERS_READERS(float   ); break;
+        case reflection::Double: FLATBUFFERS_READERS(double  ); break;
+        default: FLATBUFFERS_ASSERT(false);
+      }
+      #undef FLATBUFFERS_READERS
+      // clang-format on
+      if (IsFloat(field->type)) {
+        field->default_integer = static_cast<int64_t>(field->default_real);
+      } else {
+        field->default_real = static_cast<double>(field->default_integer);
+      }
+    }
+    const reflection::Object *objectdef = nullptr;
+    if (field->type == reflection::Obj) {
+      objectdef = schema_.objects()->Get(type->index());
+      field->object = &objects_[type->index()];
+      if (objectdef->is_struct()) {
+        field->size = static_cast<uint32_t>(objectdef->bytesize());
+        field->align = static_cast<uint32_t>(objectdef->minalign());
+      }
+    }
+    if (field->type == reflection::Union) {
+      field->union_members = &unions_[type->index()];
+    }
+    auto is_struct = objectdef && objectdef->is_struct();
+    switch (base_type) {
+      case reflection::Obj:
+        field->kind = is_struct ? kStruct : kTable;
+        break;
+      case reflection::Array:
+        // Aligned like its elements, which are scalars or structs.
+        field->kind = kStruct;
+        field->size *= type->fixed_length();
+        break;
+      case reflection::String: field->kind = kString; break;
+      case reflection::Union: field->kind = kUnion; break;
+      case reflection::Vector:
+        switch (field->type) {
+          case reflection::String: field->kind = kVectorOfStrings; break;
+          case reflection::Union: field->kind = kVectorOfUnions; break;
+          case reflection::Obj:
+            field->kind = is_struct ? kVectorOfStructs : kVectorOfTables;
+            break;
+          default: field->kind = kVectorOfScalars; break;
+        }
+        break;
+      default: field->kind = kScalar; break;
+    }
+  }
+
+  static uoffset_t CopyString(FlatBufferBuilder &fbb, const uint8_t *str,
+                              bool use_string_pooling) {
+    auto s = reinterpret_cast<const String *>(str);
+    return use_string_pooling ? fbb.CreateSharedString(s).o
+                              : fbb.CreateString(s).o;
+  }
+
+  // "stack" holds the offsets of the children of all tables being copied, so
+  // it is only allocated once per copy.
+  uoffset_t CopyTable(FlatBufferBuilder &fbb, const Object &object,
+                      const Table &table, bool use_string_pooling,
+                      std::vector<Offset<void>> &stack) const {
+    FLATBUFFERS_ASSERT(!object.is_struct);
+    // Before we can construct the table, we have to first generate any
+    // subobjects, and collect their offsets.
+    const auto base = stack.size();
+    for (auto it = object.offset_fields.begin();
+         it != object.offset_fields.end(); ++it) {
+      auto p = table.GetAddressOf((*it)->offset);
+      auto offset =
+          p ? CopyValue(fbb, **it, table, p + ReadScalar<uoffset_t>(p),
+                        use_string_pooling, stack)
+            : 0;
+      stack.push_back(Offset<void>(offset));
+    }
+    auto start = fbb.StartTable();
+    for (size_t i = 0; i < object.offset_fields.size(); i++) {
+      fbb.AddOffset(object.offset_fields[i]->offset, stack[base + i]);
+    }
+    for (auto it = object.inline_fields.begin();
+         it != object.inline_fields.end(); ++it) {
+      auto &field = **it;
+      auto p = table.GetAddressOf(field.offset);
+      if (!p) continue;
+      fbb.Align(field.align);
+      fbb.PushBytes(p, field.size);
+      fbb.TrackField(field.offset, fbb.GetSize());
+    }
+    stack.resize(base);
+    return fbb.EndTable(start);
+  }
+
+  uoffset_t CopyUnionValue(FlatBufferBuilder &fbb, const UnionMember &member,
+                           const uint8_t *value, bool use_string_pooling,
+                           std::vector<Offset<void>> &stack) const {
+    switch (member.base_type) {
+      case reflection::Obj:
+        if (member.object->is_struct) {
+          fbb.Align(member.object->minalign);
+          fbb.PushBytes(value, member.object->bytesize);
+          return fbb.GetSize();
+        }
+        return CopyTable(fbb, *member.object,
+                         *reinterpret_cast<const Table *>(value),
+                         use_string_pooling, stack);
+      case reflection::String:
+        return CopyString(fbb, value, use_string_pooling);
+      default: return 0;
+    }
+  }
+
+  uoffset_t CopyValue(FlatBufferBuilder &fbb, const Field &field,
+                      const Table &table, const uint8_t *value,
+                      bool use_string_pooling,
+                      std::vector<Offset<void>> &stack) const {
+    switch (field.kind) {
+      case kString: return CopyString(fbb, value, use_string_pooling);
+      case kTable:
+        return CopyTable(fbb, *field.object,
+                         *reinterpret_cast<const Table *>(value),
+                         use_string_pooling, stack);
+      case kUnion:
+        return CopyUnionValue(fbb, GetUnionMember(table, field), value,
+                              use_string_pooling, stack);
+      case kVectorOfScalars:
+      case kVectorOfStructs: {
+        auto vec = reinterpret_cast<const VectorOfAny *>(value);
+        fbb.StartVector(vec->size(), field.size, field.align);
+        fbb.PushBytes(vec->Data(), field.size * vec->size());
+        return fbb.EndVector(vec->size());
+      }
+      case kVectorOfStrings:
+      case kVectorOfTables:
+      case kVectorOfUnions: {
+        auto vec = reinterpret_cast<const Vector<uoffset_t> *>(value);
+        auto types =
+            field.kind == kVectorOfUnions
+                ? table.GetPointer<const Vector<uint8_t> *>(
+                      field.offset - sizeof(voffset_t))
+                : nullptr;
+        const auto base = stack.size();
+        for (uoffset_t i = 0; i < vec->size(); i++) {
+          auto elem = vec->Data() + i * sizeof(uoffset_t);
+          elem += ReadScalar<uoffset_t>(elem);
+          uoffset_t offset = 0;
+          if (field.kind == kVectorOfStrings) {
+            offset = CopyString(fbb, elem, use_string_pooling);
+          } else if (field.kind == kVectorOfTables) {
+            offset = CopyTable(fbb, *field.object,
+                               *reinterpret_cast<const Table *>(elem),
+                               use_string_pooling, stack);
+          } else if (types && i < types->size()) {
+            offset = CopyUnionValue(fbb, Member(field, types->Get(i)), elem,
+                                    use_string_pooling, stack);
+          }
+          stack.push_back(Offset<void>(offset));
+        }
+        auto offset = fbb.CreateVector(stack.data() + base, vec->size()).o;
+        stack.resize(base);
+        return offset;
+      }
+      default: FLATBUFFERS_ASSERT(false); return 0;
+    }
+  }
+
+  bool VerifyUnionValue(Verifier &v, const UnionMember &member,
+                        const uint8_t *value) const {
+    switch (member.base_type) {
+      case reflection::Obj:
+        return member.object->is_struct
+                   ? v.VerifyFromPointer(value, member.object->bytesize)
+                   : VerifyTable(v, *member.object,
+                                 reinterpret_cast<const Table *>(value));
+      case reflection::String:
+        return v.VerifyString(reinterpret_cast<const String *>(value));
+      default: return false;
+    }
+  }
+
+  bool VerifyValue(Verifier &v, const Field &field, const Table &table,
+                   const uint8_t *value) const {
+    switch (field.kind) {
+      case kString:
+        return v.VerifyString(reinterpret_cast<const String *>(value));
+      case kTable:
+        return VerifyTable(v, *field.object,
+                           reinterpret_cast<const Table *>(value));
+      case kUnion: {
+        auto union_type =
+            table.GetField<uint8_t>(field.offset - sizeof(voffset_t), 0);
+        // Not present.
+        if (!union_type) return true;
+        return VerifyUnionValue(v, Member(field, union_type), value);
+      }
+      case kVectorOfScalars:
+      case kVectorOfStructs: return v.VerifyVectorOrString(value, field.size);
+      case kVectorOfStrings:
+        return v.VerifyVectorOrString(value, sizeof(uoffset_t)) &&
+               v.VerifyVectorOfStrings(
+                   reinterpret_cast<const Vector<Offset<String>> *>(value));
+      case kVectorOfTables: {
+        if (!v.VerifyVectorOrString(value, sizeof(uoffset_t))) return false;
+        auto vec = reinterpret_cast<const Vector<Offset<Table>> *>(value);
+        for (uoffset_t i = 0; i < vec->size(); i++) {
+          if (!VerifyTable(v, *field.object, vec->Get(i))) return false;
+        }
+        return true;
+      }
+      case kVectorOfUnions: {
+        if (!v.VerifyVectorOrString(value, sizeof(uoffset_t))) return false;
+        auto vec = reinterpret_cast<const Vector<Offset<uint8_t>> *>(value);
+        auto types = table.GetPointer<const Vector<uint8_t> *>(
+            field.offset - sizeof(voffset_t));
+        if (!types || !v.VerifyVector(types) || types->size() != vec->size()) {
+          return false;
+        }
+        for (uoffset_t i = 0; i < vec->size(); i++) {
+          auto union_type = types->Get(i);
+          if (union_type &&
+              !VerifyUnionValue(v, Member(field, union_type), vec->Get(i))) {
+            return false;
+          }
+        }
+        return true;
+      }
+      default: FLATBUFFERS_ASSERT(false); return false;
+    }
+  }
+
+  bool VerifyTable(Verifier &v, const Object &object,
+                   const Table *table) const {
+    if (!table->VerifyTableStart(v)) return false;
+    auto data = reinterpret_cast<const uint8_t *>(table);
+    for (auto it = object.fields.begin(); it != object.fields.end(); ++it) {
+      auto &field = *it;
+      auto field_offset = table->GetOptionalFieldOffset(field.offset);
+      if (!field_offset) {
+        if (field.required) return false;
+        continue;
+      }
+      if (field.kind == kScalar || field.kind == kStruct) {
+        if (!v.VerifyFieldStruct(data, field_offset, field.size, field.align))
+          return false;
+        continue;
+      }
+      if (!v.VerifyOffset(data, field_offset)) return false;
+      auto p = data + field_offset;
+      if (!VerifyValue(v, field, *table, p + ReadScalar<uoffset_t>(p)))
+        return false;
+    }
+    return v.EndTable();
+  }
+
+  const reflection::Schema &schema_;
+  std::vector<Object> objects_;
+  // Members of each union, indexed like schema_.enums().
+  std::vector<std::vector<UnionMember>> unions_;
+
+  // Fields point into objects_ and unions_, so a copy would point into the
+  // original.
+  FLATBUFFERS_DELETE_FUNC(CompiledSchema(const CompiledSchema &));
+  FLATBUFFERS_DELETE_FUNC(CompiledSchema &operator=(const CompiledSchema &));
+};
+
+}  // namespace flatbuffers
+
+#endif  // FLATBUFFERS_COMPILED_SCHEMA_H_
@@ -26,6 +26,7 @@
 #include "flatbuffers/buffer_ref.h"
 #include "flatbuffers/default_allocator.h"
 #include "flatbuffers/detached_buffer.h"
+#include "flatbuffers/offset_index.h"
 #include "flatbuffers/stl_emulation.h"
 #include "flatbuffers/string.h"
 #include "flatbuffers/struct.h"
@@ -92,6 +93,10 @@ class FlatBufferBuilder {
         minalign_(1),
         force_defaults_(false),
         dedup_vtables_(true),
+        index_vtables_(false),
+        vtable_index_(nullptr),
+        index_strings_(false),
+        string_index_(nullptr),
         string_pool(nullptr) {
     EndianCheck();
   }
@@ -106,6 +111,10 @@ class FlatBufferBuilder {
         minalign_(1),
         force_defaults_(false),
         dedup_vtables_(true),
+        index_vtables_(false),
+        vtable_index_(nullptr),
+        index_strings_(false),
+        string_index_(nullptr),
         string_pool(nullptr) {
     EndianCheck();
     // Default construct and swap idiom.
@@ -132,6 +141,10 @@ class FlatBufferBuilder {
     swap(minalign_, other.minalign_);
     swap(force_defaults_, other.force_defaults_);
     swap(dedup_vtables_, other.dedup_vtables_);
+    swap(index_vtables_, other.index_vtables_);
+    vtable_index_.swap(other.vtable_index_);
+    swap(index_strings_, other.index_strings_);
+    string_index_.swap(other.string_index_);
     swap(string_pool, other.string_pool);
   }
 
@@ -152,6 +165,8 @@ class FlatBufferBuilder {
     nested = false;
     finished = false;
     minalign_ = 1;
+    vtable_index_.clear();
+    string_index_.clear();
     if (string_pool) string_pool->clear();
   }
 
@@ -159,6 +174,11 @@ class FlatBufferBuilder {
   /// @return Returns an `uoffset_t` with the current size of the buffer.
   uoffset_t GetSize() const { return buf_.size(); }
 
+  /// @brief The size of the memory currently reserved for the buffer.
+  /// @return Returns a `size_t` with the capacity of the buffer, 0 if the
+  /// builder holds no buffer.
+  size_t GetBufferCapacity() const { return buf_.capacity(); }
+
   /// @brief Get the serialized buffer (after you call `Finish()`).
   /// @return Returns an `uint8_t` pointer to the FlatBuffer data inside the
   /// buffer.
@@ -207,6 +227,8 @@ class FlatBufferBuilder {
   /// called..
   uint8_t *ReleaseRaw(size_t &size, size_t &offset) {
     Finished();
+    vtable_index_.clear();
+    string_index_.clear();
     return buf_.release_raw(size, offset);
   }
 
@@ -242,6 +264,18 @@ class FlatBufferBuilder {
   /// @param[in] dedup When set to `true`, dedup vtables.
   void DedupVtables(bool dedup) { dedup_vtables_ = dedup; }
 
+  /// @brief By default deduping compares each new vtable against all previous
+  /// ones, which gets slow for buffers with many distinct table layouts.
+  /// @param[in] index When set to `true`, find duplicate vtables through a
+  /// hash index instead.
+  void IndexVtables(bool index) { index_vtables_ = index; }
+
+  /// @brief By default `CreateSharedString` finds previously shared strings
+  /// through a `std::set` on the heap, at O(log n) string comparisons each.
+  /// @param[in] index When set to `true`, use a hash index instead. Strings
+  /// shared before switching modes are not found by the other mode.
+  void IndexSharedStrings(bool index) { index_strings_ = index; }
+
   /// @cond FLATBUFFERS_INTERNAL
   void Pad(size_t num_bytes) { buf_.fill(num_bytes); }
 
@@ -391,7 +425,16 @@ class FlatBufferBuilder {
     auto vt_use = GetSize();
     // See if we already have generated a vtable with this exact same
     // layout before. If so, make it point to the old one, remove this one.
-    if (dedup_vtables_) {
+    uint32_t vt1_hash = 0;
+    if (dedup_vtables_ && index_vtables_) {
+      IndexScratchVtables();
+      vt1_hash = HashBytes(reinterpret_cast<uint8_t *>(vt1), vt1_size);
+      auto vt2_offset = vtable_index_.find(vt1_hash, VtableEquals(buf_, vt1));
+      if (vt2_offset) {
+        vt_use = vt2_offset;
+        buf_.pop(GetSize() - vtableoffsetloc);
+      }
+    } else if (dedup_vtables_) {
       for (auto it = buf_.scratch_data(); it < buf_.scratch_end();
            it += sizeof(uoffset_t)) {
         auto vt_offset_ptr = reinterpret_cast<uoffset_t *>(it);
@@ -404,7 +447,12 @@ class FlatBufferBuilder {
       }
     }
     // If this is a new vtable, remember it.
-    if (vt_use == GetSize()) { buf_.scratch_push_small(vt_use); }
+    if (vt_use == GetSize()) {
+      buf_.scratch_push_small(vt_use);
+      if (dedup_vtables_ && index_vtables_) {
+        vtable_index_.insert(vt1_hash, vt_use);
+      }
+    }
     // Fill the vtable offset we created above.
     // The offset points from the beginning of the object to where the
     // vtable is stored.
@@ -516,11 +564,22 @@ class FlatBufferBuilder {
   /// @brief Store a string in the buffer, which can contain any binary data.
   /// If a string with this exact contents has already been serialized before,
   /// instead simply returns the offset of the existing string. This uses a map
-  /// stored on the heap, but only stores the numerical offsets.
+  /// stored on the heap (or a hash index, see `IndexSharedStrings`), but only
+  /// stores the numerical offsets.
   /// @param[in] str A const char pointer to the data to be stored as a string.
   /// @param[in] len The number of bytes that should be stored from `str`.
   /// @return Returns the offset in the buffer where the string starts.
   Offset<String> CreateSharedString(const char *str, size_t len) {
+    if (index_strings_) {
+      // Look up before serializing, so repeated strings are never copied.
+      const auto hash = HashBytes(reinterpret_cast<const uint8_t *>(str), len);
+      const auto existing =
+          string_index_.find(hash, StringEquals(buf_, str, len));
+      if (existing) return Offset<String>(existing);
+      const auto off = CreateString(str, len);
+      string_index_.insert(hash, off.o);
+      return off;
+    }
     FLATBUFFERS_ASSERT(FLATBUFFERS_GENERAL_HEAP_ALLOC_OK);
     if (!string_pool)
       string_pool = new StringOffsetMap(StringOffsetCompare(buf_));
@@ -1124,6 +1183,7 @@ class FlatBufferBuilder {
   void Finish(uoffset_t root, const char *file_identifier, bool size_prefix) {
     NotNested();
     buf_.clear_scratch();
+    vtable_index_.clear();
     // This will cause the whole buffer to be aligned.
     PreAlign((size_prefix ? sizeof(uoffset_t) : 0) + sizeof(uoffset_t) +
                  (file_identifier ? kFileIdentifierLength : 0),
@@ -1164,6 +1224,39 @@ class FlatBufferBuilder {
 
   bool dedup_vtables_;
 
+  bool index_vtables_;
+
+  // For use with IndexVtables. Holds the offsets of all vtables that are also
+  // recorded in the scratch pad of buf_, keyed by a hash of their contents.
+  OffsetIndex vtable_index_;
+
+  struct VtableEquals {
+    VtableEquals(const vector_downward &buf, const voffset_t *vt)
+        : buf_(&buf), vt_(vt) {}
+    bool operator()(uoffset_t vt_offset) const {
+      auto vt2 = reinterpret_cast<const voffset_t *>(buf_->data_at(vt_offset));
+      auto vt_size = ReadScalar<voffset_t>(vt_);
+      return vt_size == ReadScalar<voffset_t>(vt2) &&
+             0 == memcmp(vt2, vt_, vt_size);
+    }
+    const vector_downward *buf_;
+    const voffset_t *vt_;
+  };
+
+  // Vtables written while indexing was off only live in the scratch pad, add
+  // them to the index the first time it is used.
+  void IndexScratchVtables() {
+    auto num_vtables = buf_.scratch_size() / sizeof(uoffset_t);
+    if (vtable_index_.size() == num_vtables) return;
+    vtable_index_.clear();
+    for (auto it = buf_.scratch_data(); it < buf_.scratch_end();
+         it += sizeof(uoffset_t)) {
+      auto vt_offset = *reinterpret_cast<uoffset_t *>(it);
+      auto vt = buf_.data_at(vt_offset);
+      vtable_index_.insert(HashBytes(vt, ReadScalar<voffset_t>(vt)), vt_offset);
+    }
+  }
+
   struct StringOffsetCompare {
     StringOffsetCompare(const vector_downward &buf) : buf_(&buf) {}
     bool operator()(const Offset<String> &a, const Offset<String> &b) const {
@@ -1175,6 +1268,23 @@ class FlatBufferBuilder {
     const vector_downward *buf_;
   };
 
+  bool index_strings_;
+
+  // For use with CreateSharedString when index_strings_ is set.
+  OffsetIndex string_index_;
+
+  struct StringEquals {
+    StringEquals(const vector_downward &buf, const char *str, size_t len)
+        : buf_(&buf), str_(str), len_(len) {}
+    bool operator()(uoffset_t str_offset) const {
+      auto str = reinterpret_cast<const String *>(buf_->data_at(str_offset));
+      return str->size() == len_ && 0 == memcmp(str->data(), str_, len_);
+    }
+    const vector_downward *buf_;
+    const char *str_;
+    size_t len_;
+  };
+
   // For use with CreateSharedString. Instantiated on first use only.
   typedef std::set<Offset<String>, StringOffsetCompare> StringOffsetMap;
   StringOffsetMap *string_pool;
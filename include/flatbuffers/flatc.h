@@ -108,6 +108,16 @@ class FlatCompiler {
                         const std::string & schema_filename,
                         const std::vector<std::string> &binary_files);
 
+  std::string LoadSchemaAsBinary(
+      const std::string &filename,
+      std::vector<const char *> &include_directories) const;
+
+  void ConvertBinaries(const std::string &from_schema,
+                       const std::string &to_schema,
+                       const std::vector<std::string> &binary_files,
+                       const std::string &output_path,
+                       std::vector<const char *> &include_directories);
+
   InitParams params_;
 };
 
@@ -27,6 +27,21 @@
 #  include <intrin.h>
 #endif
 
+// The key hashes of maps are probed 16 at a time with SIMD where the baseline
+// instruction set has it. Define FLATBUFFERS_NO_SIMD to always use scalar code.
+// clang-format off
+#if !defined(FLATBUFFERS_NO_SIMD)
+  #if defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define FLATBUFFERS_FLEXBUFFERS_SSE2 1
+  #elif defined(__aarch64__) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define FLATBUFFERS_FLEXBUFFERS_NEON 1
+  #endif
+#endif
+// clang-format on
+
 #if defined(_MSC_VER)
 #  pragma warning(push)
 #  pragma warning(disable : 4127)  // C4127: conditional expression is constant
@@ -331,6 +346,11 @@ class FixedTypedVector : public Object {
   uint8_t len_;
 };
 
+// Set in the keys byte width of a map that is preceded by a hash table of its
+// keys (see kMapKeyHashesMagic below), so readers never mistake other data
+// for one.
+static const uint8_t kMapKeyHashesFlag = 0x80;
+
 class Map : public Vector {
  public:
   Map(const uint8_t *data, uint8_t byte_width) : Vector(data, byte_width) {}
@@ -344,8 +364,8 @@ class Map : public Vector {
     const size_t num_prefixed_fields = 3;
     auto keys_offset = data_ - byte_width_ * num_prefixed_fields;
     return TypedVector(Indirect(keys_offset, byte_width_),
-                       static_cast<uint8_t>(
-                           ReadUInt64(keys_offset + byte_width_, byte_width_)),
+                       static_cast<uint8_t>(KeysWidthField() &
+                                            ~kMapKeyHashesFlag),
                        FBT_KEY);
   }
 
@@ -357,8 +377,115 @@ class Map : public Vector {
   }
 
   bool IsTheEmptyMap() const { return data_ == EmptyMap().data_; }
+
+ private:
+  // Looks `key` up in the key hashes of the map, setting `*index` to its
+  // index, or to the size of the map if it is absent.
+  // @return Returns false if the map has no key hashes.
+  bool FindHashedKey(const TypedVector &keys, const char *key,
+                     size_t *index) const;
+
+  // The keys byte width, along with kMapKeyHashesFlag.
+  uint8_t KeysWidthField() const {
+    const size_t num_prefixed_fields = 2;
+    return static_cast<uint8_t>(
+        ReadUInt64(data_ - byte_width_ * num_prefixed_fields, byte_width_));
+  }
 };
 
+// Maps built with BUILDER_FLAG_MAP_KEY_HASHES and at least
+// kMinHashedMapSize keys are preceded by a hash table of their keys, which
+// lets Map::operator[] find a key with one string comparison instead of a
+// binary search. It sits between the keys vector and the fields before the
+// map, and kMapKeyHashesFlag is set in the keys byte width of the map, which
+// readers that don't know about it can't read. For G groups of 16 slots, it
+// has:
+//   uint8_t tags[16 * G];      // 0 for empty slots, else 0x80 | hash >> 57.
+//   uint16_t indices[16 * G];  // The index of the key of each full slot.
+//   uint32_t num_keys;
+//   uint32_t magic;            // kMapKeyHashesMagic.
+// A key goes into the first empty slot of group hash % G, or of the groups
+// after it, so a lookup can stop at the first group with an empty slot.
+static const size_t kMinHashedMapSize = 16;
+static const size_t kMaxHashedMapSize = 0xFFFF;
+static const uint32_t kMapKeyHashesMagic = 0x3148464B;  // "KFH1".
+
+// A hash of a map key of `len` bytes, independent of the host byte order.
+inline uint64_t KeyHash(const char *key, size_t len) {
+  const uint64_t kMul = 0x9E3779B97F4A7C15ULL;
+  const uint8_t *p = reinterpret_cast<const uint8_t *>(key);
+  uint64_t h = len * kMul;
+  for (; len >= 8; p += 8, len -= 8) {
+    uint64_t word;
+    memcpy(&word, p, sizeof(word));
+    h = (h ^ flatbuffers::EndianScalar(word)) * kMul;
+    h ^= h >> 29;
+  }
+  uint64_t tail = 0;
+  for (size_t i = 0; i < len; i++) {
+    tail |= static_cast<uint64_t>(p[i]) << (8 * i);
+  }
+  h = (h ^ tail) * kMul;
+  return h ^ (h >> 32);
+}
+
+// The number of groups of 16 slots for `num_keys` keys, which keeps at least
+// an eighth of the slots empty.
+inline size_t KeyHashGroups(size_t num_keys) {
+  size_t groups = 1;
+  while (groups * 16 * 7 < num_keys * 8) groups *= 2;
+  return groups;
+}
+
+inline size_t KeyHashesSize(size_t num_keys) {
+  return KeyHashGroups(num_keys) * 16 * (1 + sizeof(uint16_t)) +
+         2 * sizeof(uint32_t);
+}
+
+inline uint8_t KeyHashTag(uint64_t hash) {
+  return static_cast<uint8_t>(0x80 | (hash >> 57));
+}
+
+// Returns a mask with bit i set if tags[i] == tag, for the 16 tags at `tags`.
+inline uint32_t MatchKeyHashTags(const uint8_t *tags, uint8_t tag) {
+  // clang-format off
+  #if defined(FLATBUFFERS_FLEXBUFFERS_SSE2)
+    const __m128i group =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(tags));
+    return static_cast<uint32_t>(_mm_movemask_epi8(
+        _mm_cmpeq_epi8(group, _mm_set1_epi8(static_cast<char>(tag)))));
+  #elif defined(FLATBUFFERS_FLEXBUFFERS_NEON)
+    static const uint8_t kBits[16] = { 1, 2, 4, 8, 16, 32, 64, 128,
+                                       1, 2, 4, 8, 16, 32, 64, 128 };
+    const uint8x16_t bits = vandq_u8(vceqq_u8(vld1q_u8(tags), vdupq_n_u8(tag)),
+                                     vld1q_u8(kBits));
+    return static_cast<uint32_t>(vaddv_u8(vget_low_u8(bits))) |
+           static_cast<uint32_t>(vaddv_u8(vget_high_u8(bits))) << 8;
+  #else
+    uint32_t mask = 0;
+    for (uint32_t i = 0; i < 16; i++) {
+      mask |= static_cast<uint32_t>(tags[i] == tag) << i;
+    }
+    return mask;
+  #endif
+  // clang-format on
+}
+
+inline uint32_t LowestBitIndex(uint32_t mask) {
+  // clang-format off
+  #if defined(__GNUC__) || defined(__clang__)
+    return static_cast<uint32_t>(__builtin_ctz(mask));
+  #else
+    uint32_t i = 0;
+    while (!(mask & 1)) {
+      mask >>= 1;
+      i++;
+    }
+    return i;
+  #endif
+  // clang-format on
+}
+
 template<typename T>
 void AppendToString(std::string &s, T &&v, bool keys_quoted) {
   s += "[ ";
@@ -859,8 +986,57 @@ template<typename T> int KeyCompare(const void *key, const void *elem) {
   return strcmp(skey, str_elem);
 }
 
+inline bool Map::FindHashedKey(const TypedVector &keys, const char *key,
+                               size_t *index) const {
+  const size_t num_keys = keys.size();
+  if (!(KeysWidthField() & kMapKeyHashesFlag) ||
+      num_keys < kMinHashedMapSize || num_keys > kMaxHashedMapSize) {
+    return false;
+  }
+  // The table ends where the fields before the map start, and must fit
+  // between them and the end of the keys vector.
+  const size_t num_prefixed_fields = 3;
+  const uint8_t *end = data_ - byte_width_ * num_prefixed_fields;
+  const uint8_t *keys_end = keys.data_ + num_keys * keys.byte_width_;
+  const size_t table_size = KeyHashesSize(num_keys);
+  if (end < keys_end || static_cast<size_t>(end - keys_end) < table_size ||
+      flatbuffers::ReadScalar<uint32_t>(end - 4) != kMapKeyHashesMagic ||
+      flatbuffers::ReadScalar<uint32_t>(end - 8) != num_keys) {
+    return false;
+  }
+  const size_t groups = KeyHashGroups(num_keys);
+  const uint8_t *tags = end - table_size;
+  const uint8_t *indices = tags + 16 * groups;
+  const uint64_t hash = KeyHash(key, strlen(key));
+  const uint8_t tag = KeyHashTag(hash);
+  size_t group = static_cast<size_t>(hash) & (groups - 1);
+  for (size_t probes = 0; probes < groups; probes++) {
+    const uint8_t *group_tags = tags + 16 * group;
+    for (uint32_t mask = MatchKeyHashTags(group_tags, tag); mask;
+         mask &= mask - 1) {
+      const size_t slot = 16 * group + LowestBitIndex(mask);
+      const size_t i = flatbuffers::ReadScalar<uint16_t>(indices + 2 * slot);
+      if (i < num_keys &&
+          !strcmp(key, reinterpret_cast<const char *>(Indirect(
+                           keys.data_ + i * keys.byte_width_,
+                           keys.byte_width_)))) {
+        *index = i;
+        return true;
+      }
+    }
+    if (MatchKeyHashTags(group_tags, 0)) break;
+    group = (group + 1) & (groups - 1);
+  }
+  *index = num_keys;
+  return true;
+}
+
 inline Reference Map::operator[](const char *key) const {
   auto keys = Keys();
+  size_t index;
+  if (FindHashedKey(keys, key, &index)) {
+    return (*static_cast<const Vector *>(this))[index];
+  }
   // We can't pass keys.byte_width_ to the comparison function, so we have
   // to pick the right one ahead of time.
   int (*comp)(const void *, const void *) = nullptr;
@@ -912,6 +1088,10 @@ enum BuilderFlag {
   BUILDER_FLAG_SHARE_KEYS_AND_STRINGS = 3,
   BUILDER_FLAG_SHARE_KEY_VECTORS = 4,
   BUILDER_FLAG_SHARE_ALL = 7,
+  // Store a hash table of the keys of maps with many keys, which speeds up
+  // Map::operator[] at the cost of about 3 bytes per key. Only readers that
+  // know about these tables can read such maps.
+  BUILDER_FLAG_MAP_KEY_HASHES = 8,
 };
 
 class Builder FLATBUFFERS_FINAL_CLASS {
@@ -948,10 +1128,13 @@ class Builder FLATBUFFERS_FINAL_CLASS {
     buf_.clear();
     stack_.clear();
     finished_ = false;
+    has_duplicate_keys_ = false;
     // flags_ remains as-is;
     force_min_bit_width_ = BIT_WIDTH_8;
     key_pool.clear();
     string_pool.clear();
+    key_vector_pool.clear();
+    unsorted_keys_.clear();
   }
 
   // All value constructing functions below have two versions: one that
@@ -1039,6 +1222,7 @@ class Builder FLATBUFFERS_FINAL_CLASS {
       }
     }
     stack_.push_back(Value(static_cast<uint64_t>(sloc), FBT_KEY, BIT_WIDTH_8));
+    TrackKeyOrder();
     return sloc;
   }
 
@@ -1120,6 +1304,7 @@ class Builder FLATBUFFERS_FINAL_CLASS {
   size_t EndVector(size_t start, bool typed, bool fixed) {
     auto vec = CreateVector(start, stack_.size() - start, 1, typed, fixed);
     // Remove temp elements and return vector.
+    PopUnsortedKeys(start);
     stack_.resize(start);
     stack_.push_back(vec);
     return static_cast<size_t>(vec.u_);
@@ -1135,48 +1320,19 @@ class Builder FLATBUFFERS_FINAL_CLASS {
     for (auto key = start; key < stack_.size(); key += 2) {
       FLATBUFFERS_ASSERT(stack_[key].type_ == FBT_KEY);
     }
-    // Now sort values, so later we can do a binary search lookup.
-    // We want to sort 2 array elements at a time.
-    struct TwoValue {
-      Value key;
-      Value val;
-    };
-    // TODO(wvo): strict aliasing?
-    // TODO(wvo): allow the caller to indicate the data is already sorted
-    // for maximum efficiency? With an assert to check sortedness to make sure
-    // we're not breaking binary search.
-    // Or, we can track if the map is sorted as keys are added which would be
-    // be quite cheap (cheaper than checking it here), so we can skip this
-    // step automatically when appliccable, and encourage people to write in
-    // sorted fashion.
-    // std::sort is typically already a lot faster on sorted data though.
-    auto dict = reinterpret_cast<TwoValue *>(stack_.data() + start);
-    std::sort(
-        dict, dict + len, [&](const TwoValue &a, const TwoValue &b) -> bool {
-          auto as = reinterpret_cast<const char *>(buf_.data() + a.key.u_);
-          auto bs = reinterpret_cast<const char *>(buf_.data() + b.key.u_);
-          auto comp = strcmp(as, bs);
-          // We want to disallow duplicate keys, since this results in a
-          // map where values cannot be found.
-          // But we can't assert here (since we don't want to fail on
-          // random JSON input) or have an error mechanism.
-          // Instead, we set has_duplicate_keys_ in the builder to
-          // signal this.
-          // TODO: Have to check for pointer equality, as some sort
-          // implementation apparently call this function with the same
-          // element?? Why?
-          if (!comp && &a != &b) has_duplicate_keys_ = true;
-          return comp < 0;
-        });
-    // First create a vector out of all keys.
-    // TODO(wvo): if kBuilderFlagShareKeyVectors is true, see if we can share
-    // the first vector.
-    auto keys = CreateVector(start, len, 2, true, false);
-    auto vec = CreateVector(start + 1, len, 2, false, false, &keys);
-    // Remove temp elements and return map.
-    stack_.resize(start);
-    stack_.push_back(vec);
-    return static_cast<size_t>(vec.u_);
+    // Keys added in strictly ascending order need no sorting, and can't have
+    // duplicates. The order of the first key doesn't matter.
+    if (!KeysInOrder(start)) SortMap(start, len);
+    PopUnsortedKeys(start);
+    return FinishMap(start, len);
+  }
+
+  // Same as EndMap(), for maps whose keys the caller adds in strictly
+  // ascending strcmp() order, e.g. in a canonical order. Asserts that they
+  // were.
+  size_t EndSortedMap(size_t start) {
+    FLATBUFFERS_ASSERT(KeysInOrder(start));
+    return EndMap(start);
   }
 
   // Call this after EndMap to see if the map had any duplicate keys.
@@ -1281,6 +1437,16 @@ class Builder FLATBUFFERS_FINAL_CLASS {
     f(state);
     return EndMap(start);
   }
+  template<typename F> size_t SortedMap(F f) {
+    auto start = StartMap();
+    f();
+    return EndSortedMap(start);
+  }
+  template<typename F> size_t SortedMap(const char *key, F f) {
+    auto start = StartMap(key);
+    f();
+    return EndSortedMap(start);
+  }
   template<typename T> void Map(const std::map<std::string, T> &map) {
     auto start = StartMap();
     for (auto it = map.begin(); it != map.end(); ++it)
@@ -1300,7 +1466,10 @@ class Builder FLATBUFFERS_FINAL_CLASS {
   // Works on any data type.
   struct Value;
   Value LastValue() { return stack_.back(); }
-  void ReuseValue(Value v) { stack_.push_back(v); }
+  void ReuseValue(Value v) {
+    stack_.push_back(v);
+    if (v.type_ == FBT_KEY) TrackKeyOrder();
+  }
   void ReuseValue(const char *key, Value v) {
     Key(key);
     ReuseValue(v);
@@ -1404,6 +1573,143 @@ class Builder FLATBUFFERS_FINAL_CLASS {
     Write(reloff, byte_width);
   }
 
+  // Sorts the `len` key/value pairs of a map from `start` on the stack by
+  // key, so later we can do a binary search lookup.
+  void SortMap(size_t start, size_t len) {
+    // We want to sort 2 array elements at a time.
+    struct TwoValue {
+      Value key;
+      Value val;
+    };
+    // TODO(wvo): strict aliasing?
+    auto dict = reinterpret_cast<TwoValue *>(stack_.data() + start);
+    std::sort(
+        dict, dict + len, [&](const TwoValue &a, const TwoValue &b) -> bool {
+          auto as = reinterpret_cast<const char *>(buf_.data() + a.key.u_);
+          auto bs = reinterpret_cast<const char *>(buf_.data() + b.key.u_);
+          auto comp = strcmp(as, bs);
+          // We want to disallow duplicate keys, since this results in a
+          // map where values cannot be found.
+          // But we can't assert here (since we don't want to fail on
+          // random JSON input) or have an error mechanism.
+          // Instead, we set has_duplicate_keys_ in the builder to
+          // signal this.
+          // TODO: Have to check for pointer equality, as some sort
+          // implementation apparently call this function with the same
+          // element?? Why?
+          if (!comp && &a != &b) has_duplicate_keys_ = true;
+          return comp < 0;
+        });
+  }
+
+  size_t FinishMap(size_t start, size_t len) {
+    // First create a vector out of all keys, or find an identical one.
+    Value keys;
+    if (!(flags_ & BUILDER_FLAG_SHARE_KEY_VECTORS)) {
+      keys = CreateVector(start, len, 2, true, false);
+    } else if (!FindKeyVector(start, len, &keys)) {
+      keys = CreateVector(start, len, 2, true, false);
+      key_vector_pool.insert(std::make_pair(HashKeyOffsets(start, len), keys));
+    }
+    const bool key_hashes = (flags_ & BUILDER_FLAG_MAP_KEY_HASHES) &&
+                            len >= kMinHashedMapSize &&
+                            len <= kMaxHashedMapSize;
+    if (key_hashes) WriteKeyHashes(start, len);
+    auto vec =
+        CreateVector(start + 1, len, 2, false, false, &keys, key_hashes);
+    // Remove temp elements and return map.
+    stack_.resize(start);
+    stack_.push_back(vec);
+    return static_cast<size_t>(vec.u_);
+  }
+
+  // Records the key just pushed if it doesn't come after the entry two
+  // places before it, which is the previous key if both are in the same map.
+  void TrackKeyOrder() {
+    const size_t i = stack_.size() - 1;
+    if (i < 2 || stack_[i - 2].type_ != FBT_KEY ||
+        strcmp(reinterpret_cast<const char *>(buf_.data() + stack_[i - 2].u_),
+               reinterpret_cast<const char *>(buf_.data() + stack_[i].u_)) <
+            0) {
+      return;
+    }
+    unsorted_keys_.push_back(i);
+  }
+
+  // Hashes the offsets of the `len` keys of a map from `start` on the stack.
+  uint64_t HashKeyOffsets(size_t start, size_t len) const {
+    uint64_t hash = len;
+    for (size_t i = 0; i < len; i++) {
+      hash = (hash ^ stack_[start + 2 * i].u_) * 0x9E3779B97F4A7C15ULL;
+      hash ^= hash >> 32;
+    }
+    return hash;
+  }
+
+  // Looks for a keys vector written before with the same `len` keys (by
+  // offset, which makes them the same with BUILDER_FLAG_SHARE_KEYS) as the
+  // map from `start` on the stack.
+  bool FindKeyVector(size_t start, size_t len, Value *keys) const {
+    auto range = key_vector_pool.equal_range(HashKeyOffsets(start, len));
+    for (auto it = range.first; it != range.second; ++it) {
+      const auto &vec = it->second;
+      const size_t byte_width = size_t(1) << vec.min_bit_width_;
+      const uint8_t *elems = buf_.data() + vec.u_;
+      if (ReadUInt64(elems - byte_width, static_cast<uint8_t>(byte_width)) !=
+          len) {
+        continue;
+      }
+      size_t i = 0;
+      for (; i < len; i++) {
+        const uint8_t *key = Indirect(elems + i * byte_width,
+                                      static_cast<uint8_t>(byte_width));
+        if (key != buf_.data() + stack_[start + 2 * i].u_) break;
+      }
+      if (i == len) {
+        *keys = vec;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Whether the keys of the map from `start` on the stack were all added
+  // after a smaller one.
+  bool KeysInOrder(size_t start) const {
+    return unsorted_keys_.empty() || unsorted_keys_.back() <= start;
+  }
+
+  // Forgets the keys from `start` on the stack, which are about to be
+  // removed.
+  void PopUnsortedKeys(size_t start) {
+    while (!unsorted_keys_.empty() && unsorted_keys_.back() >= start) {
+      unsorted_keys_.pop_back();
+    }
+  }
+
+  // Writes the hash table of the `len` (sorted) keys of a map from `start` on
+  // the stack. Since it is 8-byte aligned and sized, the map follows it
+  // without padding.
+  void WriteKeyHashes(size_t start, size_t len) {
+    const size_t num_slots = KeyHashGroups(len) * 16;
+    std::vector<uint8_t> tags(num_slots, 0);
+    std::vector<uint16_t> indices(num_slots, 0);
+    for (size_t i = 0; i < len; i++) {
+      auto key = reinterpret_cast<const char *>(buf_.data() +
+                                                stack_[start + 2 * i].u_);
+      const uint64_t hash = KeyHash(key, strlen(key));
+      size_t slot = (static_cast<size_t>(hash) * 16) & (num_slots - 1);
+      while (tags[slot]) slot = (slot + 1) & (num_slots - 1);
+      tags[slot] = KeyHashTag(hash);
+      indices[slot] = static_cast<uint16_t>(i);
+    }
+    Align(BIT_WIDTH_64);
+    WriteBytes(tags.data(), tags.size());
+    for (auto index : indices) Write(index, sizeof(index));
+    Write(static_cast<uint32_t>(len), sizeof(uint32_t));
+    Write(kMapKeyHashesMagic, sizeof(uint32_t));
+  }
+
   template<typename T> void PushIndirect(T val, Type type, BitWidth bit_width) {
     auto byte_width = Align(bit_width);
     auto iloc = buf_.size();
@@ -1549,7 +1855,8 @@ class Builder FLATBUFFERS_FINAL_CLASS {
   }
 
   Value CreateVector(size_t start, size_t vec_len, size_t step, bool typed,
-                     bool fixed, const Value *keys = nullptr) {
+                     bool fixed, const Value *keys = nullptr,
+                     bool key_hashes = false) {
     FLATBUFFERS_ASSERT(
         !fixed ||
         typed);  // typed=false, fixed=true combination is not supported.
@@ -1585,7 +1892,9 @@ class Builder FLATBUFFERS_FINAL_CLASS {
     // Write vector. First the keys width/offset if available, and size.
     if (keys) {
       WriteOffset(keys->u_, byte_width);
-      Write<uint64_t>(1ULL << keys->min_bit_width_, byte_width);
+      Write<uint64_t>((1ULL << keys->min_bit_width_) |
+                          (key_hashes ? kMapKeyHashesFlag : 0),
+                      byte_width);
     }
     if (!fixed) Write<uint64_t>(vec_len, byte_width);
     // Then the actual data.
@@ -1648,6 +1957,12 @@ class Builder FLATBUFFERS_FINAL_CLASS {
 
   KeyOffsetMap key_pool;
   StringOffsetMap string_pool;
+  // Keys vectors written so far, by HashKeyOffsets().
+  std::multimap<uint64_t, Value> key_vector_pool;
+
+  // Stack positions of the keys of unfinished maps that weren't added in
+  // order, in ascending order.
+  std::vector<size_t> unsorted_keys_;
 
   friend class Verifier;
 };
@@ -1777,8 +2092,8 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
     p -= byte_width * num_prefixed_fields;
     auto off = ReadUInt64(p, byte_width);
     if (!VerifyOffset(off, p)) return false;
-    auto key_byte_with =
-        static_cast<uint8_t>(ReadUInt64(p + byte_width, byte_width));
+    auto key_byte_with = static_cast<uint8_t>(
+        ReadUInt64(p + byte_width, byte_width) & ~kMapKeyHashesFlag);
     if (!VerifyByteWidth(key_byte_with)) return false;
     return VerifyVector(Reference(p, byte_width, key_byte_with, FBT_VECTOR_KEY),
                         p - off, FBT_KEY);
@@ -0,0 +1,344 @@
+/*
+ * Copyright 2021 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLATBUFFERS_HASH_INDEX_H_
+#define FLATBUFFERS_HASH_INDEX_H_
+
+#include <algorithm>
+#include <vector>
+
+#include "flatbuffers/base.h"
+#include "flatbuffers/flatbuffer_builder.h"
+#include "flatbuffers/string.h"
+#include "flatbuffers/vector.h"
+#include "flatbuffers/verifier.h"
+
+// A hash index is a minimal perfect hash function over the keys of a vector
+// of tables, stored next to it in the buffer as a `[uint]` field, declared
+// with the `hash_index` attribute:
+//
+//   table Dictionary {
+//     entries:[Entry] (hash_index: "entries_index");
+//     entries_index:[uint];
+//   }
+//
+// It maps each distinct key to its own slot, which holds the position of the
+// key in the indexed vector, so a lookup hashes the key and compares it with a
+// single element, instead of log2(n) of them.
+// The hash is CHD ("hash, displace and compress", minus the compression):
+// keys are spread over buckets of about 2, and every bucket stores the
+// displacement that sends its keys to free slots, or, for buckets with a
+// single key, the slot itself, with the top bit set. The layout of the index
+// is:
+//
+//   [0]                 seed of the key hash
+//   [1]                 number of buckets B
+//   [2, 2 + B)          displacement of each bucket
+//   [2 + B, 2 + B + N)  position in the indexed vector of the key in each
+//                       of the N slots, one per distinct key
+//
+// The index only speeds up lookups. Keys not in the vector still map to some
+// slot, and are rejected by comparing them with its element, so a stale or
+// corrupted index makes lookups miss, but never read out of bounds once the
+// buffer is verified. Readers that don't know about the index ignore it.
+
+namespace flatbuffers {
+
+namespace hash_index_internal {
+
+static const uint64_t kMul = 0x9E3779B97F4A7C15ULL;
+
+// The finalizer of MurmurHash3, a bijection that mixes all bits.
+inline uint64_t Mix(uint64_t h) {
+  h = (h ^ (h >> 33)) * 0xFF51AFD7ED558CCDULL;
+  h = (h ^ (h >> 33)) * 0xC4CEB9FE1A85EC53ULL;
+  return h ^ (h >> 33);
+}
+
+inline uint64_t HashBytes(const uint8_t *p, size_t len, uint64_t seed) {
+  uint64_t h = Mix(seed + len * kMul);
+  for (; len >= 8; p += 8, len -= 8) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    h = Mix(h ^ EndianScalar(v)) * kMul;
+  }
+  uint64_t v = 0;
+  for (size_t i = 0; i < len; i++) v |= static_cast<uint64_t>(p[i]) << (8 * i);
+  return Mix(h ^ v);
+}
+
+// Hashes a key of type KeyType, the type returned by the key accessor.
+template<typename KeyType> struct KeyHasher {
+  static uint64_t Hash(KeyType key, uint64_t seed) {
+    // -0.0 equals 0.0, so it has to hash the same.
+    if (key == 0) key = 0;
+    key = EndianScalar(key);
+    return HashBytes(reinterpret_cast<const uint8_t *>(&key), sizeof(key),
+                     seed);
+  }
+};
+
+template<> struct KeyHasher<const String *> {
+  static uint64_t Hash(const String *key, uint64_t seed) {
+    return HashBytes(key->Data(), key->size(), seed);
+  }
+  static uint64_t Hash(const char *key, uint64_t seed) {
+    return HashBytes(reinterpret_cast<const uint8_t *>(key), strlen(key),
+                     seed);
+  }
+};
+
+// Hashes `key` as the key type of T, given by `T::HashIndexKey()`.
+template<typename T, typename KeyType, typename K>
+uint64_t HashKey(KeyType (T::*)() const, K key, uint64_t seed) {
+  return KeyHasher<KeyType>::Hash(key, seed);
+}
+
+template<typename T> uint64_t HashElement(const T *elem, uint64_t seed) {
+  return HashKey(&T::HashIndexKey, elem->HashIndexKey(), seed);
+}
+
+inline uint32_t Bucket(uint64_t h, uint32_t num_buckets) {
+  return static_cast<uint32_t>(((h >> 32) * num_buckets) >> 32);
+}
+
+// Marks a displacement that is the slot of the only key of its bucket.
+static const uint32_t kDirectSlot = 0x80000000;
+
+// The slots a key tries for the displacements 0, 1, 2... start at a value
+// taken from its hash, and advance by a step taken from it, so each try only
+// costs a multiply-add.
+struct Probe {
+  explicit Probe(uint64_t h)
+      : start(static_cast<uint32_t>(h)),
+        step(static_cast<uint32_t>(Mix(h) >> 32) | 1) {}
+
+  uint32_t Slot(uint32_t displacement, uint32_t num_slots) const {
+    const uint64_t x = static_cast<uint32_t>(start + displacement * step);
+    return static_cast<uint32_t>((x * num_slots) >> 32);
+  }
+
+  uint32_t start;
+  uint32_t step;
+};
+
+inline uint32_t Slot(uint64_t h, uint32_t displacement, uint32_t num_slots) {
+  if (displacement & kDirectSlot) return displacement & ~kDirectSlot;
+  return Probe(h).Slot(displacement, num_slots);
+}
+
+// Gives up on a seed once a bucket needs this many displacements.
+static const uint32_t kMaxDisplacement = 1 << 24;
+static const uint32_t kMaxSeeds = 8;
+
+// Sorts the elements by the bucket of their hash in `hashes`: on return, the
+// elements of bucket b are `(*elems)[(*starts)[b]]` up to (excluding)
+// `(*elems)[(*starts)[b + 1]]`, in their order in the vector.
+inline void GroupByBucket(const std::vector<uint64_t> &hashes,
+                          uint32_t num_buckets, std::vector<uint32_t> *starts,
+                          std::vector<uoffset_t> *elems) {
+  starts->assign(num_buckets + 1, 0);
+  for (size_t i = 0; i < hashes.size(); i++) {
+    (*starts)[Bucket(hashes[i], num_buckets) + 1]++;
+  }
+  for (uint32_t b = 0; b < num_buckets; b++) {
+    (*starts)[b + 1] += (*starts)[b];
+  }
+  std::vector<uint32_t> fill(starts->begin(), starts->end() - 1);
+  elems->resize(hashes.size());
+  for (size_t i = 0; i < hashes.size(); i++) {
+    (*elems)[fill[Bucket(hashes[i], num_buckets)]++] =
+        static_cast<uoffset_t>(i);
+  }
+}
+
+// Finds displacements that place the elements grouped by GroupByBucket()
+// into distinct slots, one per element, and fills them into `index`, along
+// with the element in each slot. The elements must have distinct hashes.
+inline bool PlaceKeys(const std::vector<uint64_t> &hashes,
+                      const std::vector<uint32_t> &starts,
+                      const std::vector<uoffset_t> &elems,
+                      std::vector<uint32_t> *index) {
+  const uint32_t num_buckets = static_cast<uint32_t>(starts.size() - 1);
+  const uint32_t num_slots = static_cast<uint32_t>(elems.size());
+  index->assign(2 + num_buckets + num_slots, 0);
+  (*index)[1] = num_buckets;
+  std::vector<Probe> probes(num_slots, Probe(0));
+  for (uint32_t k = 0; k < num_slots; k++) probes[k] = Probe(hashes[elems[k]]);
+  // Handle the largest buckets first, while there is plenty of room.
+  std::vector<std::vector<uint32_t>> by_size;
+  for (uint32_t b = 0; b < num_buckets; b++) {
+    const uint32_t size = starts[b + 1] - starts[b];
+    if (size >= by_size.size()) by_size.resize(size + 1);
+    by_size[size].push_back(b);
+  }
+  std::vector<bool> taken(num_slots, false);
+  std::vector<uint32_t> slots;
+  for (size_t size = by_size.size() - 1; size > 1; size--) {
+    for (auto it = by_size[size].begin(); it != by_size[size].end(); ++it) {
+      const uint32_t b = *it;
+      for (uint32_t d = 0;; d++) {
+        if (d == kMaxDisplacement) return false;
+        slots.clear();
+        for (uint32_t k = starts[b]; k < starts[b + 1]; k++) {
+          const uint32_t slot = probes[k].Slot(d, num_slots);
+          if (taken[slot] ||
+              std::find(slots.begin(), slots.end(), slot) != slots.end()) {
+            break;
+          }
+          slots.push_back(slot);
+        }
+        if (slots.size() != size) continue;
+        (*index)[2 + b] = d;
+        for (uint32_t k = starts[b]; k < starts[b + 1]; k++) {
+          const uint32_t slot = slots[k - starts[b]];
+          taken[slot] = true;
+          (*index)[2 + num_buckets + slot] = elems[k];
+        }
+        break;
+      }
+    }
+  }
+  // Searching a displacement for the last keys would take about as many
+  // tries as there are slots, so store the slot of single keys instead.
+  if (by_size.size() > 1) {
+    uint32_t slot = 0;
+    for (auto it = by_size[1].begin(); it != by_size[1].end(); ++it) {
+      while (taken[slot]) slot++;
+      taken[slot] = true;
+      (*index)[2 + *it] = kDirectSlot | slot;
+      (*index)[2 + num_buckets + slot] = elems[starts[*it]];
+    }
+  }
+  return true;
+}
+
+}  // namespace hash_index_internal
+
+// Builds the hash index of `vec` into `index`. Elements with equal keys share
+// a slot, which refers to the first of them.
+// T must have the method `HashIndexKey()`, which flatc generates for tables
+// indexed with `hash_index`, returning the key.
+// @return Returns false if `vec` is empty, or in the unlikely case that no
+// index was found.
+template<typename T>
+bool BuildHashIndex(const Vector<Offset<T>> *vec,
+                    std::vector<uint32_t> *index) {
+  using namespace hash_index_internal;
+  if (!vec || !vec->size()) return false;
+  // Buckets of about 2 keys, a quarter of which hold a single key.
+  const uint32_t num_buckets = (vec->size() + 1) / 2;
+  std::vector<uint64_t> hashes(vec->size());
+  std::vector<uint32_t> starts;
+  std::vector<uoffset_t> elems;
+  for (uint32_t seed = 0; seed < kMaxSeeds; seed++) {
+    for (uoffset_t i = 0; i < vec->size(); i++) {
+      hashes[i] = HashElement(vec->Get(i), seed);
+    }
+    GroupByBucket(hashes, num_buckets, &starts, &elems);
+    // Drop repeated keys, which are in the same bucket. Distinct keys with
+    // the same hash need another seed.
+    bool collision = false;
+    uint32_t num_elems = 0;
+    for (uint32_t b = 0; b < num_buckets && !collision; b++) {
+      const uint32_t first = num_elems;
+      for (uint32_t k = starts[b]; k < starts[b + 1] && !collision; k++) {
+        const uoffset_t elem = elems[k];
+        bool repeated = false;
+        for (uint32_t j = first; j < num_elems && !repeated && !collision;
+             j++) {
+          if (hashes[elems[j]] != hashes[elem]) continue;
+          const T *x = vec->Get(elems[j]);
+          const T *y = vec->Get(elem);
+          repeated = !x->KeyCompareLessThan(y) && !y->KeyCompareLessThan(x);
+          collision = !repeated;
+        }
+        if (!repeated) elems[num_elems++] = elem;
+      }
+      starts[b] = first;
+    }
+    if (collision) continue;
+    starts[num_buckets] = num_elems;
+    elems.resize(num_elems);
+    if (PlaceKeys(hashes, starts, elems, index)) {
+      (*index)[0] = seed;
+      return true;
+    }
+  }
+  index->clear();
+  return false;
+}
+
+// Builds the hash index of the vector `vec` that was just created with `fbb`,
+// e.g. by `CreateVectorOfSortedTables()`, for the field named by its
+// `hash_index` attribute. The generated `CreateXDirect()` and object API
+// functions call this for you.
+// @return Returns a null offset if `vec` is null or empty, in which case
+// lookups fall back to Vector::LookupByKey().
+template<typename T>
+Offset<Vector<uint32_t>> CreateHashIndex(FlatBufferBuilder &fbb,
+                                         Offset<Vector<Offset<T>>> vec) {
+  std::vector<uint32_t> index;
+  if (vec.IsNull() || !BuildHashIndex(GetTemporaryPointer(fbb, vec), &index)) {
+    return 0;
+  }
+  return fbb.CreateVector(index);
+}
+
+// Finds the element of `vec` with the key `key`, like Vector::LookupByKey(),
+// in constant time with the hash index `index`. Without an index, falls back
+// to Vector::LookupByKey(), so `vec` must be sorted then.
+template<typename T, typename K>
+const T *LookupByHashIndex(const Vector<Offset<T>> *vec,
+                           const Vector<uint32_t> *index, K key) {
+  using namespace hash_index_internal;
+  if (!vec) return nullptr;
+  if (!index || index->size() < 2) return vec->LookupByKey(key);
+  const uint32_t num_buckets = index->Get(1);
+  if (num_buckets == 0 || num_buckets >= index->size() - 2) return nullptr;
+  const uint32_t num_slots = index->size() - 2 - num_buckets;
+  const uint64_t h = HashKey(&T::HashIndexKey, key, index->Get(0));
+  const uint32_t displacement = index->Get(2 + Bucket(h, num_buckets));
+  const uint32_t slot = Slot(h, displacement, num_slots);
+  if (slot >= num_slots) return nullptr;
+  const uint32_t pos = index->Get(2 + num_buckets + slot);
+  if (pos >= vec->size()) return nullptr;
+  const T *elem = vec->Get(pos);
+  return elem->KeyCompareWithValue(key) == 0 ? elem : nullptr;
+}
+
+// Checks that `index` has the layout of a hash index for `vec`, both of which
+// must have been verified as vectors. Only the layout matters for safety, not
+// whether each key ends up in the right slot.
+template<typename T>
+bool VerifyHashIndex(Verifier &verifier, const Vector<Offset<T>> *vec,
+                     const Vector<uint32_t> *index) {
+  if (!index) return true;
+  if (!verifier.Check(index->size() >= 2)) return false;
+  const uint32_t num_buckets = index->Get(1);
+  if (!verifier.Check(num_buckets > 0 && num_buckets < index->size() - 2)) {
+    return false;
+  }
+  const uoffset_t size = vec ? vec->size() : 0;
+  for (uoffset_t i = 2 + num_buckets; i < index->size(); i++) {
+    if (!verifier.Check(index->Get(i) < size)) return false;
+  }
+  return true;
+}
+
+}  // namespace flatbuffers
+
+#endif  // FLATBUFFERS_HASH_INDEX_H_
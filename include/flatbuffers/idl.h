@@ -756,6 +756,7 @@ struct ParserState {
   ParserState()
       : cursor_(nullptr),
         line_start_(nullptr),
+        source_end_(nullptr),
         line_(0),
         token_(-1),
         attr_is_trivial_ascii_string_(true) {}
@@ -763,6 +764,7 @@ struct ParserState {
  protected:
   void ResetState(const char *source) {
     cursor_ = source;
+    source_end_ = source + strlen(source);
     line_ = 0;
     MarkNewLine();
   }
@@ -779,6 +781,7 @@ struct ParserState {
 
   const char *cursor_;
   const char *line_start_;
+  const char *source_end_;  // The terminating '\0'.
   int line_;  // the current line being parsed
   int token_;
 
@@ -865,6 +868,8 @@ class Parser : public ParserState {
     known_attributes_["bit_flags"] = true;
     known_attributes_["original_order"] = true;
     known_attributes_["nested_flatbuffer"] = true;
+    known_attributes_["hash_index"] = true;
+    known_attributes_["key_index"] = true;
     known_attributes_["csharp_partial"] = true;
     known_attributes_["streaming"] = true;
     known_attributes_["idempotent"] = true;
@@ -1039,6 +1044,7 @@ class Parser : public ParserState {
                                       const char **include_paths,
                                       const char *source_filename);
   FLATBUFFERS_CHECKED_ERROR CheckPrivateLeak();
+  FLATBUFFERS_CHECKED_ERROR CheckIndices();
   FLATBUFFERS_CHECKED_ERROR CheckPrivatelyLeakedFields(
       const Definition &def, const Definition &value_type);
   FLATBUFFERS_CHECKED_ERROR DoParse(const char *_source,
@@ -1117,6 +1123,8 @@ class Parser : public ParserState {
 // strict_json adds "quotes" around field names if true.
 // If the flatbuffer cannot be encoded in JSON (e.g., it contains non-UTF-8
 // byte arrays in String values), returns false.
+// The text is appended to `text`. When converting many buffers, clear() and
+// reuse the same string, which keeps its capacity.
 extern bool GenerateTextFromTable(const Parser &parser, const void *table,
                                   const std::string &tablename,
                                   std::string *text);
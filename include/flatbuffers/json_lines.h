@@ -0,0 +1,418 @@
+/*
+ * Copyright 2021 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLATBUFFERS_JSON_LINES_H_
+#define FLATBUFFERS_JSON_LINES_H_
+
+#include <functional>
+#include <string>
+
+#include "flatbuffers/base.h"
+#include "flatbuffers/flexbuffers.h"
+#include "flatbuffers/util.h"
+
+namespace flexbuffers {
+
+// Converts JSON Lines (one JSON value per line, as in log files) to one
+// FlexBuffer per line, without holding more than a line in memory.
+// The input is pushed in chunks of any size with Feed(), e.g. as it is read
+// from a file or socket. Each line is parsed straight from the chunk holding
+// it, only lines that straddle two chunks are copied.
+// The parser is specific to JSON (RFC 8259) and much faster than
+// flatbuffers::Parser::ParseFlexBuffer(), which also accepts the relaxed
+// syntax of schema files. Strings are scanned 16 bytes at a time with SIMD
+// where available (see flexbuffers.h).
+// For small records, a builder with BUILDER_FLAG_NONE is noticeably faster
+// than the default, which pools keys and strings for every record anew.
+//
+// Usage:
+//   flexbuffers::Builder builder;
+//   flexbuffers::JsonLinesParser parser(&builder, [](Builder &b) {
+//     Process(b.GetBuffer());
+//   });
+//   while (ReadChunk(&chunk)) {
+//     if (!parser.Feed(chunk.data(), chunk.size())) Fail(parser.error());
+//   }
+//   if (!parser.Finish()) Fail(parser.error());
+class JsonLinesParser {
+ public:
+  // Called with the builder holding the finished FlexBuffer of each line.
+  // The builder is cleared before the next line.
+  typedef std::function<void(Builder &)> RecordCallback;
+
+  JsonLinesParser(Builder *builder, RecordCallback on_record,
+                  size_t max_depth = 64)
+      : builder_(builder),
+        on_record_(on_record),
+        max_depth_(max_depth),
+        line_(1),
+        records_(0) {}
+
+  // Parses the lines completed by `len` bytes at `data`, and keeps the rest
+  // for the next call.
+  // @return Returns false on malformed input, see error(). Any further
+  // calls fail too.
+  bool Feed(const char *data, size_t len) {
+    if (!error_.empty()) return false;
+    if (!len) return true;
+    const char *end = data + len;
+    if (!partial_.empty()) {
+      auto eol = static_cast<const char *>(memchr(data, '\n', len));
+      if (!eol) {
+        partial_.append(data, len);
+        return true;
+      }
+      partial_.append(data, eol);
+      if (!ParseLine(partial_.data(), partial_.data() + partial_.size())) {
+        return false;
+      }
+      partial_.clear();
+      data = eol + 1;
+    }
+    for (;;) {
+      auto eol = static_cast<const char *>(
+          memchr(data, '\n', static_cast<size_t>(end - data)));
+      if (!eol) break;
+      if (!ParseLine(data, eol)) return false;
+      data = eol + 1;
+    }
+    partial_.assign(data, end);
+    return true;
+  }
+
+  // Parses the last line, if the input didn't end with a newline.
+  bool Finish() {
+    if (!error_.empty()) return false;
+    if (!partial_.empty() &&
+        !ParseLine(partial_.data(), partial_.data() + partial_.size())) {
+      return false;
+    }
+    partial_.clear();
+    return true;
+  }
+
+  // The number of FlexBuffers passed to the callback so far.
+  size_t records() const { return records_; }
+
+  // Describes the first error, with its line number.
+  const std::string &error() const { return error_; }
+
+ private:
+  Builder *builder_;
+  RecordCallback on_record_;
+  size_t max_depth_;
+  size_t line_;
+  size_t records_;
+  // The start of a line that continues in the next chunk.
+  std::string partial_;
+  // The current key or string, unescaped.
+  std::string scratch_;
+  std::string error_;
+
+  static bool IsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+  }
+
+  static const char *SkipSpace(const char *p, const char *end) {
+    while (p < end && IsSpace(*p)) p++;
+    return p;
+  }
+
+  bool Error(const char *message) {
+    if (error_.empty()) {
+      error_ = "line " + flatbuffers::NumToString(line_) + ": " + message;
+    }
+    return false;
+  }
+
+  bool ParseLine(const char *p, const char *end) {
+    p = SkipSpace(p, end);
+    if (p != end) {
+      builder_->Clear();
+      if (!ParseValue(&p, end, 0)) return false;
+      if (SkipSpace(p, end) != end) return Error("trailing characters");
+      builder_->Finish();
+      records_++;
+      on_record_(*builder_);
+    }
+    line_++;
+    return true;
+  }
+
+  bool ParseValue(const char **pp, const char *end, size_t depth) {
+    const char *p = SkipSpace(*pp, end);
+    if (p == end) return Error("value expected");
+    switch (*p) {
+      case '{': {
+        if (depth >= max_depth_) return Error("nesting too deep");
+        const size_t start = builder_->StartMap();
+        p = SkipSpace(p + 1, end);
+        if (p < end && *p == '}') {
+          p++;
+        } else {
+          for (;;) {
+            p = SkipSpace(p, end);
+            if (p == end || *p != '"') return Error("key expected");
+            if (!ParseString(&p, end)) return false;
+            builder_->Key(scratch_);
+            p = SkipSpace(p, end);
+            if (p == end || *p != ':') return Error("':' expected");
+            p++;
+            if (!ParseValue(&p, end, depth + 1)) return false;
+            p = SkipSpace(p, end);
+            if (p < end && *p == ',') {
+              p++;
+            } else if (p < end && *p == '}') {
+              p++;
+              break;
+            } else {
+              return Error("',' or '}' expected");
+            }
+          }
+        }
+        builder_->EndMap(start);
+        if (builder_->HasDuplicateKeys()) return Error("duplicate keys");
+        break;
+      }
+      case '[': {
+        if (depth >= max_depth_) return Error("nesting too deep");
+        const size_t start = builder_->StartVector();
+        p = SkipSpace(p + 1, end);
+        if (p < end && *p == ']') {
+          p++;
+        } else {
+          for (;;) {
+            if (!ParseValue(&p, end, depth + 1)) return false;
+            p = SkipSpace(p, end);
+            if (p < end && *p == ',') {
+              p++;
+            } else if (p < end && *p == ']') {
+              p++;
+              break;
+            } else {
+              return Error("',' or ']' expected");
+            }
+          }
+        }
+        builder_->EndVector(start, false, false);
+        break;
+      }
+      case '"':
+        if (!ParseString(&p, end)) return false;
+        builder_->String(scratch_);
+        break;
+      case 't':
+        if (!ParseLiteral(&p, end, "true")) return false;
+        builder_->Bool(true);
+        break;
+      case 'f':
+        if (!ParseLiteral(&p, end, "false")) return false;
+        builder_->Bool(false);
+        break;
+      case 'n':
+        if (!ParseLiteral(&p, end, "null")) return false;
+        builder_->Null();
+        break;
+      default:
+        if (!ParseNumber(&p, end)) return false;
+    }
+    *pp = p;
+    return true;
+  }
+
+  bool ParseLiteral(const char **pp, const char *end, const char *literal) {
+    const size_t len = strlen(literal);
+    if (static_cast<size_t>(end - *pp) < len || memcmp(*pp, literal, len)) {
+      return Error("unknown literal");
+    }
+    *pp += len;
+    return true;
+  }
+
+  // Parses the string at `*pp` (which starts with a quote) into scratch_.
+  bool ParseString(const char **pp, const char *end) {
+    const char *p = *pp + 1;
+    scratch_.clear();
+    for (;;) {
+      const char *run = p;
+      p += PlainStringBytes(p, end);
+      while (p < end && *p != '"' && *p != '\\' &&
+             static_cast<unsigned char>(*p) >= 0x20) {
+        p++;
+      }
+      scratch_.append(run, p);
+      if (p == end) return Error("unterminated string");
+      if (*p == '"') break;
+      if (*p != '\\') return Error("control character in string");
+      if (++p == end) return Error("unterminated string");
+      switch (*p++) {
+        case '"': scratch_ += '"'; break;
+        case '\\': scratch_ += '\\'; break;
+        case '/': scratch_ += '/'; break;
+        case 'b': scratch_ += '\b'; break;
+        case 'f': scratch_ += '\f'; break;
+        case 'n': scratch_ += '\n'; break;
+        case 'r': scratch_ += '\r'; break;
+        case 't': scratch_ += '\t'; break;
+        case 'u': {
+          uint32_t ucc = 0;
+          if (!ParseHex4(&p, end, &ucc)) return false;
+          if (ucc >= 0xD800 && ucc < 0xDC00) {
+            // A high surrogate, which must be followed by a low one.
+            uint32_t low = 0;
+            if (end - p < 2 || p[0] != '\\' || p[1] != 'u') {
+              return Error("unpaired surrogate");
+            }
+            p += 2;
+            if (!ParseHex4(&p, end, &low)) return false;
+            if (low < 0xDC00 || low >= 0xE000) {
+              return Error("unpaired surrogate");
+            }
+            ucc = 0x10000 + ((ucc - 0xD800) << 10) + (low - 0xDC00);
+          } else if (ucc >= 0xDC00 && ucc < 0xE000) {
+            return Error("unpaired surrogate");
+          }
+          flatbuffers::ToUTF8(ucc, &scratch_);
+          break;
+        }
+        default: return Error("unknown escape");
+      }
+    }
+    *pp = p + 1;
+    return true;
+  }
+
+  bool ParseHex4(const char **pp, const char *end, uint32_t *val) {
+    if (end - *pp < 4) return Error("\\u needs 4 hex digits");
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++) {
+      const char c = (*pp)[i];
+      uint32_t digit;
+      if (c >= '0' && c <= '9') {
+        digit = static_cast<uint32_t>(c - '0');
+      } else if ((c | 0x20) >= 'a' && (c | 0x20) <= 'f') {
+        digit = static_cast<uint32_t>((c | 0x20) - 'a' + 10);
+      } else {
+        return Error("\\u needs 4 hex digits");
+      }
+      v = v * 16 + digit;
+    }
+    *pp += 4;
+    *val = v;
+    return true;
+  }
+
+  // Returns how many of the bytes from `p` on, in whole blocks of 16, need
+  // no special handling in a string: no quote, backslash or control
+  // character.
+  static size_t PlainStringBytes(const char *p, const char *end) {
+    size_t n = 0;
+    // clang-format off
+    #if defined(FLATBUFFERS_FLEXBUFFERS_SSE2)
+      const __m128i quote = _mm_set1_epi8('"');
+      const __m128i backslash = _mm_set1_epi8('\\');
+      const __m128i control = _mm_set1_epi8(0x1F);
+      for (; static_cast<size_t>(end - p) - n >= 16; n += 16) {
+        const __m128i bytes =
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + n));
+        const __m128i special = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, quote),
+                         _mm_cmpeq_epi8(bytes, backslash)),
+            _mm_cmpeq_epi8(_mm_max_epu8(bytes, control), control));
+        const int mask = _mm_movemask_epi8(special);
+        if (mask) return n + LowestBitIndex(static_cast<uint32_t>(mask));
+      }
+    #elif defined(FLATBUFFERS_FLEXBUFFERS_NEON)
+      const uint8x16_t quote = vdupq_n_u8('"');
+      const uint8x16_t backslash = vdupq_n_u8('\\');
+      const uint8x16_t control = vdupq_n_u8(0x20);
+      for (; static_cast<size_t>(end - p) - n >= 16; n += 16) {
+        const uint8x16_t bytes =
+            vld1q_u8(reinterpret_cast<const uint8_t *>(p + n));
+        const uint8x16_t special =
+            vorrq_u8(vorrq_u8(vceqq_u8(bytes, quote),
+                              vceqq_u8(bytes, backslash)),
+                     vcltq_u8(bytes, control));
+        // The caller finds the exact position.
+        if (vmaxvq_u8(special)) return n;
+      }
+    #else
+      (void)p;
+      (void)end;
+    #endif
+    // clang-format on
+    return n;
+  }
+
+  bool ParseNumber(const char **pp, const char *end) {
+    const char *p = *pp;
+    const char *start = p;
+    const bool negative = p < end && *p == '-';
+    if (negative) p++;
+    if (p == end || *p < '0' || *p > '9') return Error("value expected");
+    // Integers are accumulated, others parsed by StringToNumber().
+    uint64_t u = 0;
+    bool overflow = false;
+    if (*p == '0') {
+      p++;
+    } else {
+      for (; p < end && *p >= '0' && *p <= '9'; p++) {
+        const uint64_t digit = static_cast<uint64_t>(*p - '0');
+        overflow |= u > (~0ULL - digit) / 10;
+        u = u * 10 + digit;
+      }
+    }
+    bool fraction = false;
+    if (p < end && *p == '.') {
+      fraction = true;
+      if (++p == end || *p < '0' || *p > '9') return Error("digit expected");
+      while (p < end && *p >= '0' && *p <= '9') p++;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+      fraction = true;
+      if (++p < end && (*p == '+' || *p == '-')) p++;
+      if (p == end || *p < '0' || *p > '9') return Error("digit expected");
+      while (p < end && *p >= '0' && *p <= '9') p++;
+    }
+    *pp = p;
+    if (!fraction && !overflow) {
+      if (!negative && u <= static_cast<uint64_t>(INT64_MAX)) {
+        builder_->Int(static_cast<int64_t>(u));
+        return true;
+      }
+      if (!negative) {
+        builder_->UInt(u);
+        return true;
+      }
+      if (u <= static_cast<uint64_t>(INT64_MAX) + 1) {
+        builder_->Int(static_cast<int64_t>(0 - u));
+        return true;
+      }
+    }
+    // The number isn't null-terminated in the input.
+    scratch_.assign(start, p);
+    double d;
+    if (!flatbuffers::StringToNumber(scratch_.c_str(), &d)) {
+      return Error("number out of range");
+    }
+    builder_->Double(d);
+    return true;
+  }
+};
+
+}  // namespace flexbuffers
+
+#endif  // FLATBUFFERS_JSON_LINES_H_
@@ -0,0 +1,359 @@
+/*
+ * Copyright 2021 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLATBUFFERS_KEY_INDEX_H_
+#define FLATBUFFERS_KEY_INDEX_H_
+
+#include <algorithm>
+#include <vector>
+
+#include "flatbuffers/base.h"
+#include "flatbuffers/flatbuffer_builder.h"
+#include "flatbuffers/string.h"
+#include "flatbuffers/vector.h"
+#include "flatbuffers/verifier.h"
+
+// A key index speeds up LookupByKey() on large sorted vectors of tables, where
+// each probe of the binary search has to follow an offset to a table and its
+// vtable, missing the cache every time.
+// It keeps the prefixes of all keys (see KeyPrefix()) in one array, in
+// Eytzinger order: the root of the implicit search tree first, then both
+// nodes of the next level, and so on. The first levels always stay in cache,
+// and the nodes a few levels further down share a cache line, which is
+// prefetched ahead of time. Only the table with the found prefix is read, to
+// compare the complete key.
+// The index can be stored next to the vector in the buffer as a `[ulong]`
+// field, declared with the `key_index` attribute:
+//
+//   table Inventory {
+//     items:[Item] (key_index: "items_index");
+//     items_index:[ulong];
+//   }
+//
+// or be built after loading a buffer, with MakeKeyIndex(). Either way, its
+// layout for a vector of n elements is:
+//
+//   [0]                       n
+//   [1, 1 + n)                the key prefix of each node, node k at [k]
+//   [1 + n, 1 + n + (n+1)/2)  the position in the vector of each node, two
+//                             per element, the lower 32 bits first
+//
+// The index only speeds up lookups. Positions are checked before they are
+// used, so a stale or corrupted index makes lookups miss, but never read out
+// of bounds once the buffer is verified. Readers that don't know about the
+// index ignore it.
+
+namespace flatbuffers {
+
+namespace key_index_internal {
+
+template<typename T>
+uint64_t ScalarPrefix(T key, std::true_type /*floating point*/,
+                      std::false_type) {
+  double d = static_cast<double>(key);
+  // -0.0 == 0.0, so they need the same prefix.
+  if (d == 0) d = 0;
+  uint64_t bits;
+  memcpy(&bits, &d, sizeof(bits));
+  // Flip negatives entirely, so they order in reverse below the positives.
+  return bits >> 63 ? ~bits : bits | (1ULL << 63);
+}
+
+template<typename T>
+uint64_t ScalarPrefix(T key, std::false_type, std::true_type /*unsigned*/) {
+  return static_cast<uint64_t>(key);
+}
+
+template<typename T>
+uint64_t ScalarPrefix(T key, std::false_type, std::false_type) {
+  return static_cast<uint64_t>(static_cast<int64_t>(key)) ^ (1ULL << 63);
+}
+
+inline uint64_t BytesPrefix(const char *s, size_t len) {
+  uint64_t prefix = 0;
+  for (size_t i = 0; i < 8; i++) {
+    prefix = (prefix << 8) | (i < len ? static_cast<uint8_t>(s[i]) : 0);
+  }
+  return prefix;
+}
+
+// The type keys of type T compare as.
+template<typename T, bool = std::is_enum<T>::value> struct KeyScalar {
+  typedef T type;
+};
+
+template<typename T> struct KeyScalar<T, true> {
+  typedef typename std::underlying_type<T>::type type;
+};
+
+}  // namespace key_index_internal
+
+// Returns 64 bits of a key that order like the keys themselves: if a < b,
+// then KeyPrefix(a) <= KeyPrefix(b), and equal keys have equal prefixes.
+// Scalars map one to one (except for NaN, and -0.0 and 0.0, which are equal),
+// strings to their first 8 bytes.
+template<typename T> uint64_t KeyPrefix(T key) {
+  typedef typename key_index_internal::KeyScalar<T>::type S;
+  return key_index_internal::ScalarPrefix(
+      static_cast<S>(key), typename std::is_floating_point<S>::type(),
+      typename std::is_unsigned<S>::type());
+}
+
+inline uint64_t KeyPrefix(const char *key) {
+  size_t len = 0;
+  while (len < 8 && key[len]) len++;
+  return key_index_internal::BytesPrefix(key, len);
+}
+
+inline uint64_t KeyPrefix(const String *key) {
+  return key_index_internal::BytesPrefix(key->c_str(), key->size());
+}
+
+namespace key_index_internal {
+
+// Smaller vectors fit into the cache anyway.
+static const uoffset_t kMinIndexedSize = 64;
+
+// The number of elements of the index of a vector of `n` elements.
+inline size_t IndexSize(size_t n) { return 1 + n + (n + 1) / 2; }
+
+// The prefix of `key` as a key of type KeyType. Scalars are converted first,
+// like KeyCompareWithValue() does, so e.g. an int literal finds a ushort key.
+template<typename KeyType, typename K>
+uint64_t PrefixAs(K key, std::true_type /*scalar*/) {
+  return KeyPrefix(static_cast<KeyType>(key));
+}
+
+template<typename KeyType, typename K>
+uint64_t PrefixAs(K key, std::false_type) {
+  return KeyPrefix(key);
+}
+
+template<typename KeyType, typename K> uint64_t PrefixAs(K key) {
+  return PrefixAs<KeyType>(
+      key, std::integral_constant<bool, std::is_arithmetic<KeyType>::value ||
+                                            std::is_enum<KeyType>::value>());
+}
+
+// Fills the subtree at node `k` of `index` with the elements of `vec` from
+// `*rank` on, in order.
+template<typename T, typename KeyType>
+void Build(const Vector<Offset<T>> *vec, KeyType (T::*key)() const, size_t k,
+           uoffset_t *rank, uint64_t *index) {
+  const size_t n = vec->size();
+  if (k > n) return;
+  Build(vec, key, 2 * k, rank, index);
+  index[k] = KeyPrefix((vec->Get(*rank)->*key)());
+  index[1 + n + (k - 1) / 2] |= static_cast<uint64_t>(*rank)
+                                << (32 * ((k - 1) & 1));
+  (*rank)++;
+  Build(vec, key, 2 * k + 1, rank, index);
+}
+
+// Builds the index of `vec` into the IndexSize() elements at `index`, in host
+// byte order.
+template<typename T, typename KeyType>
+void BuildIndex(const Vector<Offset<T>> *vec, KeyType (T::*key)() const,
+                uint64_t *index) {
+  std::fill(index, index + IndexSize(vec->size()), 0);
+  index[0] = vec->size();
+  uoffset_t rank = 0;
+  Build(vec, key, 1, &rank, index);
+}
+
+// Finds `key` from element `rank` of `vec` on, the first with a prefix not
+// smaller than that of `key`. Usually that is the key, or no element has it.
+// Keys with a common prefix are searched with growing steps, then bisection.
+template<typename T, typename K>
+const T *Gallop(const Vector<Offset<T>> *vec, uoffset_t rank, K key) {
+  const uoffset_t size = vec->size();
+  const T *elem = vec->Get(rank);
+  int c = elem->KeyCompareWithValue(key);
+  if (c >= 0) return c ? nullptr : elem;
+  // Keys before `lo` are smaller.
+  uoffset_t lo = rank + 1, hi = lo;
+  for (uoffset_t step = 1;; step *= 2) {
+    if (lo >= size) return nullptr;
+    hi = size - lo > step ? lo + step - 1 : size - 1;
+    elem = vec->Get(hi);
+    c = elem->KeyCompareWithValue(key);
+    if (c >= 0) break;
+    lo = hi + 1;
+  }
+  if (!c) return elem;
+  // The key is in [lo, hi) if anywhere.
+  while (lo < hi) {
+    const uoffset_t mid = lo + (hi - lo) / 2;
+    elem = vec->Get(mid);
+    c = elem->KeyCompareWithValue(key);
+    if (!c) return elem;
+    if (c < 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return nullptr;
+}
+
+// Finds `key` in `vec` with its index at `index`, in little endian, which
+// must be for `vec->size()` elements.
+template<typename KeyType, typename T, typename K>
+const T *Lookup(const Vector<Offset<T>> *vec, const uint64_t *index, K key) {
+  const size_t n = vec->size();
+  const uint64_t prefix = PrefixAs<KeyType>(key);
+  // Descend to a leaf, going right while the node is smaller.
+  size_t k = 1;
+  while (k <= n) {
+    // The 8 nodes three levels down share a cache line. Near the leaves,
+    // prefetch the last node instead, to stay within the array.
+    FLATBUFFERS_PREFETCH(index + (std::min)(8 * k, n));
+    k = 2 * k + (ReadScalar<uint64_t>(index + k) < prefix);
+  }
+  // The last node where we went left has the first prefix not smaller.
+  while (k & 1) k >>= 1;
+  k >>= 1;
+  if (!k) return nullptr;
+  const uint64_t ranks = ReadScalar<uint64_t>(index + 1 + n + (k - 1) / 2);
+  const auto rank = static_cast<uoffset_t>(ranks >> (32 * ((k - 1) & 1)));
+  return rank < n ? Gallop(vec, rank, key) : nullptr;
+}
+
+// Same as Lookup(), taking the key type from the accessor `T::KeyIndexKey()`.
+template<typename T, typename KeyType, typename K>
+const T *Lookup(KeyType (T::*)() const, const Vector<Offset<T>> *vec,
+                const uint64_t *index, K key) {
+  return Lookup<KeyType>(vec, index, key);
+}
+
+}  // namespace key_index_internal
+
+// KeyIndex builds a key index (see above) for a vector in memory, for buffers
+// that don't have one. It costs 12 bytes per element.
+template<typename T, typename KeyType> class KeyIndex {
+ public:
+  // The accessor of the key field of T, e.g. `&Monster::name`.
+  typedef KeyType (T::*KeyAccessor)() const;
+
+  // Indexes `vec`, which must be sorted by the key read with `key`, as built
+  // by CreateVectorOfSortedTables(). Lookups fall back to
+  // Vector::LookupByKey() if `vec` is too small to need the index.
+  KeyIndex(const Vector<Offset<T>> *vec, KeyAccessor key)
+      : vec_(vec), first_(0) {
+    using namespace key_index_internal;
+    if (!vec || vec->size() < kMinIndexedSize) return;
+    // Pad the front so node 8 (the first node of the fourth level) starts a
+    // cache line, which aligns all groups of 8 siblings below it.
+    const size_t line = 64 / sizeof(uint64_t);
+    const size_t size = IndexSize(vec->size());
+    index_.resize(size + line);
+    const auto misalign =
+        (reinterpret_cast<uintptr_t>(index_.data() + line) & 63) /
+        sizeof(uint64_t);
+    first_ = misalign ? line - misalign : 0;
+    uint64_t *index = index_.data() + first_;
+    BuildIndex(vec, key, index);
+    for (size_t i = 0; i < size; i++) index[i] = EndianScalar(index[i]);
+  }
+
+  // Same as Vector::LookupByKey().
+  template<typename K> const T *LookupByKey(K key) const {
+    if (index_.empty()) return vec_ ? vec_->LookupByKey(key) : nullptr;
+    return key_index_internal::Lookup<KeyType>(vec_, index_.data() + first_,
+                                                key);
+  }
+
+  const Vector<Offset<T>> *vector() const { return vec_; }
+
+ private:
+  const Vector<Offset<T>> *vec_;
+  size_t first_;  // Offset of the index into index_.
+  std::vector<uint64_t> index_;
+};
+
+// Builds a KeyIndex for `vec`, sorted by the key read with `key`, e.g.
+// `MakeKeyIndex(monster->testarrayoftables(), &Monster::name)`.
+template<typename T, typename KeyType>
+KeyIndex<T, KeyType> MakeKeyIndex(const Vector<Offset<T>> *vec,
+                                  KeyType (T::*key)() const) {
+  return KeyIndex<T, KeyType>(vec, key);
+}
+
+// Builds the key index of `vec` into `index`.
+// T must have the method `KeyIndexKey()`, which flatc generates for tables
+// indexed with `key_index`, returning the key.
+// @return Returns false, leaving `index` empty, if `vec` is too small to need
+// an index, or not sorted by its key.
+template<typename T>
+bool BuildKeyIndex(const Vector<Offset<T>> *vec,
+                   std::vector<uint64_t> *index) {
+  using namespace key_index_internal;
+  index->clear();
+  if (!vec || vec->size() < kMinIndexedSize) return false;
+  for (uoffset_t i = 1; i < vec->size(); i++) {
+    if (vec->Get(i)->KeyCompareLessThan(vec->Get(i - 1))) return false;
+  }
+  index->resize(IndexSize(vec->size()));
+  BuildIndex(vec, &T::KeyIndexKey, index->data());
+  return true;
+}
+
+// Builds the key index of the vector `vec` that was just created with `fbb`,
+// e.g. by `CreateVectorOfSortedTables()`, for the field named by its
+// `key_index` attribute. The generated `CreateXDirect()` and object API
+// functions call this for you.
+// @return Returns a null offset if BuildKeyIndex() fails, in which case
+// lookups fall back to Vector::LookupByKey().
+template<typename T>
+Offset<Vector<uint64_t>> CreateKeyIndex(FlatBufferBuilder &fbb,
+                                        Offset<Vector<Offset<T>>> vec) {
+  std::vector<uint64_t> index;
+  if (vec.IsNull() || !BuildKeyIndex(GetTemporaryPointer(fbb, vec), &index)) {
+    return 0;
+  }
+  return fbb.CreateVector(index);
+}
+
+// Finds the element of `vec` with the key `key`, like Vector::LookupByKey(),
+// with the key index `index`. Without an index, or with one for a vector of
+// another size, falls back to Vector::LookupByKey().
+template<typename T, typename K>
+const T *LookupByKeyIndex(const Vector<Offset<T>> *vec,
+                          const Vector<uint64_t> *index, K key) {
+  using namespace key_index_internal;
+  if (!vec) return nullptr;
+  if (!index || index->size() != IndexSize(vec->size()) ||
+      index->Get(0) != vec->size()) {
+    return vec->LookupByKey(key);
+  }
+  return Lookup(&T::KeyIndexKey, vec, index->data(), key);
+}
+
+// Checks that `index` has the size of a key index for `vec`, both of which
+// must have been verified as vectors. Lookups check the positions they read,
+// so that is all that matters for safety.
+template<typename T>
+bool VerifyKeyIndex(Verifier &verifier, const Vector<Offset<T>> *vec,
+                    const Vector<uint64_t> *index) {
+  if (!index) return true;
+  const uoffset_t size = vec ? vec->size() : 0;
+  return verifier.Check(index->size() == key_index_internal::IndexSize(size) &&
+                        index->Get(0) == size);
+}
+
+}  // namespace flatbuffers
+
+#endif  // FLATBUFFERS_KEY_INDEX_H_
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2021 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLATBUFFERS_MAPPED_FILE_H_
+#define FLATBUFFERS_MAPPED_FILE_H_
+
+#include <string>
+
+#include "flatbuffers/base.h"
+#include "flatbuffers/buffer.h"
+#include "flatbuffers/verifier.h"
+
+namespace flatbuffers {
+
+// A read-only view of the contents of a file, memory-mapped where the
+// platform supports it, so opening even very large files doesn't copy them.
+// Where it doesn't, or if a custom LoadFileFunction is set, the file is read
+// into memory with LoadFile() instead. The file is unmapped on destruction.
+class MappedFile {
+ public:
+  // Hints about how the contents will be accessed, see Advise().
+  enum Advice {
+    kAdviceNormal,
+    kAdviceSequential,  // Read ahead aggressively, drop pages once read.
+    kAdviceRandom,      // Don't read ahead.
+    kAdviceWillNeed,    // Start reading in the whole file now.
+    kAdviceHugePages,   // Back the mapping with huge pages, if possible.
+  };
+
+  MappedFile()
+      : data_(nullptr),
+        size_(0),
+        mapping_(nullptr),
+        verified_(kNotVerified) {}
+
+  ~MappedFile() { Close(); }
+
+  MappedFile(MappedFile &&other) FLATBUFFERS_NOEXCEPT : MappedFile() {
+    Swap(other);
+  }
+
+  MappedFile &operator=(MappedFile &&other) FLATBUFFERS_NOEXCEPT {
+    MappedFile temp(std::move(other));
+    Swap(temp);
+    return *this;
+  }
+
+  // Maps file "name", replacing what was opened before, returning true if
+  // successful, false otherwise.
+  bool Open(const char *name);
+
+  void Close();
+
+  // Passes a hint on to the OS, returning false if it isn't supported for
+  // this file.
+  bool Advise(Advice advice) const;
+
+  const uint8_t *data() const { return data_; }
+  size_t size() const { return size_; }
+
+  // Whether the contents are mapped rather than read into memory.
+  bool mapped() const { return mapping_ != nullptr; }
+
+  // The root of the FlatBuffer in the file, unverified.
+  template<typename T> const T *GetRoot() const {
+    return flatbuffers::GetRoot<T>(data_);
+  }
+
+  // The root of the FlatBuffer in the file, or nullptr if it doesn't pass
+  // verification with `identifier`. Verifies on first use only, so only ever
+  // use one root type and identifier per file. Files of
+  // FLATBUFFERS_MAX_BUFFER_SIZE or more can't be FlatBuffers, and fail.
+  template<typename T>
+  const T *GetVerifiedRoot(const char *identifier = nullptr) {
+    if (verified_ == kNotVerified) {
+      verified_ = kInvalid;
+      if (size_ < FLATBUFFERS_MAX_BUFFER_SIZE) {
+        Verifier verifier(data_, size_);
+        if (verifier.VerifyBuffer<T>(identifier)) verified_ = kValid;
+      }
+    }
+    return verified_ == kValid ? GetRoot<T>() : nullptr;
+  }
+
+  void Swap(MappedFile &other);
+
+ private:
+  enum Verified { kNotVerified, kValid, kInvalid };
+
+  const uint8_t *data_;
+  size_t size_;
+  void *mapping_;  // Platform specific, nullptr if not mapped.
+  std::string contents_;  // Used if not mapped.
+  Verified verified_;
+
+  // You shouldn't really be copying instances of this class.
+  FLATBUFFERS_DELETE_FUNC(MappedFile(const MappedFile &));
+  FLATBUFFERS_DELETE_FUNC(MappedFile &operator=(const MappedFile &));
+};
+
+// Map file "name" into "file" returning true if successful, false otherwise.
+// Meant for binary files, which are mapped as is.
+inline bool LoadFileMapped(const char *name, MappedFile *file) {
+  return file->Open(name);
+}
+
+}  // namespace flatbuffers
+
+#endif  // FLATBUFFERS_MAPPED_FILE_H_
@@ -0,0 +1,150 @@
+/*
+ * Copyright 2021 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLATBUFFERS_OFFSET_INDEX_H_
+#define FLATBUFFERS_OFFSET_INDEX_H_
+
+#include "flatbuffers/allocator.h"
+#include "flatbuffers/base.h"
+#include "flatbuffers/default_allocator.h"
+
+namespace flatbuffers {
+
+// Hashes `len` bytes at `data`. Not a cryptographic hash, only meant to spread
+// serialized objects (vtables, strings) over the slots of an `OffsetIndex`.
+inline uint32_t HashBytes(const uint8_t *data, size_t len) {
+  const uint64_t kMul = 0x9E3779B97F4A7C15ULL;
+  uint64_t h = len * kMul;
+  while (len >= sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data, sizeof(word));
+    h = (h ^ word) * kMul;
+    h ^= h >> 29;
+    data += sizeof(uint64_t);
+    len -= sizeof(uint64_t);
+  }
+  if (len) {
+    uint64_t word = 0;
+    memcpy(&word, data, len);
+    h = (h ^ word) * kMul;
+  }
+  h ^= h >> 32;
+  return static_cast<uint32_t>(h);
+}
+
+// An open-addressed hash set of offsets into a `vector_downward`, used by
+// `FlatBufferBuilder` to find previously serialized objects in O(1) instead of
+// scanning or walking a tree. Only the hash and the offset are stored, the
+// caller resolves equality against the buffer contents.
+// Memory comes from the given `Allocator` (nullptr means `DefaultAllocator`),
+// so using it does not imply general heap allocation.
+class OffsetIndex {
+ public:
+  explicit OffsetIndex(Allocator *allocator)
+      : allocator_(allocator), slots_(nullptr), capacity_(0), size_(0) {}
+
+  ~OffsetIndex() { clear_buffer(); }
+
+  // Returns the first offset with the given hash for which `eq(offset)` holds,
+  // or 0 if there is none (0 is never a valid object offset).
+  template<typename Eq> uoffset_t find(uint32_t hash, Eq eq) const {
+    if (!size_) return 0;
+    const size_t mask = capacity_ - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+      const Slot &slot = slots_[i];
+      if (!slot.off) return 0;
+      if (slot.hash == hash && eq(slot.off)) return slot.off;
+    }
+  }
+
+  // Records `off` under `hash`. Does not check for duplicates.
+  void insert(uint32_t hash, uoffset_t off) {
+    FLATBUFFERS_ASSERT(off);
+    // Keep the load factor at or below 1/2, so probe sequences stay short.
+    if ((size_ + 1) * 2 > capacity_) grow();
+    insert_slot(hash, off);
+    size_++;
+  }
+
+  // Forgets all offsets, but keeps the allocated slots for reuse.
+  void clear() {
+    if (size_) memset(slots_, 0, capacity_ * sizeof(Slot));
+    size_ = 0;
+  }
+
+  size_t size() const { return size_; }
+
+  void swap(OffsetIndex &other) {
+    using std::swap;
+    swap(allocator_, other.allocator_);
+    swap(slots_, other.slots_);
+    swap(capacity_, other.capacity_);
+    swap(size_, other.size_);
+  }
+
+ private:
+  struct Slot {
+    uint32_t hash;
+    uoffset_t off;  // 0 marks an empty slot.
+  };
+
+  // You shouldn't really be copying instances of this class.
+  FLATBUFFERS_DELETE_FUNC(OffsetIndex(const OffsetIndex &));
+  FLATBUFFERS_DELETE_FUNC(OffsetIndex &operator=(const OffsetIndex &));
+
+  Allocator *allocator_;
+  Slot *slots_;
+  size_t capacity_;  // Always 0 or a power of 2.
+  size_t size_;
+
+  void insert_slot(uint32_t hash, uoffset_t off) {
+    const size_t mask = capacity_ - 1;
+    size_t i = hash & mask;
+    while (slots_[i].off) i = (i + 1) & mask;
+    slots_[i].hash = hash;
+    slots_[i].off = off;
+  }
+
+  void grow() {
+    auto old_slots = slots_;
+    auto old_capacity = capacity_;
+    capacity_ = old_capacity ? old_capacity * 2 : 64;
+    slots_ = reinterpret_cast<Slot *>(
+        Allocate(allocator_, capacity_ * sizeof(Slot)));
+    memset(slots_, 0, capacity_ * sizeof(Slot));
+    for (size_t i = 0; i < old_capacity; i++) {
+      if (old_slots[i].off) insert_slot(old_slots[i].hash, old_slots[i].off);
+    }
+    if (old_slots) {
+      Deallocate(allocator_, reinterpret_cast<uint8_t *>(old_slots),
+                 old_capacity * sizeof(Slot));
+    }
+  }
+
+  void clear_buffer() {
+    if (slots_) {
+      Deallocate(allocator_, reinterpret_cast<uint8_t *>(slots_),
+                 capacity_ * sizeof(Slot));
+    }
+    slots_ = nullptr;
+    capacity_ = 0;
+    size_ = 0;
+  }
+};
+
+}  // namespace flatbuffers
+
+#endif  // FLATBUFFERS_OFFSET_INDEX_H_
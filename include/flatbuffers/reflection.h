@@ -469,6 +469,84 @@ void ResizeVector(const reflection::Schema &schema, uoffset_t newsize, T val,
   }
 }
 
+// Batches many of the above resizes into one. Each SetString() /
+// ResizeAnyVector() call walks the whole buffer and moves everything after the
+// resized item, which gets expensive when changing many items in a big
+// FlatBuffer. A ResizeSession instead queues the changes, then Apply() fixes up
+// all offsets in a single walk of the buffer and moves every byte at most once.
+// Items passed in must live inside "flatbuf", which must not change until
+// Apply(). Each string or vector may be changed at most once per session.
+// Apply() invalidates all pointers into "flatbuf".
+class ResizeSession {
+ public:
+  ResizeSession(const reflection::Schema &schema, std::vector<uint8_t> *flatbuf,
+                const reflection::Object *root_table = nullptr)
+      : schema_(schema), flatbuf_(flatbuf), root_table_(root_table) {}
+
+  // Changes the contents of "str", like SetString() above.
+  void SetString(const std::string &val, const String *str);
+
+  // Resizes "vec", like ResizeAnyVector() above. New elements are set to 0.
+  void ResizeAnyVector(uoffset_t newsize, const VectorOfAny *vec,
+                       uoffset_t num_elems, uoffset_t elem_size);
+
+  // Resizes "vec", like ResizeVector() above. New elements are set to "val".
+  template<typename T>
+  void ResizeVector(uoffset_t newsize, T val, const Vector<T> *vec) {
+    ResizeAnyVector(newsize, reinterpret_cast<const VectorOfAny *>(vec),
+                    vec->size(), static_cast<uoffset_t>(sizeof(T)));
+    auto &fill = edits_.back().contents;
+    fill.resize(sizeof(T));
+    if (flatbuffers::is_scalar<T>::value) {
+      WriteScalar(&fill[0], val);
+    } else {  // struct
+      memcpy(&fill[0], &val, sizeof(T));
+    }
+  }
+
+  // Applies all queued changes to "flatbuf". The session can then be reused.
+  void Apply();
+
+  // Number of changes queued since the last Apply().
+  size_t size() const { return edits_.size(); }
+
+ private:
+  struct Edit {
+    uoffset_t object;     // The string or vector, from the buffer start.
+    uoffset_t point;      // Where bytes are inserted or removed.
+    int delta;            // Bytes inserted (or removed if negative).
+    uoffset_t old_size;   // In elements (chars for strings).
+    uoffset_t new_size;   // Idem.
+    uoffset_t elem_size;  // 1 for strings.
+    bool is_string;
+    // The new string, or one element to fill new vector elements with (empty
+    // means zeroes).
+    std::string contents;
+  };
+
+  uoffset_t NewPos(uoffset_t pos) const;
+  size_t PointsUpTo(uoffset_t pos) const;
+  int64_t Shift(size_t num_points) const {
+    return num_points ? shifts_[num_points - 1] : 0;
+  }
+  template<typename T>
+  void Relocate(uoffset_t first, uoffset_t second, uoffset_t offsetloc,
+                int direction);
+  const uint8_t *RelocateOffset(const uint8_t *offsetloc);
+  void RelocateVTable(const uint8_t *tableloc);
+  void RelocateTable(const reflection::Object &objectdef, const Table *table);
+  const Edit *FindVectorEdit(const uint8_t *vec) const;
+
+  const reflection::Schema &schema_;
+  std::vector<uint8_t> *flatbuf_;
+  const reflection::Object *root_table_;
+  std::vector<Edit> edits_;
+  // Used during Apply() only.
+  std::vector<uoffset_t> points_;
+  std::vector<int64_t> shifts_;  // Total delta up to and including points_[i].
+  std::vector<uint8_t> visited_;
+};
+
 // Adds any new data (in the form of a new FlatBuffer) to an existing
 // FlatBuffer. This can be used when any of the above methods are not
 // sufficient, in particular for adding new tables and new fields.
@@ -497,6 +575,9 @@ inline bool SetFieldT(Table *table, const reflection::Field &field,
 // Note: this does not deal with DAGs correctly. If the table passed forms a
 // DAG, the copy will be a tree instead (with duplicates). Strings can be
 // shared however, by passing true for use_string_pooling.
+// Without string pooling, a table whose subtree sits in one run of bytes, as
+// when it was built in one go, is copied as that run of bytes, DAG and all,
+// with only the offsets to what lies outside it fixed up.
 
 Offset<const Table *> CopyTable(FlatBufferBuilder &fbb,
                                 const reflection::Schema &schema,
@@ -517,6 +598,101 @@ bool VerifySizePrefixed(const reflection::Schema &schema,
                         size_t length, uoffset_t max_depth = 64,
                         uoffset_t max_tables = 1000000);
 
+// ------------------------- CONVERTING -------------------------
+
+// Converts FlatBuffers of one schema into FlatBuffers of another, that the
+// first evolved into, without going through the object API or JSON. Fields
+// of the new schema are filled in from the field of the same name, or else of
+// the same id if that field was renamed. Beyond that, conversion supports:
+// - Scalars widened to a type that holds all their values (e.g. short to int,
+//   int to double), and enums widened or with values renumbered, by name.
+// - Union members reordered or added, matched by name.
+// - Structs whose fields changed as above, or with fields added at the end.
+// - Fields moved into a new sub-table: a table field with no counterpart is
+//   filled in from the fields of the same name that the parent table dropped
+//   or deprecated, if any of them are present (one level deep).
+// Tables, and vectors of them, that did not change are copied with
+// CopyTable() above. Absent fields whose default changed get the old default
+// written out explicitly. Anything else (narrowed scalars, changed arrays, a
+// required field with no counterpart, ...) is reported by error().
+// Enums are only known to be bit_flags in schemas serialized with
+// binary_schema_builtins (flatc --bfbs-builtins), which flatc does for .fbs
+// schemas. In other .bfbs files, moved bit_flags values go unnoticed.
+class SchemaConverter {
+ public:
+  SchemaConverter(const reflection::Schema &from,
+                  const reflection::Schema &to);
+
+  // Empty if buffers of "from" can be converted, otherwise what can't be.
+  const std::string &error() const { return error_; }
+
+  // Converts the root table of a verified buffer of "from", returning its
+  // counterpart in "fbb".
+  Offset<const Table *> ConvertTable(FlatBufferBuilder &fbb,
+                                     const Table &root) const;
+
+  // Converts a whole verified buffer of "from", finishing "fbb" with the file
+  // identifier of "to".
+  void Convert(FlatBufferBuilder &fbb, const uint8_t *buf) const;
+
+ private:
+  struct Planner;
+  struct Context;
+
+  // How one field of "to" is filled in.
+  struct FieldPlan {
+    const reflection::Field *to;
+    const reflection::Field *from;  // Null for a field moved into.
+    // The types fields of unions and of vectors of unions.
+    const reflection::Field *to_type;
+    const reflection::Field *from_type;
+    size_t object;       // The plan for tables and structs (or vectors).
+    size_t union_plan;   // For unions (or vectors).
+    bool default_differs;
+    // The old default, as a value of the new type, if default_differs.
+    uint8_t default_value[8];
+    // Renumbered enum values, as pairs of old and new value sorted by old.
+    std::vector<std::pair<int64_t, int64_t>> enum_values;
+  };
+
+  struct ObjectPlan {
+    const reflection::Object *from;
+    const reflection::Object *to;
+    std::vector<FieldPlan> fields;
+    // Whether "from" and "to" agree on everything, so the data can be copied.
+    bool identical;
+  };
+
+  struct UnionMember {
+    uint8_t type;  // The new type.
+    reflection::BaseType base_type;
+    size_t object;
+  };
+
+  struct UnionPlan {
+    // Indexed by old type, anything beyond is unknown and dropped.
+    std::vector<UnionMember> members;
+    bool identical;
+  };
+
+  uoffset_t ConvertTable(Context &ctx, size_t plan, const Table &table) const;
+  uoffset_t ConvertVector(Context &ctx, const FieldPlan &field,
+                          const Table &table) const;
+  uoffset_t ConvertUnion(Context &ctx, const UnionMember &member,
+                         const void *value) const;
+  void ConvertStruct(size_t plan, const uint8_t *from, uint8_t *to) const;
+  void ConvertScalar(const FieldPlan &field, reflection::BaseType from_type,
+                     const uint8_t *from, reflection::BaseType to_type,
+                     uint8_t *to) const;
+  uoffset_t PushStruct(Context &ctx, size_t plan, const uint8_t *from) const;
+
+  const reflection::Schema &from_;
+  const reflection::Schema &to_;
+  std::vector<ObjectPlan> plans_;
+  std::vector<UnionPlan> unions_;
+  std::string error_;
+};
+
 }  // namespace flatbuffers
 
 #endif  // FLATBUFFERS_REFLECTION_H_
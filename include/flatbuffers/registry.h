@@ -17,6 +17,9 @@
 #ifndef FLATBUFFERS_REGISTRY_H_
 #define FLATBUFFERS_REGISTRY_H_
 
+#include <memory>
+#include <mutex>
+
 #include "flatbuffers/base.h"
 #include "flatbuffers/idl.h"
 
@@ -26,14 +29,51 @@ namespace flatbuffers {
 // Simply pre-populate it with all schema filenames that may be in use, and
 // This class will look them up using the file_identifier declared in the
 // schema.
+// Schemas are parsed once, on first use, and the parsers are kept for later
+// calls. Calls may be made from multiple threads concurrently, each thread
+// then gets a parser of its own, created from the binary form of the schema.
 class Registry {
  public:
+  Registry() : generation_(0) {}
+
   // Call this for all schemas that may be in use. The identifier has
   // a function in the generated code, e.g. MonsterIdentifier().
+  // Binary schemas (.bfbs) are recognized by their extension.
   void Register(const char *file_identifier, const char *schema_path) {
+    std::lock_guard<std::mutex> lock(mutex_);
     Schema schema;
     schema.path_ = schema_path;
-    schemas_[file_identifier] = schema;
+    schemas_[file_identifier] = std::move(schema);
+    generation_++;
+  }
+
+  // Same as Register(), for a binary schema already in memory (e.g. one
+  // embedded with --bfbs-gen-embed), which is loaded right away.
+  // Returns false if it isn't a valid binary schema.
+  bool RegisterBinarySchema(const char *file_identifier, const uint8_t *bfbs,
+                            size_t len) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const IDLOptions opts = opts_;
+    const std::vector<const char *> include_paths = include_paths_;
+    const uint64_t generation = generation_;
+    lock.unlock();
+    Schema schema;
+    schema.bfbs_.assign(reinterpret_cast<const char *>(bfbs), len);
+    std::string error;
+    std::unique_ptr<Parser> parser =
+        CreateParser(opts, include_paths, schema.path_, &schema.bfbs_, &error);
+    lock.lock();
+    if (!parser) {
+      lasterror_ = error;
+      return false;
+    }
+    // Keep the parser only if the options didn't change in the meantime.
+    if (generation == generation_) {
+      schema.idle_parsers_.push_back(std::move(parser));
+    }
+    schemas_[file_identifier] = std::move(schema);
+    generation_++;
+    return true;
   }
 
   // Generate text from an arbitrary FlatBuffer by looking up its
@@ -42,18 +82,18 @@ class Registry {
     // Get the identifier out of the buffer.
     // If the buffer is truncated, exit.
     if (len < sizeof(uoffset_t) + kFileIdentifierLength) {
-      lasterror_ = "buffer truncated";
+      SetLastError("buffer truncated");
       return false;
     }
     std::string ident(
         reinterpret_cast<const char *>(flatbuf) + sizeof(uoffset_t),
         kFileIdentifierLength);
-    // Load and parse the schema.
-    Parser parser;
-    if (!LoadSchema(ident, &parser)) return false;
+    // Get a parser with the schema loaded.
+    ParserLease parser(this, ident);
+    if (!parser) return false;
     // Now we're ready to generate text.
-    if (!GenerateText(parser, flatbuf, dest)) {
-      lasterror_ = "unable to generate text for FlatBuffer binary";
+    if (!GenerateText(*parser, flatbuf, dest)) {
+      SetLastError("unable to generate text for FlatBuffer binary");
       return false;
     }
     return true;
@@ -64,63 +104,205 @@ class Registry {
   // If DetachedBuffer::data() is null then parsing failed.
   DetachedBuffer TextToFlatBuffer(const char *text,
                                   const char *file_identifier) {
-    // Load and parse the schema.
-    Parser parser;
-    if (!LoadSchema(file_identifier, &parser)) return DetachedBuffer();
+    // Get a parser with the schema loaded.
+    ParserLease parser(this, file_identifier);
+    if (!parser) return DetachedBuffer();
     // Parse the text.
-    if (!parser.Parse(text)) {
-      lasterror_ = parser.error_;
+    if (!parser->ParseJson(text)) {
+      SetLastError(parser->error_);
+      // Don't reuse a parser that ran into an error.
+      parser.Discard();
       return DetachedBuffer();
     }
     // We have a valid FlatBuffer. Detach it from the builder and return.
-    return parser.builder_.Release();
+    return parser->builder_.Release();
   }
 
   // Modify any parsing / output options used by the other functions.
-  void SetOptions(const IDLOptions &opts) { opts_ = opts; }
+  void SetOptions(const IDLOptions &opts) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    opts_ = opts;
+    ClearParsers();
+  }
 
   // If schemas used contain include statements, call this function for every
   // directory the parser should search them for.
-  void AddIncludeDirectory(const char *path) { include_paths_.push_back(path); }
+  void AddIncludeDirectory(const char *path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    include_paths_.push_back(path);
+    ClearParsers();
+  }
 
   // Returns a human readable error if any of the above functions fail.
-  const std::string &GetLastError() { return lasterror_; }
+  // With concurrent calls, this is the error of the latest failing call.
+  std::string GetLastError() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lasterror_;
+  }
 
  private:
-  bool LoadSchema(const std::string &ident, Parser *parser) {
+  struct Schema {
+    std::string path_;
+    // The binary schema, loaded from path_, serialized from the parsed
+    // schema at path_, or registered directly if path_ is empty.
+    std::string bfbs_;
+    std::vector<std::unique_ptr<Parser>> idle_parsers_;
+  };
+
+  // Takes a parser for a schema from the registry, and gives it back when
+  // going out of scope.
+  class ParserLease {
+   public:
+    ParserLease(Registry *registry, const std::string &ident)
+        : registry_(registry), ident_(ident) {
+      parser_ = registry_->AcquireParser(ident_, &generation_);
+    }
+
+    ~ParserLease() {
+      if (parser_) registry_->ReleaseParser(ident_, generation_, &parser_);
+    }
+
+    void Discard() { parser_.reset(); }
+
+    explicit operator bool() const { return parser_ != nullptr; }
+    Parser &operator*() const { return *parser_; }
+    Parser *operator->() const { return parser_.get(); }
+
+   private:
+    Registry *registry_;
+    std::string ident_;
+    uint64_t generation_;
+    std::unique_ptr<Parser> parser_;
+  };
+
+  std::mutex mutex_;
+  std::string lasterror_;
+  IDLOptions opts_;
+  std::vector<const char *> include_paths_;
+  std::map<std::string, Schema> schemas_;
+  // Bumped whenever parsers handed out may have become stale.
+  uint64_t generation_;
+
+  void SetLastError(const std::string &error) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    lasterror_ = error;
+  }
+
+  std::unique_ptr<Parser> AcquireParser(const std::string &ident,
+                                        uint64_t *generation) {
+    std::unique_lock<std::mutex> lock(mutex_);
     // Find the schema, if not, exit.
     auto it = schemas_.find(ident);
     if (it == schemas_.end()) {
       // Don't attach the identifier, since it may not be human readable.
       lasterror_ = "identifier for this buffer not in the registry";
-      return false;
+      return nullptr;
     }
     auto &schema = it->second;
-    // Load the schema from disk. If not, exit.
-    std::string schematext;
-    if (!LoadFile(schema.path_.c_str(), false, &schematext)) {
-      lasterror_ = "could not load schema: " + schema.path_;
-      return false;
+    *generation = generation_;
+    if (!schema.idle_parsers_.empty()) {
+      std::unique_ptr<Parser> parser = std::move(schema.idle_parsers_.back());
+      schema.idle_parsers_.pop_back();
+      return parser;
     }
-    // Parse schema.
-    parser->opts = opts_;
-    if (!parser->Parse(schematext.c_str(), include_paths_.data(),
-                       schema.path_.c_str())) {
-      lasterror_ = parser->error_;
-      return false;
+    // Create a new parser from a copy of what it needs, without holding the
+    // lock, so loading or parsing the schema doesn't hold up other calls.
+    const IDLOptions opts = opts_;
+    const std::vector<const char *> include_paths = include_paths_;
+    const std::string path = schema.path_;
+    std::string bfbs = schema.bfbs_;
+    const bool had_bfbs = !bfbs.empty();
+    lock.unlock();
+    std::string error;
+    std::unique_ptr<Parser> parser =
+        CreateParser(opts, include_paths, path, &bfbs, &error);
+    lock.lock();
+    if (!parser) {
+      lasterror_ = error;
+      return nullptr;
     }
-    return true;
+    // Keep the binary schema for the next parsers, unless the schema or
+    // options changed in the meantime. The parser itself is then dropped by
+    // ReleaseParser().
+    if (!had_bfbs && *generation == generation_) {
+      it = schemas_.find(ident);
+      if (it != schemas_.end() && it->second.bfbs_.empty()) {
+        it->second.bfbs_ = std::move(bfbs);
+      }
+    }
+    return parser;
   }
 
-  struct Schema {
-    std::string path_;
-    // TODO(wvo) optionally cache schema file or parsed schema here.
-  };
+  void ReleaseParser(const std::string &ident, uint64_t generation,
+                     std::unique_ptr<Parser> *parser) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Drop parsers for schemas or options that changed in the meantime.
+    if (generation != generation_) return;
+    auto it = schemas_.find(ident);
+    if (it != schemas_.end()) {
+      it->second.idle_parsers_.push_back(std::move(*parser));
+    }
+  }
 
-  std::string lasterror_;
-  IDLOptions opts_;
-  std::vector<const char *> include_paths_;
-  std::map<std::string, Schema> schemas_;
+  // Creates a parser with the binary schema `bfbs` loaded, or if that is
+  // empty, with the schema at `path` loaded, storing its binary form in
+  // `bfbs`. Called without mutex_ held, so it only uses its arguments.
+  static std::unique_ptr<Parser> CreateParser(
+      const IDLOptions &opts, std::vector<const char *> include_paths,
+      const std::string &path, std::string *bfbs, std::string *error) {
+    std::unique_ptr<Parser> parser(new Parser(opts));
+    if (bfbs->empty()) {
+      const bool binary = GetExtension(path) == reflection::SchemaExtension();
+      // Load the schema from disk. If not, exit.
+      std::string schematext;
+      if (!LoadFile(path.c_str(), binary, binary ? bfbs : &schematext)) {
+        *error = "could not load schema: " + path;
+        return nullptr;
+      }
+      if (!binary) {
+        // Parse schema.
+        include_paths.push_back(nullptr);
+        if (!parser->Parse(schematext.c_str(), include_paths.data(),
+                           path.c_str())) {
+          *error = parser->error_;
+          return nullptr;
+        }
+        // Parsers for concurrent calls deserialize the schema instead, which
+        // is a lot faster than parsing it again. Keep builtin attributes such
+        // as bit_flags, so those parsers behave the same as this one.
+        const bool builtins = parser->opts.binary_schema_builtins;
+        parser->opts.binary_schema_builtins = true;
+        parser->Serialize();
+        parser->opts.binary_schema_builtins = builtins;
+        bfbs->assign(
+            reinterpret_cast<const char *>(parser->builder_.GetBufferPointer()),
+            parser->builder_.GetSize());
+        parser->builder_.Clear();
+        return parser;
+      }
+    }
+    if (!parser->Deserialize(reinterpret_cast<const uint8_t *>(bfbs->data()),
+                             bfbs->size())) {
+      *error = "could not load binary schema";
+      if (!path.empty()) *error += ": " + path;
+      return nullptr;
+    }
+    return parser;
+  }
+
+  // Drops all parsers, and what was loaded from files. Called with mutex_
+  // held.
+  void ClearParsers() {
+    for (auto it = schemas_.begin(); it != schemas_.end(); ++it) {
+      it->second.idle_parsers_.clear();
+      if (!it->second.path_.empty()) it->second.bfbs_.clear();
+    }
+    generation_++;
+  }
+
+  // You shouldn't really be copying instances of this class.
+  FLATBUFFERS_DELETE_FUNC(Registry(const Registry &));
+  FLATBUFFERS_DELETE_FUNC(Registry &operator=(const Registry &));
 };
 
 }  // namespace flatbuffers
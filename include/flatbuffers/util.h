@@ -19,6 +19,7 @@
 
 #include <ctype.h>
 #include <errno.h>
+#include <float.h>
 
 #include "flatbuffers/base.h"
 #include "flatbuffers/stl_emulation.h"
@@ -27,7 +28,6 @@
 #  include <iomanip>
 #  include <sstream>
 #else  // FLATBUFFERS_PREFER_PRINTF
-#  include <float.h>
 #  include <stdio.h>
 #endif  // FLATBUFFERS_PREFER_PRINTF
 
@@ -182,6 +182,110 @@ template<> inline std::string NumToString<float>(float t) {
   return FloatToString(t, 6);
 }
 
+// Appends the decimal digits of `u` to `out`, after a minus sign if
+// `negative`.
+inline void AppendDecimal(uint64_t u, bool negative, std::string *out) {
+  char buf[21];
+  char *p = buf + sizeof(buf);
+  do {
+    *--p = static_cast<char>('0' + u % 10);
+    u /= 10;
+  } while (u);
+  if (negative) *--p = '-';
+  out->append(p, buf + sizeof(buf));
+}
+
+// Appends `t` to `out` like FloatToString(t, precision). Unless `t` is huge
+// or not finite, it is rounded here, exactly like printf() would, and not
+// through a stream.
+inline void AppendFloatToString(double t, int precision, std::string *out) {
+  uint64_t bits;
+  memcpy(&bits, &t, sizeof(bits));
+  const int exponent = static_cast<int>((bits >> 52) & 0x7FF);
+  uint64_t mantissa = bits & ((1ULL << 52) - 1);
+  if (exponent == 0x7FF || precision < 1 || precision > 13) {
+    *out += FloatToString(t, precision);
+    return;
+  }
+  // t = mantissa / 2^shift, so the digits to print, t * 10^precision, are
+  // mantissa * 5^precision / 2^(shift - precision), which takes 128 bits.
+  if (exponent) mantissa |= 1ULL << 52;
+  const int shift = (exponent ? 1075 - exponent : 1074) - precision;
+  uint64_t pow5 = 1, pow10 = 1;
+  for (int i = 0; i < precision; i++) {
+    pow5 *= 5;
+    pow10 *= 10;
+  }
+  const uint64_t high_part = (mantissa >> 32) * pow5;
+  const uint64_t lo_part = (mantissa & 0xFFFFFFFF) * pow5;
+  const uint64_t lo = lo_part + (high_part << 32);
+  const uint64_t hi = (high_part >> 32) + (lo < lo_part);
+  uint64_t digits = 0;
+  if (shift <= 0) {
+    if (hi || shift <= -64 || (shift && lo >> (64 + shift))) {
+      *out += FloatToString(t, precision);
+      return;
+    }
+    digits = lo << -shift;
+  } else if (shift < 100) {
+    // The product is below 2^84, so it rounds to 0 for larger shifts.
+    const int k = shift;
+    digits = k < 64 ? (lo >> k) | (hi << (64 - k)) : hi >> (k - 64);
+    if ((k < 64 && hi >> k) || digits >> 63) {
+      *out += FloatToString(t, precision);
+      return;
+    }
+    // Round to nearest, ties to even, on the bits shifted out.
+    const int h = k - 1;
+    const bool half = (h < 64 ? lo >> h : hi >> (h - 64)) & 1;
+    const bool below_half =
+        h < 64 ? (h && lo << (64 - h)) : lo || (h > 64 && hi << (128 - h));
+    if (half && (below_half || (digits & 1))) digits++;
+  }
+  AppendDecimal(digits / pow10, bits >> 63, out);
+  char frac[13];
+  uint64_t rest = digits % pow10;
+  int len = 1;
+  for (int i = precision - 1; i >= 0; i--) {
+    frac[i] = static_cast<char>('0' + rest % 10);
+    rest /= 10;
+    if (frac[i] != '0' && len == 1) len = i + 1;
+  }
+  *out += '.';
+  out->append(frac, static_cast<size_t>(len));
+}
+
+namespace util_internal {
+
+template<typename T>
+void AppendNumToString(T t, std::true_type /*floating point*/,
+                       std::false_type, std::string *out) {
+  AppendFloatToString(t, sizeof(T) == sizeof(float) ? 6 : 12, out);
+}
+
+template<typename T>
+void AppendNumToString(T t, std::false_type, std::true_type /*unsigned*/,
+                       std::string *out) {
+  AppendDecimal(static_cast<uint64_t>(t), false, out);
+}
+
+template<typename T>
+void AppendNumToString(T t, std::false_type, std::false_type,
+                       std::string *out) {
+  const auto i = static_cast<int64_t>(t);
+  AppendDecimal(i < 0 ? 0 - static_cast<uint64_t>(i) : static_cast<uint64_t>(i),
+                i < 0, out);
+}
+
+}  // namespace util_internal
+
+// Appends NumToString(t) to `out`, without the temporary stream and string.
+template<typename T> void AppendNumToString(T t, std::string *out) {
+  util_internal::AppendNumToString(
+      t, typename std::is_floating_point<T>::type(),
+      typename std::is_unsigned<T>::type(), out);
+}
+
 // Convert an integer value to a hexadecimal string.
 // The returned string length is always xdigits long, prefixed by 0 digits.
 // For example, IntToStringHex(0x23, 8) returns the string "00000023".
@@ -265,6 +369,123 @@ inline void strtoval_impl(float *val, const char *str, char **endptr) {
 #undef __strtof_impl
 // clang-format on
 
+namespace util_internal {
+
+// A number like "-12.5e3", as digits * 10^exponent.
+struct DecimalNumber {
+  uint64_t digits;
+  int exponent;
+  bool negative;
+  bool integer;  // Without fraction or exponent.
+};
+
+// Parses a plain decimal number with up to 19 significant digits, which
+// must make up all of `s`. Returns false for anything else (hex, inf, nan,
+// leading spaces, more digits, ...), which is left to strtod() and friends.
+inline bool ParseDecimalNumber(const char *s, DecimalNumber *d) {
+  d->negative = *s == '-';
+  if (*s == '-' || *s == '+') s++;
+  d->digits = 0;
+  d->exponent = 0;
+  int significant = 0, num_digits = 0;
+  for (; is_digit(*s); s++, num_digits++) {
+    if (!d->digits && *s == '0') continue;
+    if (++significant > 19) return false;
+    d->digits = d->digits * 10 + static_cast<uint64_t>(*s - '0');
+  }
+  d->integer = true;
+  if (*s == '.') {
+    d->integer = false;
+    for (s++; is_digit(*s); s++, num_digits++) {
+      d->exponent--;
+      if (!d->digits && *s == '0') continue;
+      if (++significant > 19) return false;
+      d->digits = d->digits * 10 + static_cast<uint64_t>(*s - '0');
+    }
+  }
+  if (!num_digits) return false;
+  if (*s == 'e' || *s == 'E') {
+    d->integer = false;
+    s++;
+    const bool negative_exponent = *s == '-';
+    if (*s == '-' || *s == '+') s++;
+    if (!is_digit(*s)) return false;
+    int exponent = 0;
+    for (; is_digit(*s); s++) {
+      // Large enough to miss the fast path below anyway.
+      if (exponent < 10000) exponent = exponent * 10 + (*s - '0');
+    }
+    d->exponent += negative_exponent ? -exponent : exponent;
+  }
+  return !*s;
+}
+
+// Plain decimal integers that fit into an int64_t.
+inline bool FastStringToInteger(const char *s, int64_t *val) {
+  DecimalNumber d;
+  if (!ParseDecimalNumber(s, &d) || !d.integer ||
+      d.digits > static_cast<uint64_t>(INT64_MAX)) {
+    return false;
+  }
+  const auto i = static_cast<int64_t>(d.digits);
+  *val = d.negative ? -i : i;
+  return true;
+}
+
+// Plain decimal integers without a sign, see StringToNumber<uint64_t>().
+inline bool FastStringToInteger(const char *s, uint64_t *val) {
+  DecimalNumber d;
+  if (*s == '-' || !ParseDecimalNumber(s, &d) || !d.integer) return false;
+  *val = d.digits;
+  return true;
+}
+
+// Decimal numbers whose digits and power of ten are both exact doubles. Then
+// a single multiplication or division rounds the number correctly, the same
+// as strtod() does. This needs floating point math without excess precision.
+inline bool FastStringToFloat(const char *s, double *val) {
+  // clang-format off
+  #if defined(FLT_EVAL_METHOD) && (FLT_EVAL_METHOD == 0 || FLT_EVAL_METHOD == 1)
+    static const double kPowersOf10[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    DecimalNumber d;
+    if (!ParseDecimalNumber(s, &d) || d.digits > (1ULL << 53) ||
+        d.exponent < -22 || d.exponent > 22) {
+      return false;
+    }
+    const auto digits = static_cast<double>(d.digits);
+    const double v = d.exponent < 0 ? digits / kPowersOf10[-d.exponent]
+                                    : digits * kPowersOf10[d.exponent];
+    *val = d.negative ? -v : v;
+    return true;
+  #else
+    (void)s;
+    (void)val;
+    return false;
+  #endif
+  // clang-format on
+}
+
+// Floats are rounded from the correct double, unless that lies halfway
+// between two floats, where rounding twice might differ from strtof().
+inline bool FastStringToFloat(const char *s, float *val) {
+  double d;
+  if (!FastStringToFloat(s, &d)) return false;
+  uint64_t bits;
+  memcpy(&bits, &d, sizeof(bits));
+  const double magnitude = d < 0 ? -d : d;
+  if (d != 0 && (magnitude < FLT_MIN || magnitude > FLT_MAX ||
+                 (bits & 0x1FFFFFFF) == 0x10000000)) {
+    return false;
+  }
+  *val = static_cast<float>(d);
+  return true;
+}
+
+}  // namespace util_internal
+
 // Adaptor for strtoull()/strtoll().
 // Flatbuffers accepts numbers with any count of leading zeros (-009 is -9),
 // while strtoll with base=0 interprets first leading zero as octal prefix.
@@ -283,6 +504,10 @@ inline bool StringToIntegerImpl(T *val, const char *const str,
                                 const bool check_errno = true) {
   // T is int64_t or uint64_T
   FLATBUFFERS_ASSERT(str);
+  if ((base <= 0 || base == 10) &&
+      util_internal::FastStringToInteger(str, val)) {
+    return true;
+  }
   if (base <= 0) {
     auto s = str;
     while (*s && !is_digit(*s)) s++;
@@ -308,6 +533,7 @@ template<typename T>
 inline bool StringToFloatImpl(T *val, const char *const str) {
   // Type T must be either float or double.
   FLATBUFFERS_ASSERT(str && val);
+  if (util_internal::FastStringToFloat(str, val)) return true;
   auto end = str;
   strtoval_impl(val, str, const_cast<char **>(&end));
   auto done = (end != str) && (*end == '\0');
@@ -576,11 +802,51 @@ inline std::string WordWrap(const std::string in, size_t max_length,
 }
 #endif  // !FLATBUFFERS_PREFER_PRINTF
 
+// Returns how many bytes from `s` on are printable ASCII that JSON doesn't
+// escape, i.e. anything from ' ' to '~' but quotes and backslashes. Checks 8
+// bytes at a time.
+inline size_t PlainAsciiBytes(const char *s, size_t length) {
+  const uint64_t ones = 0x0101010101010101ULL;
+  const uint64_t highs = ones * 0x80;
+  size_t n = 0;
+  for (; length - n >= 8; n += 8) {
+    uint64_t x;
+    memcpy(&x, s + n, sizeof(x));
+    const uint64_t quotes = x ^ (ones * '"');
+    const uint64_t backslashes = x ^ (ones * '\\');
+    // Sets a high bit for any byte below ' ', above '~', or equal to a quote
+    // or backslash (these xor to 0).
+    const uint64_t special =
+        (((x - ones * ' ') & ~x) | x | (x + ones) |
+         ((quotes - ones) & ~quotes) | ((backslashes - ones) & ~backslashes)) &
+        highs;
+    if (special) break;
+  }
+  while (n < length && s[n] >= ' ' && s[n] <= '~' && s[n] != '"' &&
+         s[n] != '\\') {
+    n++;
+  }
+  return n;
+}
+
+// Appends `xdigits` uppercase hex digits of `i`, like IntToStringHex().
+inline void AppendHex(uint32_t i, int xdigits, std::string *out) {
+  static const char kHex[] = "0123456789ABCDEF";
+  for (int shift = 4 * (xdigits - 1); shift >= 0; shift -= 4) {
+    *out += kHex[(i >> shift) & 0xF];
+  }
+}
+
 inline bool EscapeString(const char *s, size_t length, std::string *_text,
                          bool allow_non_utf8, bool natural_utf8) {
   std::string &text = *_text;
   text += "\"";
   for (uoffset_t i = 0; i < length; i++) {
+    // Copy the characters up to the next one to escape at once.
+    const auto run = static_cast<uoffset_t>(PlainAsciiBytes(s + i, length - i));
+    text.append(s + i, run);
+    i += run;
+    if (i == length) break;
     char c = s[i];
     switch (c) {
       case '\n': text += "\\n"; break;
@@ -600,7 +866,7 @@ inline bool EscapeString(const char *s, size_t length, std::string *_text,
           if (ucc < 0) {
             if (allow_non_utf8) {
               text += "\\x";
-              text += IntToStringHex(static_cast<uint8_t>(c), 2);
+              AppendHex(static_cast<uint8_t>(c), 2, &text);
             } else {
               // There are two cases here:
               //
@@ -623,7 +889,7 @@ inline bool EscapeString(const char *s, size_t length, std::string *_text,
             } else if (ucc <= 0xFFFF) {
               // Parses as Unicode within JSON's \uXXXX range, so use that.
               text += "\\u";
-              text += IntToStringHex(ucc, 4);
+              AppendHex(static_cast<uint32_t>(ucc), 4, &text);
             } else if (ucc <= 0x10FFFF) {
               // Encode Unicode SMP values to a surrogate pair using two \u
               // escapes.
@@ -631,9 +897,9 @@ inline bool EscapeString(const char *s, size_t length, std::string *_text,
               auto high_surrogate = (base >> 10) + 0xD800;
               auto low_surrogate = (base & 0x03FF) + 0xDC00;
               text += "\\u";
-              text += IntToStringHex(high_surrogate, 4);
+              AppendHex(high_surrogate, 4, &text);
               text += "\\u";
-              text += IntToStringHex(low_surrogate, 4);
+              AppendHex(low_surrogate, 4, &text);
             }
             // Skip past characters recognized.
             i = static_cast<uoffset_t>(utf8 - s - 1);
@@ -271,6 +271,85 @@ template<typename T> class Vector {
     return const_cast<mutable_return_type>(LookupByKey(key));
   }
 
+  // Looks up many keys at once, like calling LookupByKey() for each of
+  // `keys`, writing the results to `out`, which must be at least as large.
+  // Where the vector holds duplicate keys, finds the first of them, where
+  // LookupByKey() may find any.
+  // On vectors too large for the cache (from about 32768 tables), the
+  // searches for a group of keys advance in lockstep, so the memory accesses
+  // of one can overlap with those of the others, instead of each search
+  // waiting for one cache miss at a time. That doesn't pay off on smaller
+  // vectors, which are searched one key at a time.
+  template<typename K>
+  void LookupByKeys(span<K> keys, span<return_type> out) const {
+    FLATBUFFERS_ASSERT(out.size() >= keys.size());
+    if (size() < kMinLockstepSize) {
+      for (size_t i = 0; i < keys.size(); i++) out[i] = FirstByKey(keys[i]);
+      return;
+    }
+    const size_t kGroupSize = 16;
+    const size_t kStride = IndirectHelper<T>::element_stride;
+    uoffset_t base[kGroupSize];
+    return_type elems[kGroupSize];
+    for (size_t first = 0; first < keys.size(); first += kGroupSize) {
+      const size_t n =
+          keys.size() - first < kGroupSize ? keys.size() - first : kGroupSize;
+      const K *group = keys.data() + first;
+      for (size_t i = 0; i < n; i++) base[i] = 0;
+      // Find the last element smaller than each key, or the first element,
+      // keeping the same number of steps for all keys.
+      for (uoffset_t len = size(); len > 1;) {
+        const uoffset_t half = len / 2;
+        for (size_t i = 0; i < n; i++) {
+          FLATBUFFERS_PREFETCH(Data() + (base[i] + half) * kStride);
+        }
+        for (size_t i = 0; i < n; i++) {
+          elems[i] = IndirectHelper<T>::Read(Data(), base[i] + half);
+          FLATBUFFERS_PREFETCH(elems[i]);
+        }
+        for (size_t i = 0; i < n; i++) {
+          if (elems[i]->KeyCompareWithValue(group[i]) < 0) base[i] += half;
+        }
+        len -= half;
+      }
+      for (size_t i = 0; i < n; i++) {
+        out[first + i] = size() ? LowerBoundMatch(base[i], group[i]) : nullptr;
+      }
+    }
+  }
+
+  // Same as LookupByKeys(), for `keys` sorted in the order of the vector.
+  // Each search gallops forward from where the previous one ended, which
+  // takes O(log(distance)) steps, or restarts from the front if a key is
+  // smaller than the previous one.
+  template<typename K>
+  void LookupBySortedKeys(span<K> keys, span<return_type> out) const {
+    FLATBUFFERS_ASSERT(out.size() >= keys.size());
+    // All elements before `lo` are smaller than the previous key.
+    uoffset_t lo = 0;
+    for (size_t k = 0; k < keys.size(); k++) {
+      const K &key = keys[k];
+      if (lo && Compare(lo - 1, key) >= 0) lo = 0;
+      uoffset_t hi = lo;
+      for (uoffset_t step = 1; hi < size() && Compare(hi, key) < 0; step *= 2) {
+        lo = hi + 1;
+        hi = size() - lo > step ? lo + step : size();
+      }
+      // The first element not smaller than the key is in [lo, hi].
+      while (lo < hi) {
+        const uoffset_t mid = lo + (hi - lo) / 2;
+        if (Compare(mid, key) < 0) {
+          lo = mid + 1;
+        } else {
+          hi = mid;
+        }
+      }
+      out[k] = lo < size() && Compare(lo, key) == 0
+                   ? IndirectHelper<T>::Read(Data(), lo)
+                   : nullptr;
+    }
+  }
+
  protected:
   // This class is only used to access pre-existing data. Don't ever
   // try to construct these manually.
@@ -279,11 +358,41 @@ template<typename T> class Vector {
   uoffset_t length_;
 
  private:
+  // LookupByKeys() searches smaller vectors one key at a time.
+  static const uoffset_t kMinLockstepSize = 32 * 1024;
+
   // This class is a pointer. Copying will therefore create an invalid object.
   // Private and unimplemented copy constructor.
   Vector(const Vector &);
   Vector &operator=(const Vector &);
 
+  // Compares element `i` with `key`, like KeyCompareWithValue().
+  template<typename K> int Compare(uoffset_t i, const K &key) const {
+    return IndirectHelper<T>::Read(Data(), i)->KeyCompareWithValue(key);
+  }
+
+  // Same as LookupByKey(), but finds the first of duplicate keys.
+  template<typename K> return_type FirstByKey(const K &key) const {
+    const void *search_result =
+        std::bsearch(&key, Data(), size(), IndirectHelper<T>::element_stride,
+                     KeyCompare<K>);
+    if (!search_result) return nullptr;
+    auto i = static_cast<uoffset_t>(
+        (reinterpret_cast<const uint8_t *>(search_result) - Data()) /
+        IndirectHelper<T>::element_stride);
+    while (i && Compare(i - 1, key) == 0) i--;
+    return IndirectHelper<T>::Read(Data(), i);
+  }
+
+  // Returns the element with `key`, given the last element smaller than it,
+  // or the first element.
+  template<typename K>
+  return_type LowerBoundMatch(uoffset_t i, const K &key) const {
+    int c = Compare(i, key);
+    if (c < 0 && ++i < size()) c = Compare(i, key);
+    return c == 0 ? IndirectHelper<T>::Read(Data(), i) : nullptr;
+  }
+
   template<typename K> static int KeyCompare(const void *ap, const void *bp) {
     const K *key = reinterpret_cast<const K *>(ap);
     const uint8_t *data = reinterpret_cast<const uint8_t *>(bp);
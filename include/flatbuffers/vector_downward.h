@@ -17,6 +17,8 @@
 #ifndef FLATBUFFERS_VECTOR_DOWNWARD_H_
 #define FLATBUFFERS_VECTOR_DOWNWARD_H_
 
+#include <new>
+
 #include "flatbuffers/base.h"
 #include "flatbuffers/default_allocator.h"
 #include "flatbuffers/detached_buffer.h"
@@ -252,18 +254,36 @@ class vector_downward {
     auto old_reserved = reserved_;
     auto old_size = size();
     auto old_scratch_size = scratch_size();
-    reserved_ +=
-        (std::max)(len, old_reserved ? old_reserved / 2 : initial_size_);
-    reserved_ = (reserved_ + buffer_minalign_ - 1) & ~(buffer_minalign_ - 1);
-    if (buf_) {
-      buf_ = ReallocateDownward(allocator_, buf_, old_reserved, reserved_,
-                                old_size, old_scratch_size);
-    } else {
-      buf_ = Allocate(allocator_, reserved_);
-    }
+    auto new_reserved = old_reserved + (std::max)(len, old_reserved
+                                                           ? old_reserved / 2
+                                                           : initial_size_);
+    new_reserved =
+        (new_reserved + buffer_minalign_ - 1) & ~(buffer_minalign_ - 1);
+    uint8_t *new_buf =
+        buf_ ? ReallocateDownward(allocator_, buf_, old_reserved, new_reserved,
+                                  old_size, old_scratch_size)
+             : Allocate(allocator_, new_reserved);
+    if (!new_buf) AllocationFailed();
+    buf_ = new_buf;
+    reserved_ = new_reserved;
     cur_ = buf_ + reserved_ - old_size;
     scratch_ = buf_ + old_scratch_size;
   }
+
+  // Allocators return nullptr when they run out, e.g. VirtualMemoryAllocator
+  // beyond its max_size. The builder has no way to report that, so fail the
+  // way DefaultAllocator does, with std::bad_alloc, or abort if exceptions
+  // are disabled. The old buffer is left in place.
+  static void AllocationFailed() {
+    // clang-format off
+    #if FLATBUFFERS_HAS_EXCEPTIONS
+      throw std::bad_alloc();
+    #else
+      FLATBUFFERS_ASSERT(false);
+      abort();
+    #endif
+    // clang-format on
+  }
 };
 
 }  // namespace flatbuffers
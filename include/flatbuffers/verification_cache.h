@@ -0,0 +1,434 @@
+/*
+ * Copyright 2021 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLATBUFFERS_VERIFICATION_CACHE_H_
+#define FLATBUFFERS_VERIFICATION_CACHE_H_
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include "flatbuffers/base.h"
+#include "flatbuffers/util.h"
+#include "flatbuffers/verifier.h"
+
+// SHA-256 uses the x86 SHA extensions where the baseline instruction set has
+// them, e.g. with -msha -msse4.1 or -march=native. Define FLATBUFFERS_NO_SIMD
+// to always use scalar code.
+// clang-format off
+#if !defined(FLATBUFFERS_NO_SIMD) && defined(__SHA__) && defined(__SSE4_1__)
+  #include <immintrin.h>
+  #define FLATBUFFERS_SHA256_SHANI 1
+#endif
+// clang-format on
+
+namespace flatbuffers {
+
+// SHA-256, as specified in FIPS 180-4. Feed it bytes with Update(), then
+// get the 32-byte digest with Finish().
+class Sha256 {
+ public:
+  static const size_t kDigestSize = 32;
+
+  Sha256() : length_(0), fill_(0) {
+    static const uint32_t kInit[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372,
+                                       0xa54ff53a, 0x510e527f, 0x9b05688c,
+                                       0x1f83d9ab, 0x5be0cd19 };
+    memcpy(state_, kInit, sizeof(state_));
+  }
+
+  void Update(const void *data, size_t len) {
+    auto p = static_cast<const uint8_t *>(data);
+    length_ += len;
+    if (fill_) {
+      const size_t n = (std::min)(len, sizeof(block_) - fill_);
+      memcpy(block_ + fill_, p, n);
+      fill_ += n;
+      p += n;
+      len -= n;
+      if (fill_ < sizeof(block_)) return;
+      Compress(block_, 1);
+      fill_ = 0;
+    }
+    const size_t num_blocks = len / sizeof(block_);
+    if (num_blocks) Compress(p, num_blocks);
+    p += num_blocks * sizeof(block_);
+    len -= num_blocks * sizeof(block_);
+    memcpy(block_, p, len);
+    fill_ = len;
+  }
+
+  // Writes the digest of everything passed to Update() to `digest`. The
+  // object can't be updated any further afterwards.
+  void Finish(uint8_t digest[kDigestSize]) {
+    const uint64_t bits = length_ * 8;
+    block_[fill_++] = 0x80;
+    if (fill_ > sizeof(block_) - 8) {
+      memset(block_ + fill_, 0, sizeof(block_) - fill_);
+      Compress(block_, 1);
+      fill_ = 0;
+    }
+    memset(block_ + fill_, 0, sizeof(block_) - 8 - fill_);
+    for (size_t i = 0; i < 8; i++) {
+      block_[sizeof(block_) - 1 - i] = static_cast<uint8_t>(bits >> (8 * i));
+    }
+    Compress(block_, 1);
+    for (int i = 0; i < 8; i++) {
+      for (int j = 0; j < 4; j++) {
+        digest[4 * i + j] = static_cast<uint8_t>(state_[i] >> (24 - 8 * j));
+      }
+    }
+  }
+
+ private:
+  uint32_t state_[8];
+  uint64_t length_;
+  uint8_t block_[64];
+  size_t fill_;
+
+  static uint32_t Rotr(uint32_t x, int r) { return (x >> r) | (x << (32 - r)); }
+
+  // One round of the compression function, `kw` being the sum of its round
+  // constant and message word.
+  static void Round(uint32_t a, uint32_t b, uint32_t c, uint32_t &d,
+                    uint32_t e, uint32_t f, uint32_t g, uint32_t &h,
+                    uint32_t kw) {
+    h += (Rotr(e, 6) ^ Rotr(e, 11) ^ Rotr(e, 25)) + ((e & f) ^ (~e & g)) + kw;
+    d += h;
+    h += (Rotr(a, 2) ^ Rotr(a, 13) ^ Rotr(a, 22)) +
+         ((a & b) ^ (a & c) ^ (b & c));
+  }
+
+  static const uint32_t *RoundConstants() {
+    static const uint32_t kRound[64] = {
+      0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+      0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+      0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+      0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+      0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+      0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+      0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+      0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+      0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+      0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+      0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    };
+    return kRound;
+  }
+
+  // clang-format off
+  #if defined(FLATBUFFERS_SHA256_SHANI)
+    // Four rounds, for message words `w` and round constants `k`.
+    static void Rounds(__m128i &abef, __m128i &cdgh, __m128i w,
+                       const uint32_t *k) {
+      const __m128i kw = _mm_add_epi32(
+          w, _mm_loadu_si128(reinterpret_cast<const __m128i *>(k)));
+      cdgh = _mm_sha256rnds2_epu32(cdgh, abef, kw);
+      abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(kw, 0x0E));
+    }
+
+    // The next four message words, from the last sixteen, oldest first.
+    static __m128i Schedule(__m128i w0, __m128i w1, __m128i w2, __m128i w3) {
+      return _mm_sha256msg2_epu32(
+          _mm_add_epi32(_mm_sha256msg1_epu32(w0, w1),
+                        _mm_alignr_epi8(w3, w2, 4)),
+          w3);
+    }
+  #endif
+  // clang-format on
+
+  // Runs the compression function over `num_blocks` 64-byte blocks.
+  void Compress(const uint8_t *blocks, size_t num_blocks) {
+    const uint32_t *k = RoundConstants();
+    // clang-format off
+    #if defined(FLATBUFFERS_SHA256_SHANI)
+      // The instructions keep the state as ABEF and CDGH.
+      const __m128i swap =
+          _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+      const __m128i cdab = _mm_shuffle_epi32(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(state_)), 0xB1);
+      __m128i cdgh = _mm_shuffle_epi32(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(state_ + 4)),
+          0x1B);
+      __m128i abef = _mm_alignr_epi8(cdab, cdgh, 8);
+      cdgh = _mm_blend_epi16(cdgh, cdab, 0xF0);
+      for (; num_blocks; num_blocks--, blocks += 64) {
+        const __m128i abef_in = abef, cdgh_in = cdgh;
+        // The message schedule, four words at a time.
+        const __m128i *in = reinterpret_cast<const __m128i *>(blocks);
+        __m128i w0 = _mm_shuffle_epi8(_mm_loadu_si128(in), swap);
+        __m128i w1 = _mm_shuffle_epi8(_mm_loadu_si128(in + 1), swap);
+        __m128i w2 = _mm_shuffle_epi8(_mm_loadu_si128(in + 2), swap);
+        __m128i w3 = _mm_shuffle_epi8(_mm_loadu_si128(in + 3), swap);
+        Rounds(abef, cdgh, w0, k);
+        Rounds(abef, cdgh, w1, k + 4);
+        Rounds(abef, cdgh, w2, k + 8);
+        Rounds(abef, cdgh, w3, k + 12);
+        for (int i = 16; i < 64; i += 16) {
+          w0 = Schedule(w0, w1, w2, w3);
+          Rounds(abef, cdgh, w0, k + i);
+          w1 = Schedule(w1, w2, w3, w0);
+          Rounds(abef, cdgh, w1, k + i + 4);
+          w2 = Schedule(w2, w3, w0, w1);
+          Rounds(abef, cdgh, w2, k + i + 8);
+          w3 = Schedule(w3, w0, w1, w2);
+          Rounds(abef, cdgh, w3, k + i + 12);
+        }
+        abef = _mm_add_epi32(abef, abef_in);
+        cdgh = _mm_add_epi32(cdgh, cdgh_in);
+      }
+      const __m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+      const __m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(state_),
+                       _mm_blend_epi16(feba, dchg, 0xF0));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(state_ + 4),
+                       _mm_alignr_epi8(dchg, feba, 8));
+    #else
+      for (; num_blocks; num_blocks--, blocks += 64) CompressBlock(blocks, k);
+    #endif
+    // clang-format on
+  }
+
+  void CompressBlock(const uint8_t *block, const uint32_t *k) {
+    uint32_t w[64];
+    for (int i = 0; i < 16; i++) {
+      w[i] = (static_cast<uint32_t>(block[4 * i]) << 24) |
+             (static_cast<uint32_t>(block[4 * i + 1]) << 16) |
+             (static_cast<uint32_t>(block[4 * i + 2]) << 8) |
+             static_cast<uint32_t>(block[4 * i + 3]);
+    }
+    for (int i = 16; i < 64; i++) {
+      const uint32_t s0 =
+          Rotr(w[i - 15], 7) ^ Rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+      const uint32_t s1 =
+          Rotr(w[i - 2], 17) ^ Rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+      w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+    }
+    uint32_t a = state_[0], b = state_[1], c = state_[2], d = state_[3];
+    uint32_t e = state_[4], f = state_[5], g = state_[6], h = state_[7];
+    // Unrolled by eight, rotating the roles of the variables instead of
+    // moving their values around.
+    for (int i = 0; i < 64; i += 8) {
+      Round(a, b, c, d, e, f, g, h, k[i] + w[i]);
+      Round(h, a, b, c, d, e, f, g, k[i + 1] + w[i + 1]);
+      Round(g, h, a, b, c, d, e, f, k[i + 2] + w[i + 2]);
+      Round(f, g, h, a, b, c, d, e, k[i + 3] + w[i + 3]);
+      Round(e, f, g, h, a, b, c, d, k[i + 4] + w[i + 4]);
+      Round(d, e, f, g, h, a, b, c, k[i + 5] + w[i + 5]);
+      Round(c, d, e, f, g, h, a, b, k[i + 6] + w[i + 6]);
+      Round(b, c, d, e, f, g, h, a, k[i + 7] + w[i + 7]);
+    }
+    state_[0] += a;
+    state_[1] += b;
+    state_[2] += c;
+    state_[3] += d;
+    state_[4] += e;
+    state_[5] += f;
+    state_[6] += g;
+    state_[7] += h;
+  }
+};
+
+// VerificationCache remembers buffers that passed verification, so verifying
+// a byte-identical buffer again only costs hashing it. Meant for immutable
+// inputs that get verified over and over, like assets loaded on every start.
+// Entries are the SHA-256 digests of the buffers, together with the schema id
+// given to the constructor, the file identifier and the verifier options, so
+// no copies of the buffers are kept and buffers of any size can be cached.
+// Hashing runs at about 1 GB/s with the x86 SHA extensions and well below that
+// without, which is slower than verifying buffers of mostly scalars and
+// structs; the cache pays off for buffers of many small tables and strings.
+// Once full, the oldest entries make room for new ones.
+// The cache can be saved to and loaded from a sidecar file, to carry results
+// across process restarts.
+// @warning The digests in a sidecar file are taken as is, so a forged sidecar
+// can let any buffer through. Only load sidecar files from trusted sources.
+// This class is thread-safe.
+class VerificationCache {
+ public:
+  struct Options {
+    // The maximum number of buffers remembered.
+    size_t max_entries = 1024;
+  };
+
+  // `schema_id` identifies the schema and root type of the buffers, and should
+  // change whenever the schema does, e.g. "MyGame.Monster" plus a hash of
+  // the .fbs. Use a separate cache per root type.
+  explicit VerificationCache(const std::string &schema_id)
+      : VerificationCache(schema_id, Options()) {}
+
+  VerificationCache(const std::string &schema_id, const Options &opts)
+      : schema_id_(schema_id), opts_(opts) {}
+
+  // Same as `Verifier::VerifyBuffer<T>`, for `len` bytes at `buf`.
+  template<typename T>
+  bool VerifyBuffer(const uint8_t *buf, size_t len,
+                    const char *identifier = nullptr,
+                    const Verifier::Options &opts = Verifier::Options()) {
+    return Verify<T>(buf, len, identifier, opts, false);
+  }
+
+  // Same as `Verifier::VerifySizePrefixedBuffer<T>`.
+  template<typename T>
+  bool VerifySizePrefixedBuffer(
+      const uint8_t *buf, size_t len, const char *identifier = nullptr,
+      const Verifier::Options &opts = Verifier::Options()) {
+    return Verify<T>(buf, len, identifier, opts, true);
+  }
+
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    order_.clear();
+  }
+
+  // Appends all entries to `out`, oldest first, in a format independent of
+  // the host.
+  void Serialize(std::string *out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const uint64_t magic = EndianScalar(kMagic);
+    out->append(reinterpret_cast<const char *>(&magic), sizeof(magic));
+    for (auto it = order_.begin(); it != order_.end(); ++it) {
+      out->append(reinterpret_cast<const char *>(it->bytes), sizeof(it->bytes));
+    }
+  }
+
+  // Adds the entries from data written by Serialize(), as far as they fit.
+  // @return Returns false, adding nothing, if `data` is malformed.
+  bool Deserialize(const std::string &data) {
+    const auto p = reinterpret_cast<const uint8_t *>(data.data());
+    if (data.size() < sizeof(uint64_t) || ReadScalar<uint64_t>(p) != kMagic ||
+        (data.size() - sizeof(uint64_t)) % Sha256::kDigestSize) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (size_t i = sizeof(uint64_t); i < data.size();
+         i += Sha256::kDigestSize) {
+      Digest key;
+      memcpy(key.bytes, p + i, sizeof(key.bytes));
+      Insert(key);
+    }
+    return true;
+  }
+
+  // Loads entries from a sidecar file written by SaveToFile().
+  bool LoadFromFile(const char *filename) {
+    std::string data;
+    return LoadFile(filename, true, &data) && Deserialize(data);
+  }
+
+  bool SaveToFile(const char *filename) const {
+    std::string data;
+    Serialize(&data);
+    return SaveFile(filename, data, true);
+  }
+
+ private:
+  struct Digest {
+    uint8_t bytes[Sha256::kDigestSize];
+
+    bool operator<(const Digest &o) const {
+      return memcmp(bytes, o.bytes, sizeof(bytes)) < 0;
+    }
+  };
+
+  // Starts serialized data, and changes with its format.
+  static const uint64_t kMagic = 0x4548434156424603ULL;
+
+  const std::string schema_id_;
+  const Options opts_;
+  mutable std::mutex mutex_;
+  // The digests of the verified buffers, and the same in the order they were
+  // added.
+  std::set<Digest> entries_;
+  std::deque<Digest> order_;
+
+  template<typename T> static void AppendScalar(std::string *out, T v) {
+    v = EndianScalar(v);
+    out->append(reinterpret_cast<const char *>(&v), sizeof(v));
+  }
+
+  // Hashes everything that decides whether a buffer verifies: the schema,
+  // the options, the identifier and the buffer itself. All but the buffer
+  // are length-prefixed or fixed size, so no two inputs share a message.
+  Digest Hash(const uint8_t *buf, size_t len, const char *identifier,
+              const Verifier::Options &opts, bool size_prefixed) const {
+    std::string s;
+    AppendScalar(&s, static_cast<uint64_t>(schema_id_.size()));
+    s += schema_id_;
+    AppendScalar(&s, static_cast<uint64_t>(opts.max_depth));
+    AppendScalar(&s, static_cast<uint64_t>(opts.max_tables));
+    s += static_cast<char>(opts.check_alignment);
+    s += static_cast<char>(opts.check_nested_flatbuffers);
+    s += static_cast<char>(size_prefixed);
+    s += static_cast<char>(identifier != nullptr);
+    if (identifier) s.append(identifier, kFileIdentifierLength);
+    AppendScalar(&s, static_cast<uint64_t>(len));
+    Sha256 sha;
+    sha.Update(s.data(), s.size());
+    sha.Update(buf, len);
+    Digest digest;
+    sha.Finish(digest.bytes);
+    return digest;
+  }
+
+  // Remembers `key`, dropping the oldest entries to make room. Must hold
+  // `mutex_`.
+  void Insert(const Digest &key) {
+    if (!opts_.max_entries || entries_.count(key)) return;
+    while (entries_.size() >= opts_.max_entries) {
+      entries_.erase(order_.front());
+      order_.pop_front();
+    }
+    entries_.insert(key);
+    order_.push_back(key);
+  }
+
+  template<typename T>
+  bool Verify(const uint8_t *buf, size_t len, const char *identifier,
+              const Verifier::Options &opts, bool size_prefixed) {
+    const Digest key = Hash(buf, len, identifier, opts, size_prefixed);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (entries_.count(key)) return true;
+    }
+    Verifier verifier(buf, len, opts);
+    const bool ok = size_prefixed
+                        ? verifier.VerifySizePrefixedBuffer<T>(identifier)
+                        : verifier.VerifyBuffer<T>(identifier);
+    if (ok) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      Insert(key);
+    }
+    return ok;
+  }
+
+  // You shouldn't really be copying instances of this class.
+  FLATBUFFERS_DELETE_FUNC(VerificationCache(const VerificationCache &));
+  FLATBUFFERS_DELETE_FUNC(
+      VerificationCache &operator=(const VerificationCache &));
+};
+
+}  // namespace flatbuffers
+
+#endif  // FLATBUFFERS_VERIFICATION_CACHE_H_
@@ -17,9 +17,27 @@
 #ifndef FLATBUFFERS_VERIFIER_H_
 #define FLATBUFFERS_VERIFIER_H_
 
+#include <atomic>
+#include <functional>
+
 #include "flatbuffers/base.h"
 #include "flatbuffers/vector.h"
 
+// Vector offsets are checked a few at a time with SIMD where the baseline
+// instruction set has it. Define FLATBUFFERS_NO_SIMD to always use scalar code.
+// clang-format off
+#if !defined(FLATBUFFERS_NO_SIMD) && FLATBUFFERS_LITTLEENDIAN
+  #if defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define FLATBUFFERS_VERIFIER_SSE2 1
+  #elif defined(__aarch64__) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define FLATBUFFERS_VERIFIER_NEON 1
+  #endif
+#endif
+// clang-format on
+
 namespace flatbuffers {
 
 // Helper class to verify the integrity of a FlatBuffer
@@ -36,6 +54,13 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
     bool check_nested_flatbuffers = true;
   };
 
+  // Runs `task(0)` to `task(num_tasks - 1)`, possibly concurrently, and
+  // returns once all of them have completed. Supplied by the caller to verify
+  // large vectors of tables in parallel, see SetExecutor().
+  typedef std::function<void(size_t num_tasks,
+                             const std::function<void(size_t)> &task)>
+      Executor;
+
   explicit Verifier(const uint8_t *const buf, const size_t buf_len,
                     const Options &opts)
       : buf_(buf), size_(buf_len), opts_(opts) {
@@ -153,17 +178,112 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
   // Special case for string contents, after the above has been called.
   bool VerifyVectorOfStrings(const Vector<Offset<String>> *const vec) const {
     if (vec) {
-      for (uoffset_t i = 0; i < vec->size(); i++) {
-        if (!VerifyString(vec->Get(i))) return false;
-      }
+      // clang-format off
+      #ifdef FLATBUFFERS_TRACK_VERIFIER_BUFFER_SIZE
+        for (uoffset_t i = 0; i < vec->size(); i++) {
+          if (!VerifyString(vec->Get(i))) return false;
+        }
+      #else
+        // Same checks as VerifyString(), but with the length fields checked
+        // in bulk first, leaving only the strings themselves to the loop.
+        const auto data = static_cast<size_t>(vec->Data() - buf_);
+        if (!VerifyOffsetTargets(data, vec->size(), sizeof(uoffset_t)))
+          return false;
+        for (uoffset_t i = 0; i < vec->size(); i++) {
+          const auto elem = data + i * sizeof(uoffset_t);
+          const auto str = elem + ReadScalar<uoffset_t>(buf_ + elem);
+          const auto len = ReadScalar<uoffset_t>(buf_ + str);
+          const auto end = str + sizeof(uoffset_t) + len;
+          // The terminator must fit into the buffer too, and be 0.
+          if (!Check(len < size_ - str - sizeof(uoffset_t) &&
+                     buf_[end] == '\0'))
+            return false;
+        }
+      #endif
+      // clang-format on
     }
     return true;
   }
 
+  // Checks that `count` offsets stored from position `elems` on (which must
+  // be in the buffer) point at uoffset_t-sized fields, aligned to `align` if
+  // alignment is checked. Used for vectors of offsets.
+  bool VerifyOffsetTargets(const size_t elems, const size_t count,
+                           const size_t align) const {
+    if (!count) return true;
+    if (!Check(sizeof(uoffset_t) < size_)) return false;
+    const size_t limit = size_ - sizeof(uoffset_t);
+    const size_t align_mask = opts_.check_alignment ? align - 1 : 0;
+    size_t i = 0;
+    // clang-format off
+    #if defined(FLATBUFFERS_VERIFIER_SSE2) || defined(FLATBUFFERS_VERIFIER_NEON)
+      // Buffers are smaller than 2GB, so positions and the room left after
+      // them fit into int32 lanes. The room left only shrinks, so offsets
+      // with the top bit set, negative as int32, are out of bounds.
+      // Target alignment only depends on the low bits of position + offset.
+      const int32_t kLanePositions[4] = { 0, 4, 8, 12 };
+    #endif
+    #if defined(FLATBUFFERS_VERIFIER_SSE2)
+      const __m128i lanes = _mm_loadu_si128(
+          reinterpret_cast<const __m128i *>(kLanePositions));
+      const __m128i zero = _mm_setzero_si128();
+      const __m128i mask = _mm_set1_epi32(static_cast<int32_t>(align_mask));
+      const __m128i step = _mm_set1_epi32(16);
+      __m128i pos = _mm_add_epi32(_mm_set1_epi32(static_cast<int32_t>(elems)),
+                                  lanes);
+      __m128i room = _mm_sub_epi32(
+          _mm_set1_epi32(static_cast<int32_t>(limit - elems)), lanes);
+      __m128i bad = zero;
+      for (; i < (count & ~size_t(3)); i += 4) {
+        const __m128i off = _mm_loadu_si128(reinterpret_cast<const __m128i *>(
+            buf_ + elems + i * sizeof(uoffset_t)));
+        bad = _mm_or_si128(bad, _mm_cmplt_epi32(off, zero));
+        bad = _mm_or_si128(bad, _mm_cmpgt_epi32(off, room));
+        bad = _mm_or_si128(bad, _mm_and_si128(_mm_add_epi32(pos, off), mask));
+        pos = _mm_add_epi32(pos, step);
+        room = _mm_sub_epi32(room, step);
+      }
+      if (!Check(_mm_movemask_epi8(_mm_cmpeq_epi32(bad, zero)) == 0xFFFF))
+        return false;
+    #elif defined(FLATBUFFERS_VERIFIER_NEON)
+      const int32x4_t lanes = vld1q_s32(kLanePositions);
+      const int32x4_t zero = vdupq_n_s32(0);
+      const uint32x4_t mask = vdupq_n_u32(static_cast<uint32_t>(align_mask));
+      const int32x4_t step = vdupq_n_s32(16);
+      int32x4_t pos = vaddq_s32(vdupq_n_s32(static_cast<int32_t>(elems)),
+                                lanes);
+      int32x4_t room = vsubq_s32(
+          vdupq_n_s32(static_cast<int32_t>(limit - elems)), lanes);
+      uint32x4_t bad = vdupq_n_u32(0);
+      for (; i < (count & ~size_t(3)); i += 4) {
+        const int32x4_t off = vreinterpretq_s32_u8(
+            vld1q_u8(buf_ + elems + i * sizeof(uoffset_t)));
+        bad = vorrq_u32(bad, vcltq_s32(off, zero));
+        bad = vorrq_u32(bad, vcgtq_s32(off, room));
+        bad = vorrq_u32(
+            bad, vandq_u32(vreinterpretq_u32_s32(vaddq_s32(pos, off)), mask));
+        pos = vaddq_s32(pos, step);
+        room = vsubq_s32(room, step);
+      }
+      if (!Check(vmaxvq_u32(bad) == 0)) return false;
+    #endif
+    // clang-format on
+    bool ok = true;
+    for (; i < count; i++) {
+      const size_t elem = elems + i * sizeof(uoffset_t);
+      const size_t off = ReadScalar<uoffset_t>(buf_ + elem);
+      ok &= off <= limit - elem && ((elem + off) & align_mask) == 0;
+    }
+    return Check(ok);
+  }
+
   // Special case for table contents, after the above has been called.
   template<typename T>
   bool VerifyVectorOfTables(const Vector<Offset<T>> *const vec) {
     if (vec) {
+      // The reuse tracker can't be shared between threads.
+      if (executor_ && vec->size() > tables_per_task_ && !flex_reuse_tracker_)
+        return VerifyVectorOfTablesInParallel(vec);
       for (uoffset_t i = 0; i < vec->size(); i++) {
         if (!vec->Get(i)->Verify(*this)) return false;
       }
@@ -227,6 +347,7 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
     if (!Check(buf->size() >= FLATBUFFERS_MIN_BUFFER_SIZE)) return false;
 
     Verifier nested_verifier(buf->data(), buf->size());
+    nested_verifier.SetExecutor(executor_, tables_per_task_);
     return nested_verifier.VerifyBuffer<T>(identifier);
   }
 
@@ -268,7 +389,8 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
   bool VerifyComplexity() {
     depth_++;
     num_tables_++;
-    return Check(depth_ <= opts_.max_depth && num_tables_ <= opts_.max_tables);
+    return Check(depth_ <= opts_.max_depth &&
+                 num_tables_ <= opts_.max_tables && CountSharedTables());
   }
 
   // Called at the end of a table to pop the depth count.
@@ -300,7 +422,66 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
     flex_reuse_tracker_ = rt;
   }
 
+  // Verify vectors of more than `tables_per_task` tables (also in nested
+  // flatbuffers) by splitting them into tasks run by `executor`, each with
+  // its own counters, which are merged afterwards. Tasks share what is left
+  // of `max_tables`, so they all stop soon after it runs out. The verdict is
+  // the same as without an executor. `executor` must outlive this verifier.
+  void SetExecutor(const Executor *const executor,
+                   const uoffset_t tables_per_task = 1024) {
+    FLATBUFFERS_ASSERT(tables_per_task > 0);
+    executor_ = executor;
+    tables_per_task_ = tables_per_task;
+  }
+
  private:
+  // In a task of VerifyVectorOfTablesInParallel(), adds the tables counted so
+  // far to the total of all tasks, every so many so as not to contend for it,
+  // and checks the total against the budget.
+  bool CountSharedTables() {
+    const uoffset_t batch = 64;
+    if (!shared_num_tables_ || num_tables_ % batch) return true;
+    return shared_num_tables_->fetch_add(batch, std::memory_order_relaxed) +
+               batch <=
+           opts_.max_tables;
+  }
+
+  template<typename T>
+  bool VerifyVectorOfTablesInParallel(const Vector<Offset<T>> *const vec) {
+    const uoffset_t size = vec->size();
+    const size_t num_tasks = (size - 1) / tables_per_task_ + 1;
+    std::vector<uint8_t> task_ok(num_tasks, 0);
+    std::vector<uoffset_t> task_num_tables(num_tasks, 0);
+    std::vector<size_t> task_upper_bound(num_tasks, 0);
+    // What is left of the table budget, for all tasks together.
+    Options worker_opts = opts_;
+    worker_opts.max_tables -= num_tables_;
+    std::atomic<uoffset_t> shared_num_tables(0);
+    (*executor_)(num_tasks, [&](size_t task) {
+      // Tasks don't split further, so executors need not be reentrant.
+      Verifier worker(buf_, size_, worker_opts);
+      worker.depth_ = depth_;
+      worker.shared_num_tables_ = &shared_num_tables;
+      const auto begin = static_cast<uoffset_t>(task * tables_per_task_);
+      const auto end = (std::min)(begin + tables_per_task_, size);
+      bool ok = shared_num_tables.load(std::memory_order_relaxed) <=
+                worker_opts.max_tables;
+      for (uoffset_t i = begin; i < end && ok; i++) {
+        ok = vec->Get(i)->Verify(worker);
+      }
+      task_ok[task] = ok;
+      task_num_tables[task] = worker.num_tables_;
+      task_upper_bound[task] = worker.upper_bound_;
+    });
+    for (size_t task = 0; task < num_tasks; task++) {
+      if (!Check(task_ok[task] != 0)) return false;
+      num_tables_ += task_num_tables[task];
+      upper_bound_ = (std::max)(upper_bound_, task_upper_bound[task]);
+    }
+    // Each task only saw its own tables, so check the total.
+    return Check(num_tables_ <= opts_.max_tables);
+  }
+
   const uint8_t *buf_;
   const size_t size_;
   const Options opts_;
@@ -310,6 +491,9 @@ class Verifier FLATBUFFERS_FINAL_CLASS {
   uoffset_t depth_ = 0;
   uoffset_t num_tables_ = 0;
   std::vector<uint8_t> *flex_reuse_tracker_ = nullptr;
+  const Executor *executor_ = nullptr;
+  uoffset_t tables_per_task_ = 1024;
+  std::atomic<uoffset_t> *shared_num_tables_ = nullptr;
 };
 
 }  // namespace flatbuffers
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2021 Google Inc. All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FLATBUFFERS_VIRTUAL_MEMORY_ALLOCATOR_H_
+#define FLATBUFFERS_VIRTUAL_MEMORY_ALLOCATOR_H_
+
+// clang-format off
+#if defined(_WIN32)
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#  define FLATBUFFERS_HAS_VIRTUAL_MEMORY 1
+#elif defined(__unix__) || defined(__APPLE__)
+#  include <sys/mman.h>
+#  define FLATBUFFERS_HAS_VIRTUAL_MEMORY 1
+#else
+#  define FLATBUFFERS_HAS_VIRTUAL_MEMORY 0
+#endif
+// clang-format on
+
+#include "flatbuffers/allocator.h"
+#include "flatbuffers/base.h"
+
+namespace flatbuffers {
+
+// VirtualMemoryAllocator lets a `vector_downward` (the buffer of a
+// FlatBufferBuilder) grow without ever copying what has been built so far.
+// Every allocation reserves `max_size` bytes of address space, and the buffer
+// lives at the top of it. Growing extends the buffer downwards into the
+// reserved space, which only moves the small scratch area at its front, where
+// the default path allocates a larger region and copies everything into it.
+// Pages are only backed by memory once they are written to, so peak memory
+// use stays close to the size of the finished buffer, instead of up to 2x.
+// On platforms without virtual memory support, it allocates with new[] and
+// grows by copying, like `DefaultAllocator`.
+// Meant for a few large buffers: each allocation costs `max_size` bytes of
+// address space, so don't use it for e.g. the vtable or string indices.
+// Allocations, and growing, fail with nullptr beyond `max_size`, on which
+// `FlatBufferBuilder` throws std::bad_alloc, or aborts without exceptions.
+class VirtualMemoryAllocator : public Allocator {
+ public:
+  // As much as a buffer can hold, where there is the address space for it.
+  static const size_t kDefaultMaxSize =
+      sizeof(void *) >= 8 ? static_cast<size_t>(FLATBUFFERS_MAX_BUFFER_SIZE)
+                          : 256 * 1024 * 1024;
+
+  explicit VirtualMemoryAllocator(size_t max_size = kDefaultMaxSize)
+      : max_size_(RoundToPages(max_size)) {}
+
+  uint8_t *allocate(size_t size) FLATBUFFERS_OVERRIDE {
+    // clang-format off
+    #if FLATBUFFERS_HAS_VIRTUAL_MEMORY
+      if (size > max_size_) return nullptr;
+      #if defined(_WIN32)
+        auto base = static_cast<uint8_t *>(
+            VirtualAlloc(nullptr, max_size_, MEM_RESERVE, PAGE_NOACCESS));
+        if (!base) return nullptr;
+        auto p = base + max_size_ - size;
+        if (!Commit(p, size)) {
+          VirtualFree(base, 0, MEM_RELEASE);
+          return nullptr;
+        }
+        return p;
+      #else
+        auto base = mmap(nullptr, max_size_, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (base == MAP_FAILED) return nullptr;
+        return static_cast<uint8_t *>(base) + max_size_ - size;
+      #endif
+    #else
+      return new uint8_t[size];
+    #endif
+    // clang-format on
+  }
+
+  void deallocate(uint8_t *p, size_t size) FLATBUFFERS_OVERRIDE {
+    // clang-format off
+    #if FLATBUFFERS_HAS_VIRTUAL_MEMORY
+      // Allocations always end at the end of their reservation.
+      auto base = p + size - max_size_;
+      #if defined(_WIN32)
+        VirtualFree(base, 0, MEM_RELEASE);
+      #else
+        munmap(base, max_size_);
+      #endif
+    #else
+      (void)size;
+      delete[] p;
+    #endif
+    // clang-format on
+  }
+
+  uint8_t *reallocate_downward(uint8_t *old_p, size_t old_size,
+                               size_t new_size, size_t in_use_back,
+                               size_t in_use_front) FLATBUFFERS_OVERRIDE {
+    FLATBUFFERS_ASSERT(new_size > old_size);  // vector_downward only grows
+    // clang-format off
+    #if FLATBUFFERS_HAS_VIRTUAL_MEMORY
+      // The reservation has room for max_size_ bytes, and can't grow.
+      if (new_size > max_size_) return nullptr;
+      auto new_p = old_p - (new_size - old_size);
+      #if defined(_WIN32)
+        if (!Commit(new_p, new_size - old_size)) return nullptr;
+      #endif
+      // The back already is where it belongs, only the front moves down.
+      (void)in_use_back;
+      memmove(new_p, old_p, in_use_front);
+      return new_p;
+    #else
+      return Allocator::reallocate_downward(old_p, old_size, new_size,
+                                            in_use_back, in_use_front);
+    #endif
+    // clang-format on
+  }
+
+ private:
+  size_t max_size_;
+
+  static size_t RoundToPages(size_t size) {
+    const size_t kPageSize = 64 * 1024;  // Multiple of all common page sizes.
+    return (size + kPageSize - 1) & ~(kPageSize - 1);
+  }
+
+  // clang-format off
+  #if defined(_WIN32)
+    static bool Commit(uint8_t *p, size_t size) {
+      return VirtualAlloc(p, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+    }
+  #endif
+  // clang-format on
+};
+
+}  // namespace flatbuffers
+
+#endif  // FLATBUFFERS_VIRTUAL_MEMORY_ALLOCATOR_H_
@@ -146,6 +146,7 @@ struct EquipmentUnion {
   }
 
   static void *UnPack(const void *obj, Equipment type, const flatbuffers::resolver_function_t *resolver);
+  void UnPackTo(const void *obj, Equipment obj_type, const flatbuffers::resolver_function_t *resolver);
   flatbuffers::Offset<void> Pack(flatbuffers::FlatBufferBuilder &_fbb, const flatbuffers::rehasher_function_t *_rehasher = nullptr) const;
 
   MyGame::Sample::WeaponT *AsWeapon() {
@@ -601,15 +602,14 @@ inline MonsterT *Monster::UnPack(const flatbuffers::resolver_function_t *_resolv
 inline void Monster::UnPackTo(MonsterT *_o, const flatbuffers::resolver_function_t *_resolver) const {
   (void)_o;
   (void)_resolver;
-  { auto _e = pos(); if (_e) _o->pos = flatbuffers::unique_ptr<MyGame::Sample::Vec3>(new MyGame::Sample::Vec3(*_e)); }
+  { auto _e = pos(); if (_e) { if (_o->pos) { *_o->pos = *_e; } else { _o->pos = flatbuffers::unique_ptr<MyGame::Sample::Vec3>(new MyGame::Sample::Vec3(*_e)); } } else if (_o->pos) { _o->pos.reset(); } }
   { auto _e = mana(); _o->mana = _e; }
   { auto _e = hp(); _o->hp = _e; }
-  { auto _e = name(); if (_e) _o->name = _e->str(); }
-  { auto _e = inventory(); if (_e) { _o->inventory.resize(_e->size()); std::copy(_e->begin(), _e->end(), _o->inventory.begin()); } }
+  { auto _e = name(); if (_e) _o->name.assign(_e->c_str(), _e->size()); else _o->name.clear(); }
+  { auto _e = inventory(); if (_e) { _o->inventory.resize(_e->size()); std::copy(_e->begin(), _e->end(), _o->inventory.begin()); } else { _o->inventory.resize(0); } }
   { auto _e = color(); _o->color = _e; }
   { auto _e = weapons(); if (_e) { _o->weapons.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { if(_o->weapons[_i]) { _e->Get(_i)->UnPackTo(_o->weapons[_i].get(), _resolver); } else { _o->weapons[_i] = flatbuffers::unique_ptr<MyGame::Sample::WeaponT>(_e->Get(_i)->UnPack(_resolver)); }; } } else { _o->weapons.resize(0); } }
-  { auto _e = equipped_type(); _o->equipped.type = _e; }
-  { auto _e = equipped(); if (_e) _o->equipped.value = MyGame::Sample::EquipmentUnion::UnPack(_e, equipped_type(), _resolver); }
+  { auto _e = equipped(); if (_e) _o->equipped.UnPackTo(_e, equipped_type(), _resolver); else _o->equipped.Reset(); }
   { auto _e = path(); if (_e) { _o->path.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->path[_i] = *_e->Get(_i); } } else { _o->path.resize(0); } }
 }
 
@@ -666,7 +666,7 @@ inline WeaponT *Weapon::UnPack(const flatbuffers::resolver_function_t *_resolver
 inline void Weapon::UnPackTo(WeaponT *_o, const flatbuffers::resolver_function_t *_resolver) const {
   (void)_o;
   (void)_resolver;
-  { auto _e = name(); if (_e) _o->name = _e->str(); }
+  { auto _e = name(); if (_e) _o->name.assign(_e->c_str(), _e->size()); else _o->name.clear(); }
   { auto _e = damage(); _o->damage = _e; }
 }
 
@@ -722,6 +722,23 @@ inline void *EquipmentUnion::UnPack(const void *obj, Equipment type, const flatb
   }
 }
 
+inline void EquipmentUnion::UnPackTo(const void *obj, Equipment obj_type, const flatbuffers::resolver_function_t *resolver) {
+  if (!obj || obj_type != type || !value) {
+    Reset();
+    if (obj) value = UnPack(obj, obj_type, resolver);
+    type = obj_type;
+    return;
+  }
+  switch (type) {
+    case Equipment_Weapon: {
+      auto ptr = reinterpret_cast<const MyGame::Sample::Weapon *>(obj);
+      ptr->UnPackTo(reinterpret_cast<MyGame::Sample::WeaponT *>(value), resolver);
+      break;
+    }
+    default: break;
+  }
+}
+
 inline flatbuffers::Offset<void> EquipmentUnion::Pack(flatbuffers::FlatBufferBuilder &_fbb, const flatbuffers::rehasher_function_t *_rehasher) const {
   (void)_rehasher;
   switch (type) {
@@ -917,6 +934,18 @@ inline flatbuffers::unique_ptr<MyGame::Sample::MonsterT> UnPackSizePrefixedMonst
   return flatbuffers::unique_ptr<MyGame::Sample::MonsterT>(GetSizePrefixedMonster(buf)->UnPack(res));
 }
 
+inline void UnPackToMonster(
+    const void *buf, MyGame::Sample::MonsterT *_o,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  GetMonster(buf)->UnPackTo(_o, res);
+}
+
+inline void UnPackToSizePrefixedMonster(
+    const void *buf, MyGame::Sample::MonsterT *_o,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  GetSizePrefixedMonster(buf)->UnPackTo(_o, res);
+}
+
 }  // namespace Sample
 }  // namespace MyGame
 
@@ -21,6 +21,9 @@
 
 #include "annotated_binary_text_gen.h"
 #include "binary_annotator.h"
+#include "flatbuffers/compiled_schema.h"
+#include "flatbuffers/mapped_file.h"
+#include "flatbuffers/reflection.h"
 #include "flatbuffers/util.h"
 
 namespace flatbuffers {
@@ -221,6 +224,11 @@ const static FlatCOption options[] = {
     "Only generated one typescript file per .fbs file." },
   { "", "annotate", "SCHEMA",
     "Annotate the provided BINARY_FILE with the specified SCHEMA file." },
+  { "", "convert-from", "SCHEMA",
+    "Convert the BINARY_FILEs, of the specified SCHEMA, to the schema given "
+    "as FILE, which it evolved into. Renamed fields, widened scalars, "
+    "renumbered enums and unions and fields moved into a new table are "
+    "carried over." },
   { "", "no-leak-private-annotation", "",
     "Prevents multiple type of annotations within a Fbs SCHEMA file."
     "Currently this is required to generate private types in Rust" },
@@ -372,6 +380,88 @@ void FlatCompiler::AnnotateBinaries(
   }
 }
 
+std::string FlatCompiler::LoadSchemaAsBinary(
+    const std::string &filename,
+    std::vector<const char *> &include_directories) const {
+  const bool is_binary_schema =
+      flatbuffers::GetExtension(filename) == reflection::SchemaExtension();
+  std::string contents;
+  if (!flatbuffers::LoadFile(filename.c_str(), is_binary_schema, &contents)) {
+    Error("unable to load schema: " + filename);
+  }
+  if (is_binary_schema) {
+    flatbuffers::Verifier verifier(
+        reinterpret_cast<const uint8_t *>(contents.c_str()), contents.size());
+    if (!reflection::VerifySchemaBuffer(verifier)) {
+      Error("failed to load binary schema: " + filename, false, false);
+    }
+    return contents;
+  }
+  IDLOptions binary_opts;
+  binary_opts.lang_to_generate |= flatbuffers::IDLOptions::kBinary;
+  // The converter needs to know which enums are bit_flags.
+  binary_opts.binary_schema_builtins = true;
+  flatbuffers::Parser parser(binary_opts);
+  ParseFile(parser, filename, contents, include_directories);
+  parser.Serialize();
+  return std::string(
+      reinterpret_cast<const char *>(parser.builder_.GetBufferPointer()),
+      parser.builder_.GetSize());
+}
+
+void FlatCompiler::ConvertBinaries(
+    const std::string &from_schema, const std::string &to_schema,
+    const std::vector<std::string> &binary_files,
+    const std::string &output_path,
+    std::vector<const char *> &include_directories) {
+  const std::string from_bfbs =
+      LoadSchemaAsBinary(from_schema, include_directories);
+  const std::string to_bfbs = LoadSchemaAsBinary(to_schema, include_directories);
+  auto &from = *reflection::GetSchema(from_bfbs.c_str());
+  auto &to = *reflection::GetSchema(to_bfbs.c_str());
+  flatbuffers::SchemaConverter converter(from, to);
+  if (!converter.error().empty()) {
+    Error("cannot convert from " + from_schema + ":\n" + converter.error(),
+          false);
+  }
+  // The converter expects verified buffers.
+  const flatbuffers::CompiledSchema verifier(from);
+  const std::string extension =
+      to.file_ext() && to.file_ext()->size() ? to.file_ext()->str() : "bin";
+  flatbuffers::EnsureDirExists(output_path);
+  flatbuffers::FlatBufferBuilder builder;
+  for (const std::string &filename : binary_files) {
+    std::string contents;
+    if (!flatbuffers::LoadFile(filename.c_str(), true, &contents)) {
+      Warn("unable to load binary file: " + filename);
+      continue;
+    }
+    auto buf = reinterpret_cast<const uint8_t *>(contents.c_str());
+    if (!verifier.Verify(*verifier.root(), buf, contents.size())) {
+      Error("binary \"" + filename + "\" does not verify against " +
+                from_schema,
+            false);
+    }
+    const std::string converted_filename =
+        output_path + flatbuffers::StripPath(flatbuffers::StripExtension(
+                          filename)) +
+        "." + extension;
+    if (flatbuffers::AbsolutePath(converted_filename) ==
+        flatbuffers::AbsolutePath(filename)) {
+      Error("converting \"" + filename + "\" would overwrite it, use -o",
+            false);
+    }
+    builder.Clear();
+    converter.Convert(builder, buf);
+    if (!flatbuffers::SaveFile(
+            converted_filename.c_str(),
+            reinterpret_cast<const char *>(builder.GetBufferPointer()),
+            builder.GetSize(), true)) {
+      Error("unable to write file: " + converted_filename, false);
+    }
+  }
+}
+
 int FlatCompiler::Compile(int argc, const char **argv) {
   if (params_.generators == nullptr || params_.num_generators == 0) {
     return 0;
@@ -396,6 +486,7 @@ int FlatCompiler::Compile(int argc, const char **argv) {
   size_t binary_files_from = std::numeric_limits<size_t>::max();
   std::string conform_to_schema;
   std::string annotate_schema;
+  std::string convert_from_schema;
 
   const char *program_name = argv[0];
 
@@ -604,6 +695,9 @@ int FlatCompiler::Compile(int argc, const char **argv) {
       } else if (arg == "--annotate") {
         if (++argi >= argc) Error("missing path following: " + arg, true);
         annotate_schema = flatbuffers::PosixPath(argv[argi]);
+      } else if (arg == "--convert-from") {
+        if (++argi >= argc) Error("missing path following: " + arg, true);
+        convert_from_schema = flatbuffers::PosixPath(argv[argi]);
       } else {
         for (size_t i = 0; i < params_.num_generators; ++i) {
           if (arg == "--" + params_.generators[i].option.long_opt ||
@@ -633,7 +727,7 @@ int FlatCompiler::Compile(int argc, const char **argv) {
     if (any_generator)
       Error("cannot generate code directly from .proto files", true);
   } else if (!any_generator && conform_to_schema.empty() &&
-             annotate_schema.empty()) {
+             annotate_schema.empty() && convert_from_schema.empty()) {
     Error("no options: specify at least one generator.", true);
   }
 
@@ -705,17 +799,33 @@ int FlatCompiler::Compile(int argc, const char **argv) {
     return 0;
   }
 
+  if (!convert_from_schema.empty()) {
+    if (binary_files_from != 1) {
+      Error("--convert-from takes the schema to convert to, then -- and the "
+            "binaries to convert");
+    }
+    ConvertBinaries(
+        convert_from_schema, filenames[0],
+        std::vector<std::string>(filenames.begin() + 1, filenames.end()),
+        output_path, include_directories);
+    return 0;
+  }
+
   std::unique_ptr<flatbuffers::Parser> parser(new flatbuffers::Parser(opts));
 
   for (auto file_it = filenames.begin(); file_it != filenames.end();
        ++file_it) {
     auto &filename = *file_it;
+    bool is_binary =
+        static_cast<size_t>(file_it - filenames.begin()) >= binary_files_from;
+    // Binaries are mapped rather than read, they are only copied once, into
+    // the builder.
     std::string contents;
-    if (!flatbuffers::LoadFile(filename.c_str(), true, &contents))
+    flatbuffers::MappedFile binary;
+    if (is_binary ? !flatbuffers::LoadFileMapped(filename.c_str(), &binary)
+                  : !flatbuffers::LoadFile(filename.c_str(), true, &contents))
       Error("unable to load file: " + filename);
 
-    bool is_binary =
-        static_cast<size_t>(file_it - filenames.begin()) >= binary_files_from;
     auto ext = flatbuffers::GetExtension(filename);
     const bool is_schema = ext == "fbs" || ext == "proto";
     if (is_schema && opts.project_root.empty()) {
@@ -724,9 +834,7 @@ int FlatCompiler::Compile(int argc, const char **argv) {
     const bool is_binary_schema = ext == reflection::SchemaExtension();
     if (is_binary) {
       parser->builder_.Clear();
-      parser->builder_.PushFlatBuffer(
-          reinterpret_cast<const uint8_t *>(contents.c_str()),
-          contents.length());
+      parser->builder_.PushFlatBuffer(binary.data(), binary.size());
       if (!raw_binary) {
         // Generally reading binaries that do not correspond to the schema
         // will crash, and sadly there's no way around that when the binary
@@ -739,7 +847,7 @@ int FlatCompiler::Compile(int argc, const char **argv) {
                 "\" matches the schema, use --raw-binary to read this file"
                 " anyway.");
         } else if (!flatbuffers::BufferHasIdentifier(
-                       contents.c_str(), parser->file_identifier_.c_str(),
+                       binary.data(), parser->file_identifier_.c_str(),
                        opts.size_prefixed)) {
           Error("binary \"" + filename +
                 "\" does not have expected file_identifier \"" +
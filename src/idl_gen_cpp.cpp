@@ -399,6 +399,12 @@ class CppGenerator : public BaseGenerator {
       code_ += "#include \"flatbuffers/flexbuffers.h\"";
       code_ += "#include \"flatbuffers/flex_flat_util.h\"";
     }
+    if (UsesIndex("hash_index")) {
+      code_ += "#include \"flatbuffers/hash_index.h\"";
+    }
+    if (UsesIndex("key_index")) {
+      code_ += "#include \"flatbuffers/key_index.h\"";
+    }
     code_ += "";
     GenFlatbuffersVersionCheck();
     code_ += "";
@@ -672,6 +678,22 @@ class CppGenerator : public BaseGenerator {
         code_ += "(GetSizePrefixed{{STRUCT_NAME}}(buf)->UnPack(res));";
         code_ += "}";
         code_ += "";
+
+        // And ones that reuse an object unpacked into before.
+        code_.SetValue("NATIVE_NAME", native_name);
+        code_ += "inline void UnPackTo{{STRUCT_NAME}}(";
+        code_ += "    const void *buf, {{NATIVE_NAME}} *_o,";
+        code_ += "    const flatbuffers::resolver_function_t *res = nullptr) {";
+        code_ += "  Get{{STRUCT_NAME}}(buf)->UnPackTo(_o, res);";
+        code_ += "}";
+        code_ += "";
+
+        code_ += "inline void UnPackToSizePrefixed{{STRUCT_NAME}}(";
+        code_ += "    const void *buf, {{NATIVE_NAME}} *_o,";
+        code_ += "    const flatbuffers::resolver_function_t *res = nullptr) {";
+        code_ += "  GetSizePrefixed{{STRUCT_NAME}}(buf)->UnPackTo(_o, res);";
+        code_ += "}";
+        code_ += "";
       }
     }
 
@@ -1025,6 +1047,12 @@ class CppGenerator : public BaseGenerator {
            " type, const flatbuffers::resolver_function_t *resolver)";
   }
 
+  std::string UnionUnPackToSignature(const EnumDef &enum_def, bool inclass) {
+    return "void " + (inclass ? "" : Name(enum_def) + "Union::") +
+           "UnPackTo(const void *obj, " + Name(enum_def) +
+           " obj_type, const flatbuffers::resolver_function_t *resolver)";
+  }
+
   std::string UnionPackSignature(const EnumDef &enum_def, bool inclass) {
     return "flatbuffers::Offset<void> " +
            (inclass ? "" : Name(enum_def) + "Union::") +
@@ -1439,6 +1467,7 @@ class CppGenerator : public BaseGenerator {
         code_ += "";
       }
       code_ += "  " + UnionUnPackSignature(enum_def, true) + ";";
+      code_ += "  " + UnionUnPackToSignature(enum_def, true) + ";";
       code_ += "  " + UnionPackSignature(enum_def, true) + ";";
       code_ += "";
 
@@ -1613,6 +1642,50 @@ class CppGenerator : public BaseGenerator {
       code_ += "}";
       code_ += "";
 
+      // Generate union UnPackTo(), which unpacks into the current value if it
+      // is of the same type, so it keeps whatever it has allocated.
+      code_ += "inline " + UnionUnPackToSignature(enum_def, false) + " {";
+      code_ += "  if (!obj || obj_type != type || !value) {";
+      code_ += "    Reset();";
+      code_ += "    if (obj) value = UnPack(obj, obj_type, resolver);";
+      code_ += "    type = obj_type;";
+      code_ += "    return;";
+      code_ += "  }";
+      code_ += "  switch (type) {";
+      for (auto it = enum_def.Vals().begin(); it != enum_def.Vals().end();
+           ++it) {
+        const auto &ev = **it;
+        if (ev.IsZero()) { continue; }
+
+        code_.SetValue("LABEL", GetEnumValUse(enum_def, ev));
+        code_.SetValue("TYPE", GetUnionElement(ev, false, opts_));
+        code_.SetValue("NATIVE_TYPE", GetUnionElement(ev, true, opts_));
+        code_ += "    case {{LABEL}}: {";
+        code_ += "      auto ptr = reinterpret_cast<const {{TYPE}} *>(obj);";
+        if (ev.union_type.base_type == BASE_TYPE_STRUCT) {
+          if (ev.union_type.struct_def->fixed) {
+            code_ +=
+                "      *reinterpret_cast<{{NATIVE_TYPE}} *>(value) = *ptr;";
+          } else {
+            code_ +=
+                "      ptr->UnPackTo(reinterpret_cast<{{NATIVE_TYPE}} *>"
+                "(value), resolver);";
+          }
+        } else if (IsString(ev.union_type)) {
+          code_ +=
+              "      reinterpret_cast<std::string *>(value)->assign("
+              "ptr->c_str(), ptr->size());";
+        } else {
+          FLATBUFFERS_ASSERT(false);
+        }
+        code_ += "      break;";
+        code_ += "    }";
+      }
+      code_ += "    default: break;";
+      code_ += "  }";
+      code_ += "}";
+      code_ += "";
+
       code_ += "inline " + UnionPackSignature(enum_def, false) + " {";
       code_ += "  (void)_rehasher;";
       code_ += "  switch (type) {";
@@ -2305,6 +2378,49 @@ class CppGenerator : public BaseGenerator {
     }
   }
 
+  // Generate the HashIndexKey or KeyIndexKey method, which CreateHashIndex()
+  // or CreateKeyIndex() reads the key with.
+  void GenIndexKeyMethod(const FieldDef &field, const std::string &kind) {
+    code_.SetValue("INDEX_KIND", kind);
+    if (IsString(field.value.type)) {
+      code_ += "  const flatbuffers::String *{{INDEX_KIND}}Key() const {";
+      code_ += "    return {{FIELD_NAME}}();";
+    } else {
+      code_.SetValue("KEY_TYPE", GenTypeBasic(field.value.type, false));
+      code_ += "  {{KEY_TYPE}} {{INDEX_KIND}}Key() const {";
+      if (field.value.type.enum_def) {
+        code_ += "    return static_cast<{{KEY_TYPE}}>({{FIELD_NAME}}());";
+      } else {
+        code_ += "    return {{FIELD_NAME}}();";
+      }
+    }
+    code_ += "  }";
+  }
+
+  // Generate a lookup method for a vector field with an index.
+  void GenIndexLookup(const FieldDef &field, const FieldDef &index,
+                      const std::string &kind) {
+    const auto &elem = *field.value.type.struct_def;
+    const FieldDef *key = nullptr;
+    for (auto it = elem.fields.vec.begin(); it != elem.fields.vec.end(); ++it) {
+      if ((*it)->key) key = *it;
+    }
+    FLATBUFFERS_ASSERT(key);  // Guaranteed to exist by parser.
+    code_.SetValue("CPP_NAME", WrapInNameSpace(elem));
+    code_.SetValue("INDEX_NAME", Name(index));
+    code_.SetValue("INDEX_KIND", kind);
+    const auto key_type = IsString(key->value.type)
+                              ? "const char *"
+                              : GenTypeBasic(key->value.type, false) + " ";
+    code_.SetValue("KEY_TYPE", key_type);
+    code_ +=
+        "  const {{CPP_NAME}} *{{FIELD_NAME}}_by_key({{KEY_TYPE}}key) const {";
+    code_ +=
+        "    return flatbuffers::LookupBy{{INDEX_KIND}}({{FIELD_NAME}}(), "
+        "{{INDEX_NAME}}(), key);";
+    code_ += "  }";
+  }
+
   void GenTableUnionAsGetters(const FieldDef &field) {
     const auto &type = field.value.type;
     auto u = type.enum_def;
@@ -2572,6 +2688,71 @@ class CppGenerator : public BaseGenerator {
     return TranslateNameSpace(qualified_name);
   }
 
+  // The attributes that index a vector of tables in another field.
+  static const std::vector<std::string> &IndexAttributes() {
+    static const std::vector<std::string> attributes = { "hash_index",
+                                                         "key_index" };
+    return attributes;
+  }
+
+  // Returns the field holding the index of `field`, if any, and sets `kind`
+  // to the kind of index, as in the names of its functions, e.g. "HashIndex"
+  // for CreateHashIndex().
+  const FieldDef *GetIndexField(const StructDef &struct_def,
+                                const FieldDef &field,
+                                std::string *kind = nullptr) const {
+    const auto &attributes = IndexAttributes();
+    for (auto it = attributes.begin(); it != attributes.end(); ++it) {
+      auto index_attr = field.attributes.Lookup(*it);
+      if (!index_attr) continue;
+      auto index = struct_def.fields.Lookup(index_attr->constant);
+      FLATBUFFERS_ASSERT(index);  // Guaranteed to exist by parser.
+      if (kind) *kind = ConvertCase(*it, Case::kUpperCamel);
+      return index;
+    }
+    return nullptr;
+  }
+
+  // Whether `field` holds the index of another field of `struct_def`.
+  bool IsIndexField(const StructDef &struct_def, const FieldDef &field) const {
+    for (auto it = struct_def.fields.vec.begin();
+         it != struct_def.fields.vec.end(); ++it) {
+      if (GetIndexField(struct_def, **it) == &field) return true;
+    }
+    return false;
+  }
+
+  // Whether vectors of `struct_def` are indexed with `attribute` anywhere, so
+  // it needs e.g. a HashIndexKey() method.
+  bool IsIndexed(const StructDef &struct_def,
+                 const std::string &attribute) const {
+    for (auto it = parser_.structs_.vec.begin();
+         it != parser_.structs_.vec.end(); ++it) {
+      for (auto field_it = (*it)->fields.vec.begin();
+           field_it != (*it)->fields.vec.end(); ++field_it) {
+        const auto &field = **field_it;
+        if (field.attributes.Lookup(attribute) &&
+            field.value.type.struct_def == &struct_def) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  bool UsesIndex(const std::string &attribute) const {
+    for (auto it = parser_.structs_.vec.begin();
+         it != parser_.structs_.vec.end(); ++it) {
+      const auto &struct_def = **it;
+      if (struct_def.generated) continue;
+      for (auto field_it = struct_def.fields.vec.begin();
+           field_it != struct_def.fields.vec.end(); ++field_it) {
+        if ((*field_it)->attributes.Lookup(attribute)) return true;
+      }
+    }
+    return false;
+  }
+
   // Generate an accessor struct, builder structs & function for a table.
   void GenTable(const StructDef &struct_def) {
     if (opts_.generate_object_based_api) { GenNativeTable(struct_def); }
@@ -2657,8 +2838,20 @@ class CppGenerator : public BaseGenerator {
         code_ += "  }";
       }
 
+      std::string index_kind;
+      auto index = GetIndexField(struct_def, field, &index_kind);
+      if (index) { GenIndexLookup(field, *index, index_kind); }
+
       // Generate a comparison function for this field if it is a key.
-      if (field.key) { GenKeyFieldMethods(field); }
+      if (field.key) {
+        GenKeyFieldMethods(field);
+        const auto &attributes = IndexAttributes();
+        for (auto attr = attributes.begin(); attr != attributes.end(); ++attr) {
+          if (IsIndexed(struct_def, *attr)) {
+            GenIndexKeyMethod(field, ConvertCase(*attr, Case::kUpperCamel));
+          }
+        }
+      }
     }
 
     if (opts_.cpp_static_reflection) { GenIndexBasedFieldGetter(struct_def); }
@@ -2673,6 +2866,19 @@ class CppGenerator : public BaseGenerator {
       if (field.deprecated) { continue; }
       GenVerifyCall(field, " &&\n           ");
     }
+    for (auto it = struct_def.fields.vec.begin();
+         it != struct_def.fields.vec.end(); ++it) {
+      const auto &field = **it;
+      std::string index_kind;
+      auto index = GetIndexField(struct_def, field, &index_kind);
+      if (field.deprecated || !index) { continue; }
+      code_.SetValue("NAME", Name(field));
+      code_.SetValue("INDEX_NAME", Name(*index));
+      code_.SetValue("INDEX_KIND", index_kind);
+      code_ +=
+          " &&\n           flatbuffers::Verify{{INDEX_KIND}}(verifier, "
+          "{{NAME}}(), {{INDEX_NAME}}())\\";
+    }
 
     code_ += " &&\n           verifier.EndTable();";
     code_ += "  }";
@@ -2891,7 +3097,8 @@ class CppGenerator : public BaseGenerator {
       for (auto it = struct_def.fields.vec.begin();
            it != struct_def.fields.vec.end(); ++it) {
         const auto &field = **it;
-        if (!field.deprecated) {
+        // Indices are built below, once the indexed vector exists.
+        if (!field.deprecated && !IsIndexField(struct_def, field)) {
           code_.SetValue("FIELD_NAME", Name(field));
           if (IsString(field.value.type)) {
             if (!field.shared) {
@@ -2929,6 +3136,22 @@ class CppGenerator : public BaseGenerator {
           }
         }
       }
+      for (auto it = struct_def.fields.vec.begin();
+           it != struct_def.fields.vec.end(); ++it) {
+        const auto &field = **it;
+        std::string index_kind;
+        auto index = GetIndexField(struct_def, field, &index_kind);
+        if (field.deprecated || !index) { continue; }
+        code_.SetValue("FIELD_NAME", Name(field));
+        code_.SetValue("INDEX_NAME", Name(*index));
+        code_.SetValue("INDEX_KIND", index_kind);
+        code_.SetValue("INDEX_TYPE",
+                       GenTypeBasic(index->value.type.VectorType(), false));
+        code_ += "  auto {{INDEX_NAME}}__ = {{INDEX_NAME}}";
+        code_ += "      ? _fbb.CreateVector<{{INDEX_TYPE}}>(*{{INDEX_NAME}})";
+        code_ += "      : flatbuffers::Create{{INDEX_KIND}}(_fbb, "
+                 "{{FIELD_NAME}}__);";
+      }
       code_ += "  return {{CREATE_NAME}}{{STRUCT_NAME}}(";
       code_ += "      _fbb\\";
       for (auto it = struct_def.fields.vec.begin();
@@ -2948,15 +3171,6 @@ class CppGenerator : public BaseGenerator {
     }
   }
 
-  std::string GenUnionUnpackVal(const FieldDef &afield,
-                                const char *vec_elem_access,
-                                const char *vec_type_access) {
-    auto type_name = WrapInNameSpace(*afield.value.type.enum_def);
-    return type_name + "Union::UnPack(" + "_e" + vec_elem_access + ", " +
-           EscapeKeyword(afield.name + UnionTypeFieldSuffix()) + "()" +
-           vec_type_access + ", _resolver)";
-  }
-
   std::string GenUnpackVal(const Type &type, const std::string &val,
                            bool invector, const FieldDef &afield) {
     switch (type.base_type) {
@@ -2993,12 +3207,6 @@ class CppGenerator : public BaseGenerator {
           return ptype + "(" + val + "->UnPack(_resolver))";
         }
       }
-      case BASE_TYPE_UNION: {
-        return GenUnionUnpackVal(
-            afield, invector ? "->Get(_i)" : "",
-            invector ? ("->GetEnum<" + type.enum_def->name + ">(_i)").c_str()
-                     : "");
-      }
       default: {
         return val;
         break;
@@ -3006,15 +3214,22 @@ class CppGenerator : public BaseGenerator {
     }
   }
 
-  std::string GenUnpackFieldStatement(const FieldDef &field,
-                                      const FieldDef *union_field) {
+  // Whether a string of |field| is unpacked with std::string::assign().
+  bool IsInPlaceString(const FieldDef &field, const Type &type) {
+    return IsString(type) && NativeString(&field) == "std::string";
+  }
+
+  // Whether a table of |field| is stored by value in the object API.
+  static bool IsInlineTable(const FieldDef &field, const Type &type) {
+    return type.base_type == BASE_TYPE_STRUCT && !type.struct_def->fixed &&
+           field.native_inline;
+  }
+
+  std::string GenUnpackFieldStatement(const FieldDef &field) {
     std::string code;
     switch (field.value.type.base_type) {
       case BASE_TYPE_VECTOR: {
-        auto name = Name(field);
-        if (field.value.type.element == BASE_TYPE_UTYPE) {
-          name = StripUnionType(Name(field));
-        }
+        const auto name = Name(field);
         const std::string vector_field = "_o->" + name;
         code += "{ " + vector_field + ".resize(_e->size()); ";
         if (!field.value.type.enum_def && !IsBool(field.value.type.element) &&
@@ -3024,8 +3239,8 @@ class CppGenerator : public BaseGenerator {
           //  - enum types because they have to be explicitly static_cast.
           //  - vectors of bool, since they are a template specialization.
           //  - multiple-byte types due to endianness.
-          code +=
-              "std::copy(_e->begin(), _e->end(), _o->" + name + ".begin()); }";
+          code += "std::copy(_e->begin(), _e->end(), _o->" + name +
+                  ".begin()); } else { " + vector_field + ".resize(0); }";
         } else {
           std::string indexing;
           if (field.value.type.enum_def) {
@@ -3042,10 +3257,7 @@ class CppGenerator : public BaseGenerator {
           //     _o->field.push_back(_e->Get(_i));
           //   }
           auto access =
-              field.value.type.element == BASE_TYPE_UTYPE
-                  ? ".type"
-                  : (field.value.type.element == BASE_TYPE_UNION ? ".value"
-                                                                 : "");
+              field.value.type.element == BASE_TYPE_UNION ? ".value" : "";
 
           code += "for (flatbuffers::uoffset_t _i = 0;";
           code += " _i < _e->size(); _i++) { ";
@@ -3072,6 +3284,18 @@ class CppGenerator : public BaseGenerator {
               // GenTypeNativePtr(cpp_type->constant, &field, true) + "();";
               code += "/* else do nothing */";
             }
+          } else if (field.value.type.element == BASE_TYPE_UNION) {
+            // Generate code that unpacks into the existing union value:
+            //   _o->field[_i].UnPackTo(_e->Get(_i), field_type()->GetEnum(_i));
+            code += "_o->" + name + "[_i].UnPackTo(_e->Get(_i), " +
+                    EscapeKeyword(field.name + UnionTypeFieldSuffix()) +
+                    "()->GetEnum<" + field.value.type.enum_def->name +
+                    ">(_i), _resolver)";
+          } else if (IsInPlaceString(field, field.value.type.VectorType())) {
+            code += "_o->" + name + "[_i].assign(" + indexing + "->c_str(), " +
+                    indexing + "->size())";
+          } else if (IsInlineTable(field, field.value.type.VectorType())) {
+            code += indexing + "->UnPackTo(&_o->" + name + "[_i], _resolver)";
           } else {
             const bool is_pointer = IsVectorOfPointers(field);
             if (is_pointer) {
@@ -3089,20 +3313,12 @@ class CppGenerator : public BaseGenerator {
         }
         break;
       }
-      case BASE_TYPE_UTYPE: {
-        FLATBUFFERS_ASSERT(union_field->value.type.base_type ==
-                           BASE_TYPE_UNION);
-        // Generate code that sets the union type, of the form:
-        //   _o->field.type = _e;
-        code += "_o->" + union_field->name + ".type = _e;";
-        break;
-      }
       case BASE_TYPE_UNION: {
-        // Generate code that sets the union value, of the form:
-        //   _o->field.value = Union::Unpack(_e, field_type(), resolver);
-        code += "_o->" + Name(field) + ".value = ";
-        code += GenUnionUnpackVal(field, "", "");
-        code += ";";
+        // Generate code that sets the union type and value, of the form:
+        //   _o->field.UnPackTo(_e, field_type(), resolver);
+        code += "_o->" + Name(field) + ".UnPackTo(_e, " +
+                EscapeKeyword(field.name + UnionTypeFieldSuffix()) +
+                "(), _resolver); else _o->" + Name(field) + ".Reset();";
         break;
       }
       default: {
@@ -3134,6 +3350,32 @@ class CppGenerator : public BaseGenerator {
 
           const std::string out_field = "_o->" + Name(field);
 
+          if (IsInPlaceString(field, field.value.type)) {
+            // Assign in place, keeping the capacity of the string.
+            code += out_field + ".assign(_e->c_str(), _e->size()); else " +
+                    out_field + ".clear();";
+            break;
+          }
+          // Fields held by value are reset when absent, in case |_o| was
+          // unpacked into before.
+          const std::string reset =
+              " else " + out_field + " = " +
+              GenTypeNative(field.value.type, false, field) + "();";
+          if (IsInlineTable(field, field.value.type)) {
+            code += "_e->UnPackTo(&" + out_field + ", _resolver);" + reset;
+            break;
+          }
+          if (IsStruct(field.value.type) && !field.native_inline &&
+              !field.value.type.struct_def->attributes.Lookup("native_type")) {
+            // Copy into the struct already allocated, if any.
+            code += "{ if (" + out_field + ") { *" + out_field +
+                    " = *_e; } else { " + out_field + " = " +
+                    GenUnpackVal(field.value.type, "_e", false, field) +
+                    "; } } else if (" + out_field + ") { " + out_field +
+                    ".reset(); }";
+            break;
+          }
+
           if (is_pointer) {
             code += "{ if(" + out_field + ") { ";
             code += "_e->UnPackTo(" + out_field + ".get(), _resolver);";
@@ -3141,6 +3383,9 @@ class CppGenerator : public BaseGenerator {
           }
           code += out_field + " = ";
           code += GenUnpackVal(field.value.type, "_e", false, field) + ";";
+          if (IsStruct(field.value.type) && field.native_inline) {
+            code += reset;
+          }
           if (is_pointer) {
             code += " } } else if (" + out_field + ") { " + out_field +
                     ".reset(); }";
@@ -3401,13 +3646,17 @@ class CppGenerator : public BaseGenerator {
            it != struct_def.fields.vec.end(); ++it) {
         const auto &field = **it;
         if (field.deprecated) { continue; }
+        // Union types are unpacked along with their values.
+        if (field.value.type.base_type == BASE_TYPE_UTYPE ||
+            (IsVector(field.value.type) &&
+             field.value.type.element == BASE_TYPE_UTYPE)) {
+          continue;
+        }
 
         // Assign a value from |this| to |_o|.   Values from |this| are stored
         // in a variable |_e| by calling this->field_type().  The value is then
         // assigned to |_o| using the GenUnpackFieldStatement.
-        const bool is_union = field.value.type.base_type == BASE_TYPE_UTYPE;
-        const auto statement =
-            GenUnpackFieldStatement(field, is_union ? *(it + 1) : nullptr);
+        const auto statement = GenUnpackFieldStatement(field);
 
         code_.SetValue("FIELD_NAME", Name(field));
         auto prefix = "  { auto _e = {{FIELD_NAME}}(); ";
@@ -3449,8 +3698,19 @@ class CppGenerator : public BaseGenerator {
               GenVectorForceAlign(field, "_o->" + Name(field) + ".size()");
           if (!force_align_code.empty()) { code_ += "  " + force_align_code; }
         }
+        // Indices are rebuilt below, in case the vector changed.
+        if (IsIndexField(struct_def, field)) { continue; }
         code_ += "  auto _" + Name(field) + " = " + GenCreateParam(field) + ";";
       }
+      for (auto it = struct_def.fields.vec.begin();
+           it != struct_def.fields.vec.end(); ++it) {
+        auto &field = **it;
+        std::string index_kind;
+        auto index = GetIndexField(struct_def, field, &index_kind);
+        if (field.deprecated || !index) { continue; }
+        code_ += "  auto _" + Name(*index) + " = flatbuffers::Create" +
+                 index_kind + "(_fbb, _" + Name(field) + ");";
+      }
       // Need to call "Create" with the struct namespace.
       const auto qualified_create_name =
           struct_def.defined_namespace->GetFullyQualifiedName("Create");
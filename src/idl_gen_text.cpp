@@ -87,7 +87,7 @@ struct JsonPrinter {
       // print as numeric value
     }
 
-    text += NumToString(val);
+    AppendNumToString(val, &text);
     return true;
   }
 
@@ -261,9 +261,11 @@ struct JsonPrinter {
         return true;
       }
     } else {
-      return PrintScalar(
-          table->GetField<T>(fd.value.offset, GetFieldDefault<T>(fd)),
-          fd.value.type, indent);
+      // Only parse the default if it is needed.
+      return PrintScalar(table->CheckField(fd.value.offset)
+                             ? table->GetField<T>(fd.value.offset, 0)
+                             : GetFieldDefault<T>(fd),
+                         fd.value.type, indent);
     }
   }
 
@@ -481,6 +481,27 @@ CheckedError Parser::SkipByteOrderMark() {
   return NoError();
 }
 
+// Returns how many spaces and tabs there are from `s` on, checking 8 at a
+// time.
+static size_t CountBlanks(const char *s, const char *end) {
+  const uint64_t kSpaces = 0x2020202020202020ULL;
+  const uint64_t kTabBits = 0x2929292929292929ULL;  // ' ' ^ '\t'
+  const uint64_t kOnes = 0x0101010101010101ULL;
+  const char *p = s;
+  for (uint64_t word; end - p >= 8; p += 8) {
+    memcpy(&word, p, sizeof(word));
+    // Spaces become 0 and tabs kTabBits, so each byte must have either all
+    // or none of those 3 bits set, and no others.
+    const uint64_t x = word ^ kSpaces;
+    if ((x & ~kTabBits) || ((x >> 3) & kOnes) != (x & kOnes) ||
+        ((x >> 5) & kOnes) != (x & kOnes)) {
+      break;
+    }
+  }
+  while (*p == ' ' || *p == '\t') p++;
+  return static_cast<size_t>(p - s);
+}
+
 CheckedError Parser::Next() {
   doc_comment_.clear();
   bool seen_newline = cursor_ == source_;
@@ -496,7 +517,10 @@ CheckedError Parser::Next() {
         return NoError();
       case ' ':
       case '\r':
-      case '\t': break;
+      case '\t':
+        // Skip the rest of a run of blanks, e.g. indentation, at once.
+        cursor_ += CountBlanks(cursor_, source_end_);
+        break;
       case '\n':
         MarkNewLine();
         seen_newline = true;
@@ -516,6 +540,16 @@ CheckedError Parser::Next() {
         int unicode_high_surrogate = -1;
 
         while (*cursor_ != c) {
+          // Copy the characters up to the next quote, escape or non-ASCII
+          // character at once. PlainAsciiBytes() doesn't stop at single
+          // quotes, so single quoted strings take the slow path.
+          if (c == '\"' && unicode_high_surrogate == -1) {
+            const auto run = PlainAsciiBytes(
+                cursor_, static_cast<size_t>(source_end_ - cursor_));
+            attribute_.append(cursor_, run);
+            cursor_ += run;
+            if (*cursor_ == c) break;
+          }
           if (*cursor_ < ' ' && static_cast<signed char>(*cursor_) >= 0)
             return Error("illegal character in string constant");
           if (*cursor_ == '\\') {
@@ -628,7 +662,7 @@ CheckedError Parser::Next() {
       case '/':
         if (*cursor_ == '/') {
           const char *start = ++cursor_;
-          while (*cursor_ && *cursor_ != '\n' && *cursor_ != '\r') cursor_++;
+          cursor_ += strcspn(cursor_, "\n\r");
           if (*start == '/') {  // documentation comment
             if (!seen_newline)
               return Error(
@@ -3359,6 +3393,7 @@ CheckedError Parser::ParseRoot(const char *source, const char **include_paths,
 
   auto err = CheckPrivateLeak();
   if (err.Check()) return err;
+  ECHECK(CheckIndices());
 
   // Parse JSON object only if the scheme has been parsed.
   if (token_ == '{') { ECHECK(DoParseJson()); }
@@ -3405,6 +3440,50 @@ CheckedError Parser::CheckPrivateLeak() {
   return NoError();
 }
 
+// Only now are the keys of all tables known.
+CheckedError Parser::CheckIndices() {
+  static const struct {
+    const char *attribute;
+    BaseType element;
+    const char *type;
+  } kIndices[] = { { "hash_index", BASE_TYPE_UINT, "[uint]" },
+                   { "key_index", BASE_TYPE_ULONG, "[ulong]" } };
+  for (auto it = structs_.vec.begin(); it != structs_.vec.end(); ++it) {
+    auto &struct_def = **it;
+    for (auto fld_it = struct_def.fields.vec.begin();
+         fld_it != struct_def.fields.vec.end(); ++fld_it) {
+      auto &field = **fld_it;
+      if (field.attributes.Lookup("hash_index") &&
+          field.attributes.Lookup("key_index"))
+        return Error("a field may only have one of hash_index and key_index: " +
+                     field.name);
+      for (size_t i = 0; i < sizeof(kIndices) / sizeof(kIndices[0]); i++) {
+        const std::string attribute = kIndices[i].attribute;
+        auto index_attr = field.attributes.Lookup(attribute);
+        if (!index_attr) continue;
+        if (index_attr->type.base_type != BASE_TYPE_STRING)
+          return Error(attribute +
+                       " attribute must be a string (the index field): " +
+                       field.name);
+        if (!IsVectorOfTable(field.value.type) ||
+            !field.value.type.struct_def->has_key)
+          return Error(attribute +
+                       " attribute may only apply to a vector of tables with "
+                       "a key: " +
+                       field.name);
+        auto index = struct_def.fields.Lookup(index_attr->constant);
+        if (!index || index == &field || index->deprecated ||
+            !IsVector(index->value.type) ||
+            index->value.type.element != kIndices[i].element)
+          return Error(attribute + " of " + field.name + " must name a " +
+                       kIndices[i].type + " field of " + struct_def.name +
+                       ": " + index_attr->constant);
+      }
+    }
+  }
+  return NoError();
+}
+
 CheckedError Parser::CheckPrivatelyLeakedFields(const Definition &def,
                                                 const Definition &value_type) {
   if (!opts.no_leak_private_annotations) return NoError();
@@ -16,6 +16,9 @@
 
 #include "flatbuffers/reflection.h"
 
+#include <map>
+#include <tuple>
+
 #include "flatbuffers/util.h"
 
 // Helper functionality for reflection.
@@ -601,6 +604,239 @@ uint8_t *ResizeAnyVector(const reflection::Schema &schema, uoffset_t newsize,
   return flatbuf->data() + start;
 }
 
+// We can't shrink by less than largest_scalar_t, see ResizeContext.
+static int AlignResizeDelta(int delta) {
+  auto mask = static_cast<int>(sizeof(largest_scalar_t) - 1);
+  return (delta + mask) & ~mask;
+}
+
+void ResizeSession::SetString(const std::string &val, const String *str) {
+  Edit edit;
+  edit.object = static_cast<uoffset_t>(reinterpret_cast<const uint8_t *>(str) -
+                                       flatbuf_->data());
+  edit.old_size = str->size();
+  edit.new_size = static_cast<uoffset_t>(val.size());
+  edit.elem_size = 1;
+  edit.is_string = true;
+  // Bytes go in or out just before the terminator, so shrinking only ever
+  // removes characters of the old string.
+  edit.point = edit.object + static_cast<uoffset_t>(sizeof(uoffset_t)) +
+               edit.old_size;
+  edit.delta = AlignResizeDelta(static_cast<int>(edit.new_size) -
+                                static_cast<int>(edit.old_size));
+  edit.contents = val;
+  edits_.push_back(std::move(edit));
+}
+
+void ResizeSession::ResizeAnyVector(uoffset_t newsize, const VectorOfAny *vec,
+                                    uoffset_t num_elems, uoffset_t elem_size) {
+  Edit edit;
+  edit.object = static_cast<uoffset_t>(reinterpret_cast<const uint8_t *>(vec) -
+                                       flatbuf_->data());
+  edit.old_size = num_elems;
+  edit.new_size = newsize;
+  edit.elem_size = elem_size;
+  edit.is_string = false;
+  edit.point = edit.object + static_cast<uoffset_t>(sizeof(uoffset_t)) +
+               elem_size * num_elems;
+  edit.delta = AlignResizeDelta(
+      (static_cast<int>(newsize) - static_cast<int>(num_elems)) *
+      static_cast<int>(elem_size));
+  edits_.push_back(std::move(edit));
+}
+
+// Where the byte at "pos" ends up once all edits are applied.
+uoffset_t ResizeSession::NewPos(uoffset_t pos) const {
+  return static_cast<uoffset_t>(pos + Shift(PointsUpTo(pos)));
+}
+
+// Number of points at or before "pos".
+size_t ResizeSession::PointsUpTo(uoffset_t pos) const {
+  return static_cast<size_t>(
+      std::upper_bound(points_.begin(), points_.end(), pos) - points_.begin());
+}
+
+// Adjusts the offset between "first" and "second" (in that order in memory)
+// stored at "offsetloc", if any point lies between them.
+template<typename T>
+void ResizeSession::Relocate(uoffset_t first, uoffset_t second,
+                             uoffset_t offsetloc, int direction) {
+  if (second < points_.front() || first >= points_.back()) return;
+  auto before = PointsUpTo(first);
+  if (points_[before] > second) return;
+  auto delta = Shift(PointsUpTo(second)) - Shift(before);
+  auto loc = flatbuf_->data() + offsetloc;
+  WriteScalar<T>(loc, static_cast<T>(ReadScalar<T>(loc) + delta * direction));
+}
+
+// Adjusts the offset at "offsetloc", and returns what it pointed to, or
+// nullptr if it was visited (and so possibly adjusted) already.
+const uint8_t *ResizeSession::RelocateOffset(const uint8_t *offsetloc) {
+  auto buf = flatbuf_->data();
+  auto loc = static_cast<uoffset_t>(offsetloc - buf);
+  auto &visited = visited_[loc / sizeof(uoffset_t)];
+  if (visited) return nullptr;
+  visited = 1;
+  auto ref = loc + ReadScalar<uoffset_t>(offsetloc);
+  Relocate<uoffset_t>(loc, ref, loc, 1);
+  return buf + ref;
+}
+
+void ResizeSession::RelocateVTable(const uint8_t *tableloc) {
+  auto table = static_cast<uoffset_t>(tableloc - flatbuf_->data());
+  auto vtable = table - ReadScalar<soffset_t>(tableloc);
+  if (vtable < table) {
+    Relocate<soffset_t>(vtable, table, table, 1);
+  } else {
+    Relocate<soffset_t>(table, vtable, table, -1);
+  }
+}
+
+const ResizeSession::Edit *ResizeSession::FindVectorEdit(
+    const uint8_t *vec) const {
+  auto object = static_cast<uoffset_t>(vec - flatbuf_->data());
+  auto point = object + static_cast<uoffset_t>(sizeof(uoffset_t)) +
+               ReadScalar<uoffset_t>(vec) * sizeof(uoffset_t);
+  auto it = std::lower_bound(points_.begin(), points_.end(), point);
+  if (it == points_.end() || *it != point) return nullptr;
+  auto &edit = edits_[static_cast<size_t>(it - points_.begin())];
+  return edit.object == object ? &edit : nullptr;
+}
+
+// Like ResizeContext::ResizeTable, but for all points at once.
+void ResizeSession::RelocateTable(const reflection::Object &objectdef,
+                                  const Table *table) {
+  auto tableloc = reinterpret_cast<const uint8_t *>(table);
+  auto pos = static_cast<uoffset_t>(tableloc - flatbuf_->data());
+  auto &visited = visited_[pos / sizeof(uoffset_t)];
+  if (visited) return;  // Table already visited.
+  visited = 1;
+  // Early out: since all fields inside the table must point forwards in
+  // memory, if the last point is before the table only its vtable offset can
+  // change.
+  auto fielddefs = pos < points_.back() ? objectdef.fields() : nullptr;
+  for (uoffset_t i = 0; fielddefs && i < fielddefs->size(); i++) {
+    auto &fielddef = *fielddefs->Get(i);
+    auto base_type = fielddef.type()->base_type();
+    // Ignore scalars.
+    if (base_type <= reflection::Double) continue;
+    // Ignore fields that are not stored.
+    auto offset = table->GetOptionalFieldOffset(fielddef.offset());
+    if (!offset) continue;
+    // Ignore structs.
+    auto subobjectdef = base_type == reflection::Obj
+                            ? schema_.objects()->Get(fielddef.type()->index())
+                            : nullptr;
+    if (subobjectdef && subobjectdef->is_struct()) continue;
+    auto ref = RelocateOffset(tableloc + offset);
+    if (!ref) continue;  // This offset already visited.
+    switch (base_type) {
+      case reflection::Obj: {
+        RelocateTable(*subobjectdef, reinterpret_cast<const Table *>(ref));
+        break;
+      }
+      case reflection::Vector: {
+        auto elem_type = fielddef.type()->element();
+        if (elem_type != reflection::Obj && elem_type != reflection::String)
+          break;
+        auto elemobjectdef =
+            elem_type == reflection::Obj
+                ? schema_.objects()->Get(fielddef.type()->index())
+                : nullptr;
+        if (elemobjectdef && elemobjectdef->is_struct()) break;
+        auto vec = reinterpret_cast<const Vector<uoffset_t> *>(ref);
+        auto size = vec->size();
+        // Elements dropped by a shrinking resize aren't kept.
+        auto edit = FindVectorEdit(ref);
+        if (edit && edit->new_size < size) size = edit->new_size;
+        for (uoffset_t j = 0; j < size; j++) {
+          auto dest = RelocateOffset(vec->Data() + j * sizeof(uoffset_t));
+          if (dest && elemobjectdef) {
+            RelocateTable(*elemobjectdef,
+                          reinterpret_cast<const Table *>(dest));
+          }
+        }
+        break;
+      }
+      case reflection::Union: {
+        RelocateTable(GetUnionType(schema_, objectdef, fielddef, *table),
+                      reinterpret_cast<const Table *>(ref));
+        break;
+      }
+      case reflection::String: break;
+      default: FLATBUFFERS_ASSERT(false);
+    }
+  }
+  // Must do this last, since GetOptionalFieldOffset above still reads this
+  // value.
+  RelocateVTable(tableloc);
+}
+
+void ResizeSession::Apply() {
+  if (edits_.empty()) return;
+  std::sort(edits_.begin(), edits_.end(),
+            [](const Edit &a, const Edit &b) { return a.point < b.point; });
+  auto &buf = *flatbuf_;
+  points_.clear();
+  shifts_.clear();
+  int64_t shift = 0;
+  for (size_t i = 0; i < edits_.size(); i++) {
+    // Only one change per string or vector.
+    FLATBUFFERS_ASSERT(!i || edits_[i - 1].object != edits_[i].object);
+    shift += edits_[i].delta;
+    points_.push_back(edits_[i].point);
+    shifts_.push_back(shift);
+  }
+  // First change all offsets that straddle any of the points, in one walk.
+  visited_.assign(buf.size() / sizeof(uoffset_t), 0);
+  auto root = RelocateOffset(buf.data());
+  RelocateTable(root_table_ ? *root_table_ : *schema_.root_table(),
+                reinterpret_cast<const Table *>(root));
+  // Then move each run of bytes between points straight to where it ends up.
+  // Runs stay in order, so moving those that go down front to back, then
+  // those that go up back to front, never overwrites a run yet to be moved.
+  auto old_size = buf.size();
+  auto new_size = static_cast<size_t>(static_cast<int64_t>(old_size) + shift);
+  if (new_size > old_size) buf.resize(new_size);
+  auto move = [&](size_t i) {
+    auto start = points_[i];
+    // Up to the next point, less any bytes removed there.
+    auto end = i + 1 < points_.size()
+                   ? points_[i + 1] + std::min(edits_[i + 1].delta, 0)
+                   : old_size;
+    memmove(buf.data() + start + shifts_[i], buf.data() + start, end - start);
+  };
+  for (size_t i = 0; i < points_.size(); i++) {
+    if (shifts_[i] < 0) move(i);
+  }
+  for (size_t i = points_.size(); i-- > 0;) {
+    if (shifts_[i] > 0) move(i);
+  }
+  if (new_size < old_size) buf.resize(new_size);
+  // Finally, write the new lengths and contents.
+  for (auto it = edits_.begin(); it != edits_.end(); ++it) {
+    auto object = buf.data() + NewPos(it->object);
+    WriteScalar(object, it->new_size);
+    auto data = object + sizeof(uoffset_t);
+    // The bytes available for the contents, including a string's terminator.
+    // Bytes inserted above are in here too, and not cleared yet.
+    auto avail = static_cast<size_t>(
+        static_cast<int>(it->old_size * it->elem_size) + it->delta +
+        (it->is_string ? 1 : 0));
+    size_t used = std::min(it->old_size, it->new_size) * it->elem_size;
+    if (it->is_string) {
+      used = it->contents.size() + 1;
+      memcpy(data, it->contents.c_str(), used);
+    } else if (!it->contents.empty()) {
+      for (; used < it->new_size * it->elem_size; used += it->elem_size) {
+        memcpy(data + used, it->contents.data(), it->elem_size);
+      }
+    }
+    memset(data + used, 0, avail - used);
+  }
+  edits_.clear();
+}
+
 const uint8_t *AddFlatBuffer(std::vector<uint8_t> &flatbuf,
                              const uint8_t *newbuf, size_t newlen) {
   // Align to sizeof(uoffset_t) past sizeof(largest_scalar_t) since we're
@@ -619,10 +855,319 @@ const uint8_t *AddFlatBuffer(std::vector<uint8_t> &flatbuf,
 
 
 
+namespace {
+
+static uintptr_t Address(const uint8_t *p) {
+  return reinterpret_cast<uintptr_t>(p);
+}
+
+static bool IsAligned(const uint8_t *p, size_t align) {
+  return !(Address(p) & (align - 1));
+}
+
+// The end of a vtable. The verifier allows its size to be less than that of
+// the size field itself.
+static const uint8_t *VTableEnd(const uint8_t *vtable) {
+  return vtable + (std::max)(static_cast<size_t>(ReadScalar<voffset_t>(vtable)),
+                             sizeof(voffset_t));
+}
+
+// The bytes of a table and everything it refers to, as CopyTable() would
+// copy them.
+struct Subtree {
+  struct Span {
+    const uint8_t *start;
+    const uint8_t *end;
+    // Where the offset to it is stored, if it can be copied on its own:
+    // strings, vectors of scalars and structs, and structs in unions.
+    const uint8_t *referrer;
+  };
+  std::vector<Span> spans;
+  // Tables, and their vtables where those aren't next to them.
+  std::vector<std::pair<const uint8_t *, const uint8_t *>> vtables;
+  // The largest alignment of anything in it.
+  size_t align;
+
+  // Whether [start, end) overlaps or touches "span", or is apart from it only
+  // by padding. The builder pads with zeros, fewer than the alignment; other
+  // bytes in between belong to something outside the subtree and mustn't be
+  // copied along with it.
+  bool Near(const Span &span, const uint8_t *start, const uint8_t *end) const {
+    if (start > span.end) return IsPadding(span.end, start);
+    if (end < span.start) return IsPadding(end, span.start);
+    return true;
+  }
+  bool IsPadding(const uint8_t *start, const uint8_t *end) const {
+    if (static_cast<size_t>(end - start) >= align) return false;
+    for (; start < end; start++) {
+      if (*start) return false;
+    }
+    return true;
+  }
+
+  // Adds [start, end), merged into the last span if the two are near and
+  // either couldn't be copied on its own anyway. Most subtrees, having been
+  // built depth first, end up as a handful of spans.
+  void Add(const uint8_t *start, const uint8_t *end, const uint8_t *referrer) {
+    if (!spans.empty()) {
+      auto &last = spans.back();
+      if ((!referrer || !last.referrer) && Near(last, start, end)) {
+        last.start = (std::min)(last.start, start);
+        last.end = (std::max)(last.end, end);
+        last.referrer = nullptr;
+        return;
+      }
+    }
+    spans.push_back({ start, end, referrer });
+  }
+
+  bool CollectTable(const reflection::Schema &schema,
+                    const reflection::Object &objectdef, const Table &table);
+  bool CollectOffset(const reflection::Schema &schema,
+                     reflection::BaseType base_type, int32_t index,
+                     const uint8_t *referrer);
+};
+
+// Collects what the offset stored at "referrer" points to.
+bool Subtree::CollectOffset(const reflection::Schema &schema,
+                            reflection::BaseType base_type, int32_t index,
+                            const uint8_t *referrer) {
+  if (!IsAligned(referrer, sizeof(uoffset_t))) return false;
+  auto p = referrer + ReadScalar<uoffset_t>(referrer);
+  if (base_type == reflection::String) {
+    if (!IsAligned(p, sizeof(uoffset_t))) return false;
+    // Including the terminator.
+    Add(p, p + sizeof(uoffset_t) + ReadScalar<uoffset_t>(p) + 1, referrer);
+    return true;
+  }
+  if (base_type != reflection::Obj) return false;
+  auto &objectdef = *schema.objects()->Get(index);
+  if (!objectdef.is_struct()) {
+    return CollectTable(schema, objectdef,
+                        *reinterpret_cast<const Table *>(p));
+  }
+  if (!IsAligned(p, objectdef.minalign())) return false;
+  align = (std::max)(align, static_cast<size_t>(objectdef.minalign()));
+  Add(p, p + objectdef.bytesize(), referrer);
+  return true;
+}
+
+// Fails on what the schema can't account for, or on anything not aligned in
+// memory as it should be in a buffer.
+bool Subtree::CollectTable(const reflection::Schema &schema,
+                           const reflection::Object &objectdef,
+                           const Table &table) {
+  auto data = reinterpret_cast<const uint8_t *>(&table);
+  auto vtable = table.GetVTable();
+  if (!IsAligned(data, sizeof(uoffset_t)) ||
+      !IsAligned(vtable, sizeof(voffset_t))) {
+    return false;
+  }
+  auto vtsize = ReadScalar<voffset_t>(vtable);
+  // Where the table ends, by its fields. The size in the vtable isn't
+  // checked by the verifier.
+  auto table_end = data + sizeof(soffset_t);
+  // A field this schema doesn't know about may refer to anything.
+  int unknown_fields = 0;
+  for (auto o = FieldIndexToOffset(0); o < vtsize; o += sizeof(voffset_t)) {
+    unknown_fields += ReadScalar<voffset_t>(vtable + o) != 0;
+  }
+  auto fielddefs = objectdef.fields();
+  for (auto it = fielddefs->begin(); it != fielddefs->end(); ++it) {
+    auto &fielddef = **it;
+    auto p = table.GetAddressOf(fielddef.offset());
+    if (!p) continue;
+    unknown_fields--;
+    auto type = fielddef.type();
+    size_t field_size = sizeof(uoffset_t);
+    switch (type->base_type()) {
+      case reflection::String:
+        if (!CollectOffset(schema, reflection::String, 0, p)) return false;
+        break;
+      case reflection::Obj: {
+        auto &subobjectdef = *schema.objects()->Get(type->index());
+        if (!subobjectdef.is_struct()) {
+          if (!CollectOffset(schema, reflection::Obj, type->index(), p))
+            return false;
+          break;
+        }
+        if (!IsAligned(p, subobjectdef.minalign())) return false;
+        align = (std::max)(align, static_cast<size_t>(subobjectdef.minalign()));
+        field_size = subobjectdef.bytesize();
+        break;
+      }
+      case reflection::Union: {
+        auto union_type =
+            table.GetField<uint8_t>(fielddef.offset() - sizeof(voffset_t), 0);
+        auto enumvals = schema.enums()->Get(type->index())->values();
+        auto enumval = enumvals->LookupByKey(union_type);
+        if (!enumval ||
+            !CollectOffset(schema, enumval->union_type()->base_type(),
+                           enumval->union_type()->index(), p)) {
+          return false;
+        }
+        break;
+      }
+      case reflection::Vector: {
+        if (!IsAligned(p, sizeof(uoffset_t))) return false;
+        auto vec = p + ReadScalar<uoffset_t>(p);
+        if (!IsAligned(vec, sizeof(uoffset_t))) return false;
+        auto size = ReadScalar<uoffset_t>(vec);
+        auto elements = vec + sizeof(uoffset_t);
+        auto element = type->element();
+        auto elemobjectdef = element == reflection::Obj
+                                 ? schema.objects()->Get(type->index())
+                                 : nullptr;
+        if (element == reflection::String ||
+            (elemobjectdef && !elemobjectdef->is_struct())) {
+          Add(vec, elements + size * sizeof(uoffset_t), nullptr);
+          for (uoffset_t i = 0; i < size; i++) {
+            if (!CollectOffset(schema, element, type->index(),
+                               elements + i * sizeof(uoffset_t))) {
+              return false;
+            }
+          }
+          break;
+        }
+        // Vectors of unions aren't supported by CopyTable() either.
+        if (element == reflection::Union) return false;
+        size_t element_size = GetTypeSize(element);
+        size_t element_align = element_size;
+        if (elemobjectdef) {
+          element_size = elemobjectdef->bytesize();
+          element_align = elemobjectdef->minalign();
+        }
+        if (!IsAligned(elements, element_align)) return false;
+        align = (std::max)(align, element_align);
+        Add(vec, elements + size * element_size, p);
+        break;
+      }
+      default: {  // Scalars.
+        field_size = GetTypeSize(type->base_type());
+        if (!IsAligned(p, field_size)) return false;
+        align = (std::max)(align, field_size);
+        break;
+      }
+    }
+    table_end = (std::max)(table_end, p + field_size);
+  }
+  Add(data, table_end, nullptr);
+  if (Near(spans.back(), vtable, VTableEnd(vtable))) {
+    Add(vtable, VTableEnd(vtable), nullptr);
+  } else {
+    vtables.push_back(std::make_pair(data, vtable));
+  }
+  return !unknown_fields;
+}
+
+// Pushes [start, end) so that it is aligned in the finished buffer like it is
+// in memory, for alignments up to "align". Returns the offset of "start".
+static uoffset_t PushAligned(FlatBufferBuilder &fbb, const uint8_t *start,
+                             const uint8_t *end, size_t align) {
+  fbb.TrackMinAlign(align);
+  fbb.Pad((align - (fbb.GetSize() + Address(end)) % align) % align);
+  fbb.PushBytes(start, static_cast<size_t>(end - start));
+  return fbb.GetSize();
+}
+
+// Subtrees are usually built in one go, so everything in them sits in one
+// run of bytes, bar padding, vtables shared with earlier tables and strings
+// pooled with earlier ones. Copies that run as is, and the stragglers apart,
+// fixing up the offsets to them. Returns 0 if the subtree is spread out in
+// any other way.
+static uoffset_t RelocateTable(FlatBufferBuilder &fbb,
+                               const reflection::Schema &schema,
+                               const reflection::Object &objectdef,
+                               const Table &table) {
+  Subtree subtree;
+  subtree.align = sizeof(uoffset_t);
+  if (!subtree.CollectTable(schema, objectdef, table)) return 0;
+  auto &spans = subtree.spans;
+  std::sort(spans.begin(), spans.end(),
+            [](const Subtree::Span &a, const Subtree::Span &b) {
+              return a.start < b.start;
+            });
+  // Find the run holding the table.
+  auto root = reinterpret_cast<const uint8_t *>(&table);
+  size_t first = 0;
+  size_t last = 1;
+  Subtree::Span run = spans[0];
+  for (; last < spans.size(); last++) {
+    if (!subtree.Near(run, spans[last].start, spans[last].end)) {
+      if (root < run.end) break;
+      first = last;
+      run = spans[last];
+    }
+    run.end = (std::max)(run.end, spans[last].end);
+  }
+  for (size_t i = 0; i < spans.size(); i++) {
+    if (i == first) i = last;
+    if (i == spans.size()) break;
+    if (!spans[i].referrer) return 0;
+  }
+  // Copy the stragglers first, so they come after the run in the buffer, as
+  // offsets only point forward. Shared ones are copied once.
+  std::vector<std::pair<const uint8_t *, uoffset_t>> offsets;
+  const uint8_t *copied = nullptr;
+  uoffset_t copied_offset = 0;
+  for (size_t i = 0; i < spans.size(); i++) {
+    if (i == first) i = last;
+    if (i == spans.size()) break;
+    if (spans[i].start != copied) {
+      copied = spans[i].start;
+      copied_offset = PushAligned(fbb, copied, spans[i].end, subtree.align);
+    }
+    offsets.push_back(std::make_pair(spans[i].referrer, copied_offset));
+  }
+  const auto num_offsets = offsets.size();
+  for (auto it = subtree.vtables.begin(); it != subtree.vtables.end(); ++it) {
+    auto vtend = VTableEnd(it->second);
+    if (it->second >= run.start && vtend <= run.end) continue;
+    if (it->second != copied) {
+      copied = it->second;
+      copied_offset = PushAligned(fbb, copied, vtend, subtree.align);
+    }
+    offsets.push_back(std::make_pair(it->first, copied_offset));
+  }
+  auto offset = PushAligned(fbb, run.start, run.end, subtree.align);
+  auto buf = fbb.GetCurrentBufferPointer() + fbb.GetSize();
+  auto new_offset = [&](const uint8_t *p) {
+    return offset - static_cast<uoffset_t>(p - run.start);
+  };
+  for (size_t i = 0; i < offsets.size(); i++) {
+    auto referrer = new_offset(offsets[i].first);
+    if (i < num_offsets) {
+      WriteScalar(buf - referrer, referrer - offsets[i].second);
+    } else {  // A table, whose vtable is at a signed offset.
+      WriteScalar(buf - referrer, static_cast<soffset_t>(offsets[i].second) -
+                                      static_cast<soffset_t>(referrer));
+    }
+  }
+  return new_offset(root);
+}
+
+} // namespace
+
+static Offset<const Table *> CopyTableFields(
+    FlatBufferBuilder &fbb, const reflection::Schema &schema,
+    const reflection::Object &objectdef, const Table &table,
+    bool use_string_pooling);
+
 Offset<const Table *> CopyTable(FlatBufferBuilder &fbb,
                                 const reflection::Schema &schema,
                                 const reflection::Object &objectdef,
                                 const Table &table, bool use_string_pooling) {
+  if (!use_string_pooling && !objectdef.is_struct()) {
+    auto offset = RelocateTable(fbb, schema, objectdef, table);
+    if (offset) return offset;
+  }
+  return CopyTableFields(fbb, schema, objectdef, table, use_string_pooling);
+}
+
+static Offset<const Table *> CopyTableFields(
+    FlatBufferBuilder &fbb, const reflection::Schema &schema,
+    const reflection::Object &objectdef, const Table &table,
+    bool use_string_pooling) {
   // Before we can construct the table, we have to first generate any
   // subobjects, and collect their offsets.
   std::vector<uoffset_t> offsets;
@@ -642,16 +1187,18 @@ Offset<const Table *> CopyTable(FlatBufferBuilder &fbb,
       case reflection::Obj: {
         auto &subobjectdef = *schema.objects()->Get(fielddef.type()->index());
         if (!subobjectdef.is_struct()) {
-          offset = CopyTable(fbb, schema, subobjectdef,
-                             *GetFieldT(table, fielddef), use_string_pooling)
+          offset = CopyTableFields(fbb, schema, subobjectdef,
+                                   *GetFieldT(table, fielddef),
+                                   use_string_pooling)
                        .o;
         }
         break;
       }
       case reflection::Union: {
         auto &subobjectdef = GetUnionType(schema, objectdef, fielddef, table);
-        offset = CopyTable(fbb, schema, subobjectdef,
-                           *GetFieldT(table, fielddef), use_string_pooling)
+        offset = CopyTableFields(fbb, schema, subobjectdef,
+                                 *GetFieldT(table, fielddef),
+                                 use_string_pooling)
                      .o;
         break;
       }
@@ -679,8 +1226,9 @@ Offset<const Table *> CopyTable(FlatBufferBuilder &fbb,
             if (!elemobjectdef->is_struct()) {
               std::vector<Offset<const Table *>> elements(vec->size());
               for (uoffset_t i = 0; i < vec->size(); i++) {
-                elements[i] = CopyTable(fbb, schema, *elemobjectdef,
-                                        *vec->Get(i), use_string_pooling);
+                elements[i] = CopyTableFields(fbb, schema, *elemobjectdef,
+                                              *vec->Get(i),
+                                              use_string_pooling);
               }
               offset = fbb.CreateVector(elements).o;
               break;
@@ -762,4 +1310,686 @@ bool VerifySizePrefixed(const reflection::Schema &schema,
                       /*required=*/true);
 }
 
+// ------------------------- CONVERTING -------------------------
+
+namespace {
+
+static bool IsSigned(reflection::BaseType t) {
+  return t == reflection::Byte || t == reflection::Short ||
+         t == reflection::Int || t == reflection::Long;
+}
+
+// Whether every value of "from" is also a value of "to".
+static bool Widens(reflection::BaseType from, reflection::BaseType to) {
+  if (from == to) return true;
+  if (!IsScalar(from) || !IsScalar(to) || to == reflection::Bool) return false;
+  const auto from_size = GetTypeSize(from);
+  const auto to_size = GetTypeSize(to);
+  if (IsFloat(from)) return IsFloat(to) && to_size > from_size;
+  // Floats hold integers of up to 24 (float) or 53 (double) bits exactly.
+  if (IsFloat(to)) return 2 * from_size <= to_size;
+  if (!IsSigned(to)) return !IsSigned(from) && to_size >= from_size;
+  return IsSigned(from) ? to_size >= from_size : to_size > from_size;
+}
+
+// The type of the elements of vectors and arrays, otherwise the type itself.
+static reflection::BaseType ElementType(const reflection::Type &type) {
+  return type.base_type() == reflection::Vector ||
+                 type.base_type() == reflection::Array
+             ? type.element()
+             : type.base_type();
+}
+
+// The field of "from" that "field" of "to" is filled in from.
+static const reflection::Field *MatchField(const reflection::Object &from,
+                                           const reflection::Object &to,
+                                           const reflection::Field &field,
+                                           bool by_name_only) {
+  auto match = from.fields()->LookupByKey(field.name()->c_str());
+  if (match || by_name_only) return match;
+  // Renamed: the field with the same id, if its name is gone from "to".
+  for (auto candidate : *from.fields()) {
+    if (candidate->id() == field.id() &&
+        !to.fields()->LookupByKey(candidate->name()->c_str())) {
+      return candidate;
+    }
+  }
+  return nullptr;
+}
+
+// Whether a value of type "from" could be converted to "to", at a glance.
+static bool Compatible(const reflection::Type &from,
+                       const reflection::Type &to) {
+  if (from.base_type() != to.base_type()) {
+    return IsScalar(to.base_type()) && Widens(from.base_type(), to.base_type());
+  }
+  return from.element() == to.element() ||
+         (IsScalar(to.element()) && Widens(from.element(), to.element()));
+}
+
+static const reflection::Field *UnionTypeField(const reflection::Object &object,
+                                               const reflection::Field &field) {
+  return object.fields()->LookupByKey(
+      (field.name()->str() + UnionTypeFieldSuffix()).c_str());
+}
+
+}  // namespace
+
+// Works out the plans of a SchemaConverter, starting from the root tables.
+struct SchemaConverter::Planner {
+  explicit Planner(SchemaConverter &converter) : c(converter) {}
+
+  size_t PlanObject(const reflection::Object &from,
+                    const reflection::Object &to,
+                    const reflection::Object *parent);
+  size_t PlanUnion(const reflection::Enum &from, const reflection::Enum &to,
+                   const std::string &name);
+  void PlanField(FieldPlan &field, const reflection::Object &from,
+                 const reflection::Object &to, const std::string &name);
+  void PlanElement(FieldPlan &field, reflection::BaseType from_type,
+                   int from_index, reflection::BaseType to_type, int to_index,
+                   const std::string &name);
+  void PlanDefault(FieldPlan &field);
+  bool IsIdentical(const ObjectPlan &plan) const;
+  void FindIdentical();
+
+  void Fail(const std::string &name, const std::string &why) {
+    if (!c.error_.empty()) c.error_ += "\n";
+    c.error_ += name + ": " + why;
+  }
+
+  SchemaConverter &c;
+  std::map<std::tuple<const reflection::Object *, const reflection::Object *,
+                      const reflection::Object *>,
+           size_t>
+      objects;
+  std::map<std::pair<const reflection::Enum *, const reflection::Enum *>,
+           size_t>
+      unions;
+};
+
+size_t SchemaConverter::Planner::PlanObject(const reflection::Object &from,
+                                            const reflection::Object &to,
+                                            const reflection::Object *parent) {
+  auto key = std::make_tuple(&from, &to, parent);
+  auto it = objects.find(key);
+  if (it != objects.end()) return it->second;
+  // Registered before planning the fields, which may refer back to it.
+  const auto index = c.plans_.size();
+  objects[key] = index;
+  ObjectPlan plan;
+  plan.from = &from;
+  plan.to = &to;
+  plan.identical = false;
+  c.plans_.push_back(plan);
+  if (from.is_struct() != to.is_struct()) {
+    Fail(to.name()->str(), "can't convert a struct to a table or vice versa");
+    return index;
+  }
+  std::vector<FieldPlan> fields;
+  std::vector<std::string> missing;
+  for (auto to_field : *to.fields()) {
+    const auto &to_type = *to_field->type();
+    // Union types are filled in along with their unions.
+    if (to_field->deprecated() || ElementType(to_type) == reflection::UType) {
+      continue;
+    }
+    const auto name = to.name()->str() + "." + to_field->name()->str();
+    FieldPlan field = FieldPlan();
+    field.to = to_field;
+    field.from = MatchField(from, to, *to_field, parent != nullptr);
+    if (field.from && parent) {
+      // Only what left "parent" moved into "to", if it still fits.
+      auto stayed = parent->fields()->LookupByKey(field.from->name()->c_str());
+      if ((stayed && !stayed->deprecated()) ||
+          !Compatible(*field.from->type(), to_type)) {
+        field.from = nullptr;
+      }
+    }
+    if (field.from) {
+      PlanField(field, from, to, name);
+      fields.push_back(field);
+      continue;
+    }
+    if (!parent && !to.is_struct() && to_type.base_type() == reflection::Obj) {
+      auto &subobject = *c.to_.objects()->Get(to_type.index());
+      if (!subobject.is_struct()) {
+        field.object = PlanObject(from, subobject, &to);
+        if (!c.plans_[field.object].fields.empty()) {
+          fields.push_back(field);
+          continue;
+        }
+      }
+    }
+    if (to_field->required()) missing.push_back(name);
+  }
+  // A table nothing moved into isn't written.
+  if (!parent || !fields.empty()) {
+    for (auto it = missing.begin(); it != missing.end(); ++it) {
+      Fail(*it, "required, but has no counterpart");
+    }
+  }
+  c.plans_[index].fields = std::move(fields);
+  return index;
+}
+
+size_t SchemaConverter::Planner::PlanUnion(const reflection::Enum &from,
+                                           const reflection::Enum &to,
+                                           const std::string &name) {
+  auto key = std::make_pair(&from, &to);
+  auto it = unions.find(key);
+  if (it != unions.end()) return it->second;
+  const auto index = c.unions_.size();
+  unions[key] = index;
+  c.unions_.push_back(UnionPlan());
+  auto from_values = from.values();
+  std::vector<UnionMember> members(
+      static_cast<size_t>(from_values->Get(from_values->size() - 1)->value()) +
+      1);
+  for (auto from_value : *from_values) {
+    if (!from_value->value()) continue;  // NONE.
+    const reflection::EnumVal *to_value = nullptr;
+    for (auto candidate : *to.values()) {
+      if (candidate->name()->str() == from_value->name()->str()) {
+        to_value = candidate;
+      }
+    }
+    if (!to_value) {
+      Fail(name, "union member " + from_value->name()->str() +
+                     " has no counterpart");
+      continue;
+    }
+    auto &member = members[static_cast<size_t>(from_value->value())];
+    member.type = static_cast<uint8_t>(to_value->value());
+    member.base_type = to_value->union_type()->base_type();
+    if (member.base_type != from_value->union_type()->base_type()) {
+      Fail(name, "union member " + from_value->name()->str() +
+                     " changed type");
+    } else if (member.base_type == reflection::Obj) {
+      member.object =
+          PlanObject(*c.from_.objects()->Get(from_value->union_type()->index()),
+                     *c.to_.objects()->Get(to_value->union_type()->index()),
+                     nullptr);
+    }
+  }
+  c.unions_[index].members = std::move(members);
+  return index;
+}
+
+void SchemaConverter::Planner::PlanField(FieldPlan &field,
+                                         const reflection::Object &from,
+                                         const reflection::Object &to,
+                                         const std::string &name) {
+  const auto &from_type = *field.from->type();
+  const auto &to_type = *field.to->type();
+  const auto base_type = to_type.base_type();
+  if (base_type == reflection::Union ||
+      (base_type == reflection::Vector &&
+       to_type.element() == reflection::Union)) {
+    field.from_type = UnionTypeField(from, *field.from);
+    field.to_type = UnionTypeField(to, *field.to);
+  }
+  if (base_type == reflection::Vector || base_type == reflection::Array) {
+    if (from_type.base_type() != base_type) {
+      Fail(name, std::string("can't convert ") +
+                     reflection::EnumNameBaseType(from_type.base_type()) +
+                     " to " + reflection::EnumNameBaseType(base_type));
+      return;
+    }
+    if (from_type.fixed_length() != to_type.fixed_length()) {
+      Fail(name, "can't change the length of an array");
+      return;
+    }
+    PlanElement(field, from_type.element(), from_type.index(),
+                to_type.element(), to_type.index(), name);
+  } else {
+    PlanElement(field, from_type.base_type(), from_type.index(), base_type,
+                to_type.index(), name);
+    if (IsScalar(base_type)) PlanDefault(field);
+  }
+}
+
+void SchemaConverter::Planner::PlanElement(FieldPlan &field,
+                                           reflection::BaseType from_type,
+                                           int from_index,
+                                           reflection::BaseType to_type,
+                                           int to_index,
+                                           const std::string &name) {
+  if (IsScalar(to_type) ? !Widens(from_type, to_type) : from_type != to_type) {
+    Fail(name, std::string("can't convert ") +
+                   reflection::EnumNameBaseType(from_type) + " to " +
+                   reflection::EnumNameBaseType(to_type));
+    return;
+  }
+  if (to_type == reflection::Obj) {
+    field.object = PlanObject(*c.from_.objects()->Get(from_index),
+                              *c.to_.objects()->Get(to_index), nullptr);
+  } else if (to_type == reflection::Union) {
+    field.union_plan = PlanUnion(*c.from_.enums()->Get(from_index),
+                                 *c.to_.enums()->Get(to_index), name);
+  } else if (IsInteger(to_type) && from_index >= 0 && to_index >= 0) {
+    // Enums, renumbered by name. Values of bit_flags enums are combined, so
+    // they can't be renumbered one by one: their bits have to stay put.
+    const auto &to_enum = *c.to_.enums()->Get(to_index);
+    const bool bit_flags =
+        to_enum.attributes() && to_enum.attributes()->LookupByKey("bit_flags");
+    for (auto from_value : *c.from_.enums()->Get(from_index)->values()) {
+      const reflection::EnumVal *to_value = nullptr;
+      for (auto candidate : *to_enum.values()) {
+        if (candidate->name()->str() == from_value->name()->str()) {
+          to_value = candidate;
+        }
+      }
+      if (!to_value) {
+        Fail(name, "enum value " + from_value->name()->str() +
+                       " has no counterpart");
+      } else if (to_value->value() == from_value->value()) {
+        continue;
+      } else if (bit_flags) {
+        Fail(name, "bit_flags value " + from_value->name()->str() +
+                       " changed bits");
+      } else {
+        field.enum_values.push_back(
+            std::make_pair(from_value->value(), to_value->value()));
+      }
+    }
+  }
+}
+
+void SchemaConverter::Planner::PlanDefault(FieldPlan &field) {
+  // An absent optional scalar stays absent.
+  if (field.from->optional()) return;
+  const auto from_type = field.from->type()->base_type();
+  const auto to_type = field.to->type()->base_type();
+  uint8_t from_default[8] = {};
+  uint8_t to_default[8] = {};
+  if (IsFloat(from_type)) {
+    SetAnyValueF(from_type, from_default, field.from->default_real());
+  } else {
+    SetAnyValueI(from_type, from_default, field.from->default_integer());
+  }
+  if (IsFloat(to_type)) {
+    SetAnyValueF(to_type, to_default, field.to->default_real());
+  } else {
+    SetAnyValueI(to_type, to_default, field.to->default_integer());
+  }
+  memset(field.default_value, 0, sizeof(field.default_value));
+  c.ConvertScalar(field, from_type, from_default, to_type,
+                  field.default_value);
+  field.default_differs =
+      field.to->optional() ||
+      memcmp(field.default_value, to_default, GetTypeSize(to_type)) != 0;
+}
+
+// Whether "plan" can copy its data as is, as far as its own fields go.
+// CopyTable() doesn't handle vectors of unions.
+bool SchemaConverter::Planner::IsIdentical(const ObjectPlan &plan) const {
+  if (plan.from->bytesize() != plan.to->bytesize() ||
+      plan.from->minalign() != plan.to->minalign() ||
+      plan.from->fields()->size() != plan.to->fields()->size()) {
+    return false;
+  }
+  for (auto &field : plan.fields) {
+    if (!field.from || field.from->offset() != field.to->offset() ||
+        field.default_differs || !field.enum_values.empty()) {
+      return false;
+    }
+    const auto &from_type = *field.from->type();
+    const auto &to_type = *field.to->type();
+    if (from_type.base_type() != to_type.base_type() ||
+        from_type.element() != to_type.element() ||
+        (to_type.base_type() == reflection::Vector &&
+         to_type.element() == reflection::Union)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void SchemaConverter::Planner::FindIdentical() {
+  for (auto &plan : c.plans_) plan.identical = IsIdentical(plan);
+  for (auto &union_plan : c.unions_) {
+    union_plan.identical = true;
+    for (size_t type = 0; type < union_plan.members.size(); type++) {
+      const auto &member = union_plan.members[type];
+      if (member.type && member.type != type) union_plan.identical = false;
+      // CopyTable() only handles unions of tables.
+      if (member.type && (member.base_type != reflection::Obj ||
+                          c.plans_[member.object].to->is_struct())) {
+        union_plan.identical = false;
+      }
+    }
+  }
+  // Then only if everything they refer to is too.
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (auto &plan : c.plans_) {
+      if (!plan.identical) continue;
+      for (auto &field : plan.fields) {
+        const auto type = ElementType(*field.to->type());
+        if ((type == reflection::Obj && !c.plans_[field.object].identical) ||
+            (type == reflection::Union &&
+             !c.unions_[field.union_plan].identical)) {
+          plan.identical = false;
+          changed = true;
+        }
+      }
+    }
+    for (auto &union_plan : c.unions_) {
+      if (!union_plan.identical) continue;
+      for (auto &member : union_plan.members) {
+        if (member.base_type == reflection::Obj &&
+            !c.plans_[member.object].identical) {
+          union_plan.identical = false;
+          changed = true;
+        }
+      }
+    }
+  }
+}
+
+SchemaConverter::SchemaConverter(const reflection::Schema &from,
+                                 const reflection::Schema &to)
+    : from_(from), to_(to) {
+  if (!from.root_table() || !to.root_table()) {
+    error_ = "both schemas need a root_type";
+    return;
+  }
+  Planner planner(*this);
+  planner.PlanObject(*from.root_table(), *to.root_table(), nullptr);
+  planner.FindIdentical();
+}
+
+// What a conversion needs besides the builder.
+struct SchemaConverter::Context {
+  explicit Context(FlatBufferBuilder &builder) : fbb(builder) {}
+
+  FlatBufferBuilder &fbb;
+  // The offsets of the subobjects of the tables being converted.
+  std::vector<uoffset_t> offsets;
+  std::vector<uint8_t> scratch;  // A struct being converted.
+};
+
+Offset<const Table *> SchemaConverter::ConvertTable(FlatBufferBuilder &fbb,
+                                                    const Table &root) const {
+  FLATBUFFERS_ASSERT(error_.empty());
+  Context ctx(fbb);
+  return ConvertTable(ctx, 0, root);
+}
+
+void SchemaConverter::Convert(FlatBufferBuilder &fbb,
+                              const uint8_t *buf) const {
+  auto file_ident = to_.file_ident();
+  fbb.Finish(ConvertTable(fbb, *GetAnyRoot(buf)),
+             file_ident && file_ident->size() ? file_ident->c_str() : nullptr);
+}
+
+void SchemaConverter::ConvertScalar(const FieldPlan &field,
+                                    reflection::BaseType from_type,
+                                    const uint8_t *from,
+                                    reflection::BaseType to_type,
+                                    uint8_t *to) const {
+  if (IsFloat(to_type)) {
+    SetAnyValueF(to_type, to, GetAnyValueF(from_type, from));
+    return;
+  }
+  auto value = GetAnyValueI(from_type, from);
+  auto renumbered = std::lower_bound(
+      field.enum_values.begin(), field.enum_values.end(),
+      std::make_pair(value, std::numeric_limits<int64_t>::min()));
+  if (renumbered != field.enum_values.end() && renumbered->first == value) {
+    value = renumbered->second;
+  }
+  SetAnyValueI(to_type, to, value);
+}
+
+void SchemaConverter::ConvertStruct(size_t plan_index, const uint8_t *from,
+                                    uint8_t *to) const {
+  const auto &plan = plans_[plan_index];
+  if (plan.identical) {
+    memcpy(to, from, plan.to->bytesize());
+    return;
+  }
+  for (auto &field : plan.fields) {
+    const auto from_type = ElementType(*field.from->type());
+    const auto to_type = ElementType(*field.to->type());
+    auto src = from + field.from->offset();
+    auto dst = to + field.to->offset();
+    const auto count = std::max<uint16_t>(field.to->type()->fixed_length(), 1);
+    for (uint16_t i = 0; i < count; i++) {
+      if (to_type == reflection::Obj) {
+        ConvertStruct(field.object, src, dst);
+        src += plans_[field.object].from->bytesize();
+        dst += plans_[field.object].to->bytesize();
+      } else {
+        ConvertScalar(field, from_type, src, to_type, dst);
+        src += GetTypeSize(from_type);
+        dst += GetTypeSize(to_type);
+      }
+    }
+  }
+}
+
+uoffset_t SchemaConverter::PushStruct(Context &ctx, size_t plan,
+                                      const uint8_t *from) const {
+  const auto &to = *plans_[plan].to;
+  ctx.fbb.Align(to.minalign());
+  if (plans_[plan].identical) {
+    ctx.fbb.PushBytes(from, to.bytesize());
+  } else {
+    ctx.scratch.assign(to.bytesize(), 0);
+    ConvertStruct(plan, from, ctx.scratch.data());
+    ctx.fbb.PushBytes(ctx.scratch.data(), to.bytesize());
+  }
+  return ctx.fbb.GetSize();
+}
+
+uoffset_t SchemaConverter::ConvertUnion(Context &ctx,
+                                        const UnionMember &member,
+                                        const void *value) const {
+  switch (member.base_type) {
+    case reflection::String:
+      return ctx.fbb.CreateString(reinterpret_cast<const String *>(value)).o;
+    case reflection::Obj:
+      return plans_[member.object].to->is_struct()
+                 ? PushStruct(ctx, member.object,
+                              reinterpret_cast<const uint8_t *>(value))
+                 : ConvertTable(ctx, member.object,
+                                *reinterpret_cast<const Table *>(value));
+    default: return 0;
+  }
+}
+
+uoffset_t SchemaConverter::ConvertVector(Context &ctx, const FieldPlan &field,
+                                         const Table &table) const {
+  auto &fbb = ctx.fbb;
+  const auto from_type = field.from->type()->element();
+  const auto to_type = field.to->type()->element();
+  auto vec = table.GetPointer<const VectorOfAny *>(field.from->offset());
+  const auto size = vec->size();
+  const auto data = vec->Data();
+  const ObjectPlan *object =
+      to_type == reflection::Obj ? &plans_[field.object] : nullptr;
+  if (to_type == reflection::String || to_type == reflection::Union ||
+      (object && !object->to->is_struct())) {
+    auto elements = reinterpret_cast<const Vector<Offset<void>> *>(vec);
+    auto types = field.from_type ? table.GetPointer<const Vector<uint8_t> *>(
+                                       field.from_type->offset())
+                                 : nullptr;
+    const auto first = ctx.offsets.size();
+    for (uoffset_t i = 0; i < size; i++) {
+      uoffset_t offset = 0;
+      auto element = elements->Get(i);
+      if (to_type == reflection::String) {
+        offset = fbb.CreateString(reinterpret_cast<const String *>(element)).o;
+      } else if (object) {
+        offset = ConvertTable(ctx, field.object,
+                              *reinterpret_cast<const Table *>(element));
+      } else {
+        const auto &members = unions_[field.union_plan].members;
+        const uint8_t type = types && i < types->size() ? types->Get(i) : 0;
+        if (type < members.size() && members[type].type) {
+          offset = ConvertUnion(ctx, members[type], element);
+        }
+      }
+      ctx.offsets.push_back(offset);
+    }
+    fbb.StartVector(size, sizeof(uoffset_t), sizeof(uoffset_t));
+    for (auto i = size; i > 0;) {
+      const auto offset = ctx.offsets[first + --i];
+      if (offset) {
+        fbb.PushElement(Offset<void>(offset));
+      } else {  // Unknown union member.
+        fbb.PushElement<uoffset_t>(0);
+      }
+    }
+    ctx.offsets.resize(first);
+    return fbb.EndVector(size);
+  }
+  // Scalars and structs.
+  const auto from_size =
+      object ? object->from->bytesize() : GetTypeSize(from_type);
+  const auto to_size = object ? object->to->bytesize() : GetTypeSize(to_type);
+  fbb.StartVector(size, to_size, object ? object->to->minalign() : to_size);
+  if (object ? object->identical
+             : from_type == to_type && field.enum_values.empty()) {
+    fbb.PushBytes(data, size * to_size);
+  } else {
+    ctx.scratch.resize(to_size);
+    for (auto i = size; i > 0;) {
+      auto element = data + --i * from_size;
+      if (object) {
+        std::fill(ctx.scratch.begin(), ctx.scratch.end(), 0);
+        ConvertStruct(field.object, element, ctx.scratch.data());
+      } else {
+        ConvertScalar(field, from_type, element, to_type, ctx.scratch.data());
+      }
+      fbb.PushBytes(ctx.scratch.data(), to_size);
+    }
+  }
+  return fbb.EndVector(size);
+}
+
+uoffset_t SchemaConverter::ConvertTable(Context &ctx, size_t plan_index,
+                                        const Table &table) const {
+  const auto &plan = plans_[plan_index];
+  auto &fbb = ctx.fbb;
+  if (plan.identical) return CopyTable(fbb, from_, *plan.from, table).o;
+  // Before we can construct the table, we have to first generate any
+  // subobjects, and collect their offsets: one per field, plus one for the
+  // new type (of a union) or types (of a vector of unions).
+  auto is_offset = [&](const FieldPlan &field) {
+    switch (field.to->type()->base_type()) {
+      case reflection::String:
+      case reflection::Vector:
+      case reflection::Union: return true;
+      case reflection::Obj: return !plans_[field.object].to->is_struct();
+      default: return false;
+    }
+  };
+  const auto first = ctx.offsets.size();
+  for (auto &field : plan.fields) {
+    if (!is_offset(field)) continue;
+    const auto &to_type = *field.to->type();
+    const auto base_type = to_type.base_type();
+    uoffset_t offset = 0;
+    uoffset_t type = 0;
+    if (!field.from) {  // Moved into a new table.
+      bool present = field.to->required();
+      for (auto &moved : plans_[field.object].fields) {
+        present = present || table.CheckField(moved.from->offset());
+      }
+      if (present) offset = ConvertTable(ctx, field.object, table);
+    } else if (table.CheckField(field.from->offset())) {
+      switch (base_type) {
+        case reflection::String:
+          offset = fbb.CreateString(GetFieldS(table, *field.from)).o;
+          break;
+        case reflection::Obj:
+          offset =
+              ConvertTable(ctx, field.object, *GetFieldT(table, *field.from));
+          break;
+        case reflection::Union: {
+          const auto &members = unions_[field.union_plan].members;
+          const auto from_type =
+              table.GetField<uint8_t>(field.from_type->offset(), 0);
+          if (from_type < members.size() && members[from_type].type) {
+            type = members[from_type].type;
+            offset = ConvertUnion(
+                ctx, members[from_type],
+                table.GetPointer<const uint8_t *>(field.from->offset()));
+          }
+          break;
+        }
+        default: {  // Vectors.
+          if (to_type.element() == reflection::Union) {
+            std::vector<uint8_t> types;
+            auto from_types = table.GetPointer<const Vector<uint8_t> *>(
+                field.from_type->offset());
+            const auto &members = unions_[field.union_plan].members;
+            for (uoffset_t i = 0; from_types && i < from_types->size(); i++) {
+              const auto from_type = from_types->Get(i);
+              types.push_back(from_type < members.size()
+                                  ? members[from_type].type
+                                  : 0);
+            }
+            type = fbb.CreateVector(types).o;
+          }
+          offset = ConvertVector(ctx, field, table);
+          break;
+        }
+      }
+    }
+    ctx.offsets.push_back(offset);
+    if (base_type == reflection::Union ||
+        (base_type == reflection::Vector &&
+         to_type.element() == reflection::Union)) {
+      ctx.offsets.push_back(type);
+    }
+  }
+  // Now we can build the actual table from either offsets or scalar data.
+  auto start = fbb.StartTable();
+  auto next = first;
+  for (auto &field : plan.fields) {
+    const auto &to_type = *field.to->type();
+    const auto base_type = to_type.base_type();
+    const bool present = field.from && table.CheckField(field.from->offset());
+    if (is_offset(field)) {
+      const auto offset = ctx.offsets[next++];
+      if (offset) fbb.AddOffset(field.to->offset(), Offset<void>(offset));
+      if (base_type == reflection::Union) {
+        const auto type = static_cast<uint8_t>(ctx.offsets[next++]);
+        if (offset) fbb.AddElement(field.to_type->offset(), type);
+      } else if (to_type.element() == reflection::Union) {
+        const auto types = ctx.offsets[next++];
+        if (types) fbb.AddOffset(field.to_type->offset(), Offset<void>(types));
+      }
+    } else if (base_type == reflection::Obj) {  // Structs.
+      if (present) {
+        PushStruct(ctx, field.object,
+                   table.GetStruct<const uint8_t *>(field.from->offset()));
+        fbb.TrackField(field.to->offset(), fbb.GetSize());
+      }
+    } else {  // Scalars.
+      const auto size = GetTypeSize(base_type);
+      uint8_t value[8];
+      if (present) {
+        ConvertScalar(field, field.from->type()->base_type(),
+                      table.GetAddressOf(field.from->offset()), base_type,
+                      value);
+      } else if (field.default_differs) {
+        memcpy(value, field.default_value, size);
+      } else {
+        continue;
+      }
+      fbb.Align(size);
+      fbb.PushBytes(value, size);
+      fbb.TrackField(field.to->offset(), fbb.GetSize());
+    }
+  }
+  FLATBUFFERS_ASSERT(next == ctx.offsets.size());
+  ctx.offsets.resize(first);
+  return fbb.EndTable(start);
+}
+
 }  // namespace flatbuffers
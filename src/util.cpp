@@ -41,6 +41,15 @@
 #  include <winbase.h>
 #  undef interface  // This is also important because of reasons
 #endif
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+#  define FLATBUFFERS_WIN32_MAPPING 1
+#elif defined(__unix__) || defined(__APPLE__) || defined(__CYGWIN__)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <unistd.h>
+#  define FLATBUFFERS_POSIX_MAPPING 1
+#endif
 // clang-format on
 
 #include "flatbuffers/util.h"
@@ -53,6 +62,7 @@
 #include <functional>
 
 #include "flatbuffers/base.h"
+#include "flatbuffers/mapped_file.h"
 
 namespace flatbuffers {
 
@@ -249,6 +259,124 @@ bool SaveFile(const char *name, const char *buf, size_t len, bool binary) {
   return !ofs.bad();
 }
 
+bool MappedFile::Open(const char *name) {
+  Close();
+  // A custom loader may not read from the file system, so honor it.
+  if (g_load_file_function == LoadFileRaw && !DirExists(name)) {
+    // clang-format off
+    #if defined(FLATBUFFERS_WIN32_MAPPING)
+      HANDLE file = CreateFileA(name, GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+      if (file == INVALID_HANDLE_VALUE) return false;
+      LARGE_INTEGER size;
+      HANDLE mapping = nullptr;
+      const bool ok = GetFileSizeEx(file, &size) != 0;
+      // Empty files can't be mapped, they are read (as nothing) below.
+      if (ok && size.QuadPart > 0) {
+        mapping =
+            CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      }
+      CloseHandle(file);
+      if (!ok) return false;
+      if (mapping) {
+        auto view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!view) {
+          CloseHandle(mapping);
+          return false;
+        }
+        data_ = static_cast<const uint8_t *>(view);
+        size_ = static_cast<size_t>(size.QuadPart);
+        mapping_ = mapping;
+        return true;
+      }
+    #elif defined(FLATBUFFERS_POSIX_MAPPING)
+      const int fd = open(name, O_RDONLY);
+      if (fd < 0) return false;
+      struct stat file_info;
+      void *view = MAP_FAILED;
+      const bool ok = fstat(fd, &file_info) == 0;
+      // Empty files and pipes can't be mapped, they are read below.
+      if (ok && S_ISREG(file_info.st_mode) && file_info.st_size > 0) {
+        view = mmap(nullptr, static_cast<size_t>(file_info.st_size),
+                    PROT_READ, MAP_PRIVATE, fd, 0);
+      }
+      close(fd);
+      if (!ok) return false;
+      if (view != MAP_FAILED) {
+        data_ = static_cast<const uint8_t *>(view);
+        size_ = static_cast<size_t>(file_info.st_size);
+        mapping_ = view;
+        return true;
+      }
+    #endif
+    // clang-format on
+  }
+  if (!LoadFile(name, true, &contents_)) return false;
+  data_ = reinterpret_cast<const uint8_t *>(contents_.data());
+  size_ = contents_.size();
+  return true;
+}
+
+void MappedFile::Close() {
+  if (mapping_) {
+    // clang-format off
+    #if defined(FLATBUFFERS_WIN32_MAPPING)
+      UnmapViewOfFile(data_);
+      CloseHandle(static_cast<HANDLE>(mapping_));
+    #elif defined(FLATBUFFERS_POSIX_MAPPING)
+      munmap(mapping_, size_);
+    #endif
+    // clang-format on
+  }
+  data_ = nullptr;
+  size_ = 0;
+  mapping_ = nullptr;
+  contents_.clear();
+  verified_ = kNotVerified;
+}
+
+bool MappedFile::Advise(Advice advice) const {
+  if (!mapping_) return false;
+  // clang-format off
+  #if defined(FLATBUFFERS_POSIX_MAPPING)
+    int flag = MADV_NORMAL;
+    switch (advice) {
+      case kAdviceNormal: flag = MADV_NORMAL; break;
+      case kAdviceSequential: flag = MADV_SEQUENTIAL; break;
+      case kAdviceRandom: flag = MADV_RANDOM; break;
+      case kAdviceWillNeed: flag = MADV_WILLNEED; break;
+      case kAdviceHugePages:
+        #ifdef MADV_HUGEPAGE
+          flag = MADV_HUGEPAGE;
+          break;
+        #else
+          return false;
+        #endif
+    }
+    return madvise(mapping_, size_, flag) == 0;
+  #else
+    // Windows has no equivalent of these for file mappings.
+    return advice == kAdviceNormal;
+  #endif
+  // clang-format on
+}
+
+void MappedFile::Swap(MappedFile &other) {
+  std::swap(data_, other.data_);
+  std::swap(size_, other.size_);
+  std::swap(mapping_, other.mapping_);
+  std::swap(contents_, other.contents_);
+  std::swap(verified_, other.verified_);
+  // Contents read into a string may have been stored inside the string
+  // object, and moved with it.
+  if (data_ && !mapping_) {
+    data_ = reinterpret_cast<const uint8_t *>(contents_.data());
+  }
+  if (other.data_ && !other.mapping_) {
+    other.data_ = reinterpret_cast<const uint8_t *>(other.contents_.data());
+  }
+}
+
 // We internally store paths in posix format ('/'). Paths supplied
 // by the user should go through PosixPath to ensure correct behavior
 // on Windows when paths are string-compared.
@@ -308,7 +308,7 @@ inline OuterLargeT *OuterLarge::UnPack(const flatbuffers::resolver_function_t *_
 inline void OuterLarge::UnPackTo(OuterLargeT *_o, const flatbuffers::resolver_function_t *_resolver) const {
   (void)_o;
   (void)_resolver;
-  { auto _e = large(); if (_e) _o->large = flatbuffers::unique_ptr<BadAlignmentLarge>(new BadAlignmentLarge(*_e)); }
+  { auto _e = large(); if (_e) { if (_o->large) { *_o->large = *_e; } else { _o->large = flatbuffers::unique_ptr<BadAlignmentLarge>(new BadAlignmentLarge(*_e)); } } else if (_o->large) { _o->large.reset(); } }
 }
 
 inline flatbuffers::Offset<OuterLarge> OuterLarge::Pack(flatbuffers::FlatBufferBuilder &_fbb, const OuterLargeT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
@@ -494,4 +494,16 @@ inline flatbuffers::unique_ptr<BadAlignmentRootT> UnPackSizePrefixedBadAlignment
   return flatbuffers::unique_ptr<BadAlignmentRootT>(GetSizePrefixedBadAlignmentRoot(buf)->UnPack(res));
 }
 
+inline void UnPackToBadAlignmentRoot(
+    const void *buf, BadAlignmentRootT *_o,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  GetBadAlignmentRoot(buf)->UnPackTo(_o, res);
+}
+
+inline void UnPackToSizePrefixedBadAlignmentRoot(
+    const void *buf, BadAlignmentRootT *_o,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  GetSizePrefixedBadAlignmentRoot(buf)->UnPackTo(_o, res);
+}
+
 #endif  // FLATBUFFERS_GENERATED_ALIGNMENTTEST_H_
@@ -360,7 +360,7 @@ inline ArrayTableT *ArrayTable::UnPack(const flatbuffers::resolver_function_t *_
 inline void ArrayTable::UnPackTo(ArrayTableT *_o, const flatbuffers::resolver_function_t *_resolver) const {
   (void)_o;
   (void)_resolver;
-  { auto _e = a(); if (_e) _o->a = flatbuffers::unique_ptr<MyGame::Example::ArrayStruct>(new MyGame::Example::ArrayStruct(*_e)); }
+  { auto _e = a(); if (_e) { if (_o->a) { *_o->a = *_e; } else { _o->a = flatbuffers::unique_ptr<MyGame::Example::ArrayStruct>(new MyGame::Example::ArrayStruct(*_e)); } } else if (_o->a) { _o->a.reset(); } }
 }
 
 inline flatbuffers::Offset<ArrayTable> ArrayTable::Pack(flatbuffers::FlatBufferBuilder &_fbb, const ArrayTableT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
@@ -533,6 +533,18 @@ inline flatbuffers::unique_ptr<MyGame::Example::ArrayTableT> UnPackSizePrefixedA
   return flatbuffers::unique_ptr<MyGame::Example::ArrayTableT>(GetSizePrefixedArrayTable(buf)->UnPack(res));
 }
 
+inline void UnPackToArrayTable(
+    const void *buf, MyGame::Example::ArrayTableT *_o,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  GetArrayTable(buf)->UnPackTo(_o, res);
+}
+
+inline void UnPackToSizePrefixedArrayTable(
+    const void *buf, MyGame::Example::ArrayTableT *_o,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  GetSizePrefixedArrayTable(buf)->UnPackTo(_o, res);
+}
+
 }  // namespace Example
 }  // namespace MyGame
 
@@ -106,6 +106,7 @@ struct CharacterUnion {
   void Reset();
 
   static void *UnPack(const void *obj, Character type, const flatbuffers::resolver_function_t *resolver);
+  void UnPackTo(const void *obj, Character obj_type, const flatbuffers::resolver_function_t *resolver);
   flatbuffers::Offset<void> Pack(flatbuffers::FlatBufferBuilder &_fbb, const flatbuffers::rehasher_function_t *_rehasher = nullptr) const;
 
   AttackerT *AsMuLan() {
@@ -246,6 +247,7 @@ struct GadgetUnion {
   }
 
   static void *UnPack(const void *obj, Gadget type, const flatbuffers::resolver_function_t *resolver);
+  void UnPackTo(const void *obj, Gadget obj_type, const flatbuffers::resolver_function_t *resolver);
   flatbuffers::Offset<void> Pack(flatbuffers::FlatBufferBuilder &_fbb, const flatbuffers::rehasher_function_t *_rehasher = nullptr) const;
 
   FallingTub *AsFallingTub() {
@@ -765,10 +767,8 @@ inline MovieT *Movie::UnPack(const flatbuffers::resolver_function_t *_resolver)
 inline void Movie::UnPackTo(MovieT *_o, const flatbuffers::resolver_function_t *_resolver) const {
   (void)_o;
   (void)_resolver;
-  { auto _e = main_character_type(); _o->main_character.type = _e; }
-  { auto _e = main_character(); if (_e) _o->main_character.value = CharacterUnion::UnPack(_e, main_character_type(), _resolver); }
-  { auto _e = characters_type(); if (_e) { _o->characters.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->characters[_i].type = static_cast<Character>(_e->Get(_i)); } } else { _o->characters.resize(0); } }
-  { auto _e = characters(); if (_e) { _o->characters.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->characters[_i].value = CharacterUnion::UnPack(_e->Get(_i), characters_type()->GetEnum<Character>(_i), _resolver); } } else { _o->characters.resize(0); } }
+  { auto _e = main_character(); if (_e) _o->main_character.UnPackTo(_e, main_character_type(), _resolver); else _o->main_character.Reset(); }
+  { auto _e = characters(); if (_e) { _o->characters.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->characters[_i].UnPackTo(_e->Get(_i), characters_type()->GetEnum<Character>(_i), _resolver); } } else { _o->characters.resize(0); } }
 }
 
 inline flatbuffers::Offset<Movie> Movie::Pack(flatbuffers::FlatBufferBuilder &_fbb, const MovieT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
@@ -864,6 +864,48 @@ inline void *CharacterUnion::UnPack(const void *obj, Character type, const flatb
   }
 }
 
+inline void CharacterUnion::UnPackTo(const void *obj, Character obj_type, const flatbuffers::resolver_function_t *resolver) {
+  if (!obj || obj_type != type || !value) {
+    Reset();
+    if (obj) value = UnPack(obj, obj_type, resolver);
+    type = obj_type;
+    return;
+  }
+  switch (type) {
+    case Character::MuLan: {
+      auto ptr = reinterpret_cast<const Attacker *>(obj);
+      ptr->UnPackTo(reinterpret_cast<AttackerT *>(value), resolver);
+      break;
+    }
+    case Character::Rapunzel: {
+      auto ptr = reinterpret_cast<const Rapunzel *>(obj);
+      *reinterpret_cast<Rapunzel *>(value) = *ptr;
+      break;
+    }
+    case Character::Belle: {
+      auto ptr = reinterpret_cast<const BookReader *>(obj);
+      *reinterpret_cast<BookReader *>(value) = *ptr;
+      break;
+    }
+    case Character::BookFan: {
+      auto ptr = reinterpret_cast<const BookReader *>(obj);
+      *reinterpret_cast<BookReader *>(value) = *ptr;
+      break;
+    }
+    case Character::Other: {
+      auto ptr = reinterpret_cast<const flatbuffers::String *>(obj);
+      reinterpret_cast<std::string *>(value)->assign(ptr->c_str(), ptr->size());
+      break;
+    }
+    case Character::Unused: {
+      auto ptr = reinterpret_cast<const flatbuffers::String *>(obj);
+      reinterpret_cast<std::string *>(value)->assign(ptr->c_str(), ptr->size());
+      break;
+    }
+    default: break;
+  }
+}
+
 inline flatbuffers::Offset<void> CharacterUnion::Pack(flatbuffers::FlatBufferBuilder &_fbb, const flatbuffers::rehasher_function_t *_rehasher) const {
   (void)_rehasher;
   switch (type) {
@@ -1007,6 +1049,28 @@ inline void *GadgetUnion::UnPack(const void *obj, Gadget type, const flatbuffers
   }
 }
 
+inline void GadgetUnion::UnPackTo(const void *obj, Gadget obj_type, const flatbuffers::resolver_function_t *resolver) {
+  if (!obj || obj_type != type || !value) {
+    Reset();
+    if (obj) value = UnPack(obj, obj_type, resolver);
+    type = obj_type;
+    return;
+  }
+  switch (type) {
+    case Gadget::FallingTub: {
+      auto ptr = reinterpret_cast<const FallingTub *>(obj);
+      *reinterpret_cast<FallingTub *>(value) = *ptr;
+      break;
+    }
+    case Gadget::HandFan: {
+      auto ptr = reinterpret_cast<const HandFan *>(obj);
+      ptr->UnPackTo(reinterpret_cast<HandFanT *>(value), resolver);
+      break;
+    }
+    default: break;
+  }
+}
+
 inline flatbuffers::Offset<void> GadgetUnion::Pack(flatbuffers::FlatBufferBuilder &_fbb, const flatbuffers::rehasher_function_t *_rehasher) const {
   (void)_rehasher;
   switch (type) {
@@ -1260,4 +1324,16 @@ inline std::unique_ptr<MovieT> UnPackSizePrefixedMovie(
   return std::unique_ptr<MovieT>(GetSizePrefixedMovie(buf)->UnPack(res));
 }
 
+inline void UnPackToMovie(
+    const void *buf, MovieT *_o,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  GetMovie(buf)->UnPackTo(_o, res);
+}
+
+inline void UnPackToSizePrefixedMovie(
+    const void *buf, MovieT *_o,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  GetSizePrefixedMovie(buf)->UnPackTo(_o, res);
+}
+
 #endif  // FLATBUFFERS_GENERATED_UNIONVECTOR_H_
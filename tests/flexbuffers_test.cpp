@@ -1,7 +1,10 @@
 #include "flexbuffers_test.h"
 
+#include <algorithm>
+
 #include "flatbuffers/flexbuffers.h"
 #include "flatbuffers/idl.h"
+#include "flatbuffers/json_lines.h"
 #include "is_quiet_nan.h"
 #include "test_assert.h"
 
@@ -255,6 +258,290 @@ void FlexBuffersDeprecatedTest() {
   // FBT_VECTOR_KEY (call slb.Key above instead, read with AsKey or AsString).
 }
 
+void FlexBuffersMapKeyHashesTest() {
+  // The same maps, with and without key hashes.
+  std::vector<uint8_t> buffers[2];
+  for (int hashed = 0; hashed < 2; hashed++) {
+    flexbuffers::Builder slb(
+        512, static_cast<flexbuffers::BuilderFlag>(
+                 flexbuffers::BUILDER_FLAG_SHARE_ALL |
+                 (hashed ? flexbuffers::BUILDER_FLAG_MAP_KEY_HASHES : 0)));
+    slb.Map([&]() {
+      for (int i = 0; i < 500; i++) {
+        slb.Int(("key" + NumToString(i * 2)).c_str(), i);
+      }
+      slb.Map("small", [&]() { slb.Int("a", 1); });
+    });
+    slb.Finish();
+    buffers[hashed] = slb.GetBuffer();
+    TEST_EQ(flexbuffers::VerifyBuffer(buffers[hashed].data(),
+                                      buffers[hashed].size(), nullptr),
+            true);
+  }
+  // 1024 slots of 3 bytes, plus 8 bytes and some padding.
+  TEST_ASSERT(buffers[1].size() >= buffers[0].size() + 3 * 1024 + 8);
+  TEST_ASSERT(buffers[1].size() < buffers[0].size() + 3 * 1024 + 24);
+
+  for (int hashed = 0; hashed < 2; hashed++) {
+    auto map = flexbuffers::GetRoot(buffers[hashed]).AsMap();
+    TEST_EQ(map.size(), 501);
+    for (int i = 0; i < 1000; i++) {
+      auto value = map["key" + NumToString(i)];
+      if (i % 2) {
+        TEST_ASSERT(value.IsNull());
+      } else {
+        TEST_EQ(value.AsInt32(), i / 2);
+      }
+    }
+    TEST_ASSERT(map[""].IsNull());
+    TEST_ASSERT(map["zzz"].IsNull());
+    TEST_EQ(map["small"].AsMap()["a"].AsInt32(), 1);
+    // The keys and values are laid out the same way with and without hashes.
+    auto keys = map.Keys();
+    auto values = map.Values();
+    for (size_t i = 1; i < keys.size(); i++) {
+      TEST_ASSERT(strcmp(keys[i - 1].AsKey(), keys[i].AsKey()) < 0);
+    }
+    TEST_EQ_STR(keys[0].AsKey(), "key0");
+    TEST_EQ(values[0].AsInt32(), 0);
+  }
+
+  // Without its magic number, the table is ignored.
+  auto &buffer = buffers[1];
+  const char magic[] = "KFH1";
+  auto it = std::search(buffer.begin(), buffer.end(), magic, magic + 4);
+  TEST_ASSERT(it != buffer.end());
+  // Lookups go through the table: with all its slots empty, nothing is found.
+  std::vector<uint8_t> emptied(buffer);
+  auto tags = emptied.begin() + (it - buffer.begin()) - 4 - 3 * 1024;
+  std::fill(tags, tags + 1024, 0);
+  TEST_ASSERT(flexbuffers::GetRoot(emptied).AsMap()["key998"].IsNull());
+  *it = 0;
+  auto map = flexbuffers::GetRoot(buffer).AsMap();
+  TEST_EQ(map["key998"].AsInt32(), 499);
+  TEST_ASSERT(map["key999"].IsNull());
+
+  // Without the flag, data before a map is never taken for a table, even if
+  // it looks like one. Here a map shares the keys vector of the one before
+  // it, so its values sit between that and the map, the last of them
+  // ending in the key count and magic number.
+  flexbuffers::Builder shared(512, flexbuffers::BUILDER_FLAG_SHARE_ALL);
+  shared.Vector([&]() {
+    for (int m = 0; m < 2; m++) {
+      shared.Map([&]() {
+        shared.String("k00", std::string(300, static_cast<char>('a' + m)));
+        for (int i = 1; i < 15; i++) {
+          shared.Int(("k" + NumToString(i / 10) + NumToString(i % 10)).c_str(),
+                     i);
+        }
+        shared.TypedVector("k15", [&]() {
+          shared.UInt(16 | (static_cast<uint64_t>(
+                                flexbuffers::kMapKeyHashesMagic)
+                            << 32));
+        });
+      });
+    }
+  });
+  shared.Finish();
+  const auto &shared_buffer = shared.GetBuffer();
+  TEST_EQ(flexbuffers::VerifyBuffer(shared_buffer.data(), shared_buffer.size(),
+                                    nullptr),
+          true);
+  auto maps = flexbuffers::GetRoot(shared_buffer).AsVector();
+  for (size_t m = 0; m < maps.size(); m++) {
+    auto shared_map = maps[m].AsMap();
+    TEST_EQ(shared_map["k00"].AsString().size(), 300);
+    for (int i = 1; i < 15; i++) {
+      TEST_EQ(shared_map[("k" + NumToString(i / 10) + NumToString(i % 10))]
+                  .AsInt32(),
+              i);
+    }
+    TEST_EQ(shared_map["k15"].AsTypedVector().size(), 1);
+  }
+}
+
+void FlexBuffersSortedMapTest() {
+  flexbuffers::Builder slb;
+  slb.SortedMap([&]() {
+    slb.Int("a", 1);
+    // An unsorted map inside a sorted one, and the other way around.
+    slb.Map("b", [&]() {
+      slb.Int("z", 26);
+      slb.SortedMap("y", [&]() {
+        slb.Int("c", 3);
+        slb.Int("d", 4);
+      });
+      slb.Int("x", 24);
+    });
+    // Keys inside a vector don't count.
+    slb.Vector("c", [&]() {
+      slb.Key("q");
+      slb.Key("p");
+    });
+    slb.Int("d", 4);
+  });
+  slb.Finish();
+  TEST_ASSERT(!slb.HasDuplicateKeys());
+  auto map = flexbuffers::GetRoot(slb.GetBuffer()).AsMap();
+  TEST_EQ(map["a"].AsInt32(), 1);
+  TEST_EQ(map["d"].AsInt32(), 4);
+  TEST_EQ_STR(map["c"].AsVector()[1].AsKey(), "p");
+  auto b = map["b"].AsMap();
+  TEST_EQ_STR(b.Keys()[0].AsKey(), "x");
+  TEST_EQ(b["x"].AsInt32(), 24);
+  TEST_EQ(b["z"].AsInt32(), 26);
+  TEST_EQ(b["y"].AsMap()["d"].AsInt32(), 4);
+
+  // Keys added in and out of order end up sorted the same way.
+  for (int reversed = 0; reversed < 2; reversed++) {
+    flexbuffers::Builder builder;
+    builder.Map([&]() {
+      for (int i = 0; i < 100; i++) {
+        const int key = reversed ? 99 - i : i;
+        builder.Int(("key" + NumToString(1000 + key)).c_str(), key);
+      }
+    });
+    builder.Finish();
+    auto m = flexbuffers::GetRoot(builder.GetBuffer()).AsMap();
+    for (int i = 0; i < 100; i++) {
+      TEST_EQ_STR(m.Keys()[i].AsKey(), ("key" + NumToString(1000 + i)).c_str());
+      TEST_EQ(m.Values()[i].AsInt32(), i);
+    }
+  }
+
+  // Repeating a key in order still counts as a duplicate.
+  slb.Clear();
+  slb.Map([&]() {
+    slb.Int("a", 1);
+    slb.Int("a", 2);
+  });
+  slb.Finish();
+  TEST_ASSERT(slb.HasDuplicateKeys());
+}
+
+void FlexBuffersShareKeyVectorsTest() {
+  // Records with the same keys, added in varying order, and some others.
+  std::vector<uint8_t> buffers[2];
+  for (int share = 0; share < 2; share++) {
+    flexbuffers::Builder slb(
+        512, share ? flexbuffers::BUILDER_FLAG_SHARE_ALL
+                   : flexbuffers::BUILDER_FLAG_SHARE_KEYS_AND_STRINGS);
+    slb.Vector([&]() {
+      for (int i = 0; i < 100; i++) {
+        slb.Map([&]() {
+          if (i % 2) slb.Int("id", i);
+          slb.String("name", "record");
+          if (!(i % 2)) slb.Int("id", i);
+          slb.Double("score", i * 0.5);
+          if (i % 10 == 0) slb.Bool("flagged", true);
+        });
+      }
+      // The keys of the first ones, minus one.
+      slb.Map([&]() {
+        slb.Int("id", 100);
+        slb.String("name", "short");
+      });
+    });
+    slb.Finish();
+    buffers[share] = slb.GetBuffer();
+    TEST_EQ(flexbuffers::VerifyBuffer(buffers[share].data(),
+                                      buffers[share].size(), nullptr),
+            true);
+  }
+  // Each record saves its 4-byte keys vector, and some padding.
+  TEST_ASSERT(buffers[1].size() + 100 * 4 < buffers[0].size());
+
+  for (int share = 0; share < 2; share++) {
+    auto records = flexbuffers::GetRoot(buffers[share]).AsVector();
+    TEST_EQ(records.size(), 101);
+    for (int i = 0; i < 100; i++) {
+      auto record = records[i].AsMap();
+      TEST_EQ(record.size(), i % 10 == 0 ? 4 : 3);
+      TEST_EQ(record["id"].AsInt32(), i);
+      TEST_EQ_STR(record["name"].AsString().c_str(), "record");
+      TEST_EQ(record["score"].AsDouble(), i * 0.5);
+      TEST_EQ(record["flagged"].AsBool(), i % 10 == 0);
+    }
+    auto last = records[100].AsMap();
+    TEST_EQ(last.size(), 2);
+    TEST_EQ(last["id"].AsInt32(), 100);
+    TEST_ASSERT(last["score"].IsNull());
+  }
+}
+
+void FlexBuffersJsonLinesTest() {
+  const std::vector<std::string> lines = {
+    "{\"id\": 1, \"tags\": [\"a\", \"b\"], \"ok\": true, \"score\": -2.5}",
+    "{}",
+    "[1, -9223372036854775808, 1e3, null, false, {\"x\": []}]",
+    "\"caf\\u00e9 \\ud83d\\ude00 \\\"quoted\\\" \\\\ \\/ \\b\\f\\n\\r\\t\"",
+    "{\"long\": \"" + std::string(100, 'x') + "\", \"n\": {\"m\": {}}}",
+    "  42  ",
+  };
+  std::string input;
+  for (auto &line : lines) input += line + "\n\n";
+  input += "\r\n" + lines[0];  // The last line needn't end with a newline.
+
+  // The same FlexBuffers as from flatbuffers::Parser, line by line.
+  std::vector<std::vector<uint8_t>> expected;
+  for (auto &line : lines) {
+    flatbuffers::Parser parser;
+    flexbuffers::Builder builder;
+    TEST_ASSERT(parser.ParseFlexBuffer(line.c_str(), nullptr, &builder));
+    expected.push_back(builder.GetBuffer());
+  }
+  expected.push_back(expected[0]);
+
+  // In chunks of any size.
+  for (size_t chunk : { size_t(1), size_t(3), size_t(16), input.size() }) {
+    flexbuffers::Builder builder;
+    std::vector<std::vector<uint8_t>> records;
+    flexbuffers::JsonLinesParser parser(&builder, [&](flexbuffers::Builder &b) {
+      records.push_back(b.GetBuffer());
+    });
+    for (size_t i = 0; i < input.size(); i += chunk) {
+      TEST_ASSERT(parser.Feed(input.data() + i,
+                              (std::min)(chunk, input.size() - i)));
+    }
+    TEST_EQ(records.size(), lines.size());
+    TEST_ASSERT(parser.Finish());
+    TEST_EQ(parser.records(), expected.size());
+    TEST_ASSERT(records == expected);
+  }
+
+  // Integers too large for int64.
+  flexbuffers::Builder builder;
+  uint64_t big = 0;
+  double huge = 0;
+  flexbuffers::JsonLinesParser numbers(&builder, [&](flexbuffers::Builder &b) {
+    auto vec = flexbuffers::GetRoot(b.GetBuffer()).AsVector();
+    big = vec[0].AsUInt64();
+    huge = vec[1].AsDouble();
+  });
+  const std::string line = "[18446744073709551615, 18446744073709551616]";
+  TEST_ASSERT(numbers.Feed(line.data(), line.size()) && numbers.Finish());
+  TEST_EQ(big, 18446744073709551615ULL);
+  TEST_EQ(huge, 18446744073709551616.0);
+
+  // Malformed lines fail with their line number.
+  const char *malformed[] = {
+    "{\"a\" 1}",         "[1,]",      "{\"a\": 1, \"a\": 2}",
+    "\"unterminated",    "[1] [2]",   "{a: 1}",
+    "\"\\ud83d\"",       "\"\\x\"",   "01",
+    "[[[[[[[[[[[[1]]]]]]]]]]]]",      "tru",
+    "-",
+  };
+  for (auto json : malformed) {
+    flexbuffers::JsonLinesParser parser(
+        &builder, [](flexbuffers::Builder &) {}, 10);
+    const std::string text = std::string("{}\n") + json + "\n{}\n";
+    TEST_ASSERT(!parser.Feed(text.data(), text.size()));
+    TEST_EQ(parser.records(), 1);
+    TEST_EQ(parser.error().compare(0, 8, "line 2: "), 0);
+    TEST_ASSERT(!parser.Finish());
+  }
+}
+
 void ParseFlexbuffersFromJsonWithNullTest() {
   // Test nulls are handled appropriately through flexbuffers to exercise other
   // code paths of ParseSingleValue in the optional scalars change.
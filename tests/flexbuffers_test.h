@@ -8,6 +8,10 @@ void FlexBuffersTest();
 void FlexBuffersReuseBugTest();
 void FlexBuffersFloatingPointTest();
 void FlexBuffersDeprecatedTest();
+void FlexBuffersMapKeyHashesTest();
+void FlexBuffersSortedMapTest();
+void FlexBuffersShareKeyVectorsTest();
+void FlexBuffersJsonLinesTest();
 void ParseFlexbuffersFromJsonWithNullTest();
 
 }  // namespace tests
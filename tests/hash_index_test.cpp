@@ -0,0 +1,93 @@
+#include "hash_index_test.h"
+
+#include <string>
+#include <vector>
+
+#include "flatbuffers/flatbuffer_builder.h"
+#include "hash_index_test_generated.h"
+#include "test_assert.h"
+
+namespace flatbuffers {
+namespace tests {
+
+using namespace HashIndexTest;
+
+void HashIndexTest() {
+  FlatBufferBuilder builder;
+
+  std::vector<Offset<StringEntry>> words;
+  for (int i = 0; i < 1000; i++) {
+    const auto word = "word_" + NumToString(i * 2);
+    words.push_back(CreateStringEntryDirect(builder, word.c_str(), i));
+  }
+  // A repeated key, which gets a single slot.
+  words.push_back(CreateStringEntryDirect(builder, "word_0", -1));
+  auto strings = CreateStringMapDirect(builder, &words);
+
+  LongMapT longs_obj;
+  for (int64_t i = 0; i < 1000; i++) {
+    longs_obj.entries.emplace_back(new LongEntryT());
+    longs_obj.entries.back()->key = i * 2 - 1000;
+    longs_obj.entries.back()->value = static_cast<float>(i);
+  }
+  auto longs = LongMap::Pack(builder, &longs_obj);
+  builder.Finish(CreateDictionaries(builder, strings, longs));
+
+  Verifier verifier(builder.GetBufferPointer(), builder.GetSize());
+  TEST_ASSERT(VerifyDictionariesBuffer(verifier));
+
+  auto root = GetMutableDictionaries(builder.GetBufferPointer());
+  auto string_map = root->strings();
+  // A bucket per 2 entries, then a slot per distinct key.
+  TEST_EQ(string_map->entries_index()->size(), 2 + 501 + 1000);
+  for (int i = 0; i < 2000; i++) {
+    const auto word = "word_" + NumToString(i);
+    auto entry = string_map->entries_by_key(word.c_str());
+    if (i % 2) {
+      TEST_ASSERT(!entry);
+    } else {
+      TEST_NOTNULL(entry);
+      TEST_EQ_STR(entry->word()->c_str(), word.c_str());
+      // Either of the two entries for word_0.
+      if (i) TEST_EQ(entry->value(), i / 2);
+    }
+  }
+  TEST_ASSERT(!string_map->entries_by_key(""));
+  TEST_ASSERT(!string_map->entries_by_key("word_2000"));
+
+  auto long_map = root->longs();
+  for (int64_t i = -1001; i <= 1001; i++) {
+    auto entry = long_map->entries_by_key(i);
+    if (i % 2 || i > 998) {
+      TEST_ASSERT(!entry);
+    } else {
+      TEST_NOTNULL(entry);
+      TEST_EQ(entry->key(), i);
+      TEST_EQ(entry->value(), static_cast<float>((i + 1000) / 2));
+    }
+  }
+
+  // A slot pointing past the vector fails verification.
+  auto index = root->mutable_longs()->mutable_entries_index();
+  const uint32_t pos = index->Get(index->size() - 1);
+  index->Mutate(index->size() - 1, 1000);
+  Verifier bad_verifier(builder.GetBufferPointer(), builder.GetSize());
+  TEST_ASSERT(!VerifyDictionariesBuffer(bad_verifier));
+  index->Mutate(index->size() - 1, pos);
+
+  // Without an index, lookups fall back to a binary search.
+  FlatBufferBuilder plain;
+  std::vector<Offset<StringEntry>> plain_words;
+  plain_words.push_back(CreateStringEntryDirect(plain, "b", 2));
+  plain_words.push_back(CreateStringEntryDirect(plain, "a", 1));
+  plain.Finish(CreateStringMap(
+      plain, plain.CreateVectorOfSortedTables(&plain_words)));
+  auto plain_map = GetRoot<StringMap>(plain.GetBufferPointer());
+  TEST_ASSERT(!plain_map->entries_index());
+  TEST_EQ(plain_map->entries_by_key("a")->value(), 1);
+  TEST_EQ(plain_map->entries_by_key("b")->value(), 2);
+  TEST_ASSERT(!plain_map->entries_by_key("c"));
+}
+
+}  // namespace tests
+}  // namespace flatbuffers
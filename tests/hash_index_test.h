@@ -0,0 +1,12 @@
+#ifndef TESTS_HASH_INDEX_TEST_H
+#define TESTS_HASH_INDEX_TEST_H
+
+namespace flatbuffers {
+namespace tests {
+
+void HashIndexTest();
+
+}  // namespace tests
+}  // namespace flatbuffers
+
+#endif
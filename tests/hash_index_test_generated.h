@@ -0,0 +1,896 @@
+// automatically generated by the FlatBuffers compiler, do not modify
+
+
+#ifndef FLATBUFFERS_GENERATED_HASHINDEXTEST_HASHINDEXTEST_H_
+#define FLATBUFFERS_GENERATED_HASHINDEXTEST_HASHINDEXTEST_H_
+
+#include "flatbuffers/flatbuffers.h"
+#include "flatbuffers/hash_index.h"
+
+// Ensure the included flatbuffers.h is the same version as when this file was
+// generated, otherwise it may not be compatible.
+static_assert(FLATBUFFERS_VERSION_MAJOR == 22 &&
+              FLATBUFFERS_VERSION_MINOR == 9 &&
+              FLATBUFFERS_VERSION_REVISION == 29,
+             "Non-compatible flatbuffers version included");
+
+namespace HashIndexTest {
+
+struct StringMap;
+struct StringMapBuilder;
+struct StringMapT;
+
+struct LongMap;
+struct LongMapBuilder;
+struct LongMapT;
+
+struct Dictionaries;
+struct DictionariesBuilder;
+struct DictionariesT;
+
+struct StringEntry;
+struct StringEntryBuilder;
+struct StringEntryT;
+
+struct LongEntry;
+struct LongEntryBuilder;
+struct LongEntryT;
+
+bool operator==(const StringMapT &lhs, const StringMapT &rhs);
+bool operator!=(const StringMapT &lhs, const StringMapT &rhs);
+bool operator==(const LongMapT &lhs, const LongMapT &rhs);
+bool operator!=(const LongMapT &lhs, const LongMapT &rhs);
+bool operator==(const DictionariesT &lhs, const DictionariesT &rhs);
+bool operator!=(const DictionariesT &lhs, const DictionariesT &rhs);
+bool operator==(const StringEntryT &lhs, const StringEntryT &rhs);
+bool operator!=(const StringEntryT &lhs, const StringEntryT &rhs);
+bool operator==(const LongEntryT &lhs, const LongEntryT &rhs);
+bool operator!=(const LongEntryT &lhs, const LongEntryT &rhs);
+
+inline const flatbuffers::TypeTable *StringMapTypeTable();
+
+inline const flatbuffers::TypeTable *LongMapTypeTable();
+
+inline const flatbuffers::TypeTable *DictionariesTypeTable();
+
+inline const flatbuffers::TypeTable *StringEntryTypeTable();
+
+inline const flatbuffers::TypeTable *LongEntryTypeTable();
+
+struct StringMapT : public flatbuffers::NativeTable {
+  typedef StringMap TableType;
+  std::vector<flatbuffers::unique_ptr<HashIndexTest::StringEntryT>> entries{};
+  std::vector<uint32_t> entries_index{};
+  StringMapT() = default;
+  StringMapT(const StringMapT &o);
+  StringMapT(StringMapT&&) FLATBUFFERS_NOEXCEPT = default;
+  StringMapT &operator=(StringMapT o) FLATBUFFERS_NOEXCEPT;
+};
+
+struct StringMap FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef StringMapT NativeTableType;
+  typedef StringMapBuilder Builder;
+  static const flatbuffers::TypeTable *MiniReflectTypeTable() {
+    return StringMapTypeTable();
+  }
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_ENTRIES = 4,
+    VT_ENTRIES_INDEX = 6
+  };
+  const flatbuffers::Vector<flatbuffers::Offset<HashIndexTest::StringEntry>> *entries() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<HashIndexTest::StringEntry>> *>(VT_ENTRIES);
+  }
+  flatbuffers::Vector<flatbuffers::Offset<HashIndexTest::StringEntry>> *mutable_entries() {
+    return GetPointer<flatbuffers::Vector<flatbuffers::Offset<HashIndexTest::StringEntry>> *>(VT_ENTRIES);
+  }
+  const HashIndexTest::StringEntry *entries_by_key(const char *key) const {
+    return flatbuffers::LookupByHashIndex(entries(), entries_index(), key);
+  }
+  const flatbuffers::Vector<uint32_t> *entries_index() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_ENTRIES_INDEX);
+  }
+  flatbuffers::Vector<uint32_t> *mutable_entries_index() {
+    return GetPointer<flatbuffers::Vector<uint32_t> *>(VT_ENTRIES_INDEX);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_ENTRIES) &&
+           verifier.VerifyVector(entries()) &&
+           verifier.VerifyVectorOfTables(entries()) &&
+           VerifyOffset(verifier, VT_ENTRIES_INDEX) &&
+           verifier.VerifyVector(entries_index()) &&
+           flatbuffers::VerifyHashIndex(verifier, entries(), entries_index()) &&
+           verifier.EndTable();
+  }
+  StringMapT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(StringMapT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<StringMap> Pack(flatbuffers::FlatBufferBuilder &_fbb, const StringMapT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
+
+struct StringMapBuilder {
+  typedef StringMap Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_entries(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<HashIndexTest::StringEntry>>> entries) {
+    fbb_.AddOffset(StringMap::VT_ENTRIES, entries);
+  }
+  void add_entries_index(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> entries_index) {
+    fbb_.AddOffset(StringMap::VT_ENTRIES_INDEX, entries_index);
+  }
+  explicit StringMapBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<StringMap> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<StringMap>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<StringMap> CreateStringMap(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<HashIndexTest::StringEntry>>> entries = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> entries_index = 0) {
+  StringMapBuilder builder_(_fbb);
+  builder_.add_entries_index(entries_index);
+  builder_.add_entries(entries);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<StringMap> CreateStringMapDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    std::vector<flatbuffers::Offset<HashIndexTest::StringEntry>> *entries = nullptr,
+    const std::vector<uint32_t> *entries_index = nullptr) {
+  auto entries__ = entries ? _fbb.CreateVectorOfSortedTables<HashIndexTest::StringEntry>(entries) : 0;
+  auto entries_index__ = entries_index
+      ? _fbb.CreateVector<uint32_t>(*entries_index)
+      : flatbuffers::CreateHashIndex(_fbb, entries__);
+  return HashIndexTest::CreateStringMap(
+      _fbb,
+      entries__,
+      entries_index__);
+}
+
+flatbuffers::Offset<StringMap> CreateStringMap(flatbuffers::FlatBufferBuilder &_fbb, const StringMapT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
+struct LongMapT : public flatbuffers::NativeTable {
+  typedef LongMap TableType;
+  std::vector<uint32_t> entries_index{};
+  std::vector<flatbuffers::unique_ptr<HashIndexTest::LongEntryT>> entries{};
+  LongMapT() = default;
+  LongMapT(const LongMapT &o);
+  LongMapT(LongMapT&&) FLATBUFFERS_NOEXCEPT = default;
+  LongMapT &operator=(LongMapT o) FLATBUFFERS_NOEXCEPT;
+};
+
+struct LongMap FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef LongMapT NativeTableType;
+  typedef LongMapBuilder Builder;
+  static const flatbuffers::TypeTable *MiniReflectTypeTable() {
+    return LongMapTypeTable();
+  }
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_ENTRIES_INDEX = 4,
+    VT_ENTRIES = 6
+  };
+  const flatbuffers::Vector<uint32_t> *entries_index() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_ENTRIES_INDEX);
+  }
+  flatbuffers::Vector<uint32_t> *mutable_entries_index() {
+    return GetPointer<flatbuffers::Vector<uint32_t> *>(VT_ENTRIES_INDEX);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<HashIndexTest::LongEntry>> *entries() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<HashIndexTest::LongEntry>> *>(VT_ENTRIES);
+  }
+  flatbuffers::Vector<flatbuffers::Offset<HashIndexTest::LongEntry>> *mutable_entries() {
+    return GetPointer<flatbuffers::Vector<flatbuffers::Offset<HashIndexTest::LongEntry>> *>(VT_ENTRIES);
+  }
+  const HashIndexTest::LongEntry *entries_by_key(int64_t key) const {
+    return flatbuffers::LookupByHashIndex(entries(), entries_index(), key);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_ENTRIES_INDEX) &&
+           verifier.VerifyVector(entries_index()) &&
+           VerifyOffset(verifier, VT_ENTRIES) &&
+           verifier.VerifyVector(entries()) &&
+           verifier.VerifyVectorOfTables(entries()) &&
+           flatbuffers::VerifyHashIndex(verifier, entries(), entries_index()) &&
+           verifier.EndTable();
+  }
+  LongMapT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(LongMapT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<LongMap> Pack(flatbuffers::FlatBufferBuilder &_fbb, const LongMapT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
+
+struct LongMapBuilder {
+  typedef LongMap Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_entries_index(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> entries_index) {
+    fbb_.AddOffset(LongMap::VT_ENTRIES_INDEX, entries_index);
+  }
+  void add_entries(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<HashIndexTest::LongEntry>>> entries) {
+    fbb_.AddOffset(LongMap::VT_ENTRIES, entries);
+  }
+  explicit LongMapBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<LongMap> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<LongMap>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<LongMap> CreateLongMap(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> entries_index = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<HashIndexTest::LongEntry>>> entries = 0) {
+  LongMapBuilder builder_(_fbb);
+  builder_.add_entries(entries);
+  builder_.add_entries_index(entries_index);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<LongMap> CreateLongMapDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const std::vector<uint32_t> *entries_index = nullptr,
+    std::vector<flatbuffers::Offset<HashIndexTest::LongEntry>> *entries = nullptr) {
+  auto entries__ = entries ? _fbb.CreateVectorOfSortedTables<HashIndexTest::LongEntry>(entries) : 0;
+  auto entries_index__ = entries_index
+      ? _fbb.CreateVector<uint32_t>(*entries_index)
+      : flatbuffers::CreateHashIndex(_fbb, entries__);
+  return HashIndexTest::CreateLongMap(
+      _fbb,
+      entries_index__,
+      entries__);
+}
+
+flatbuffers::Offset<LongMap> CreateLongMap(flatbuffers::FlatBufferBuilder &_fbb, const LongMapT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
+struct DictionariesT : public flatbuffers::NativeTable {
+  typedef Dictionaries TableType;
+  flatbuffers::unique_ptr<HashIndexTest::StringMapT> strings{};
+  flatbuffers::unique_ptr<HashIndexTest::LongMapT> longs{};
+  DictionariesT() = default;
+  DictionariesT(const DictionariesT &o);
+  DictionariesT(DictionariesT&&) FLATBUFFERS_NOEXCEPT = default;
+  DictionariesT &operator=(DictionariesT o) FLATBUFFERS_NOEXCEPT;
+};
+
+struct Dictionaries FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef DictionariesT NativeTableType;
+  typedef DictionariesBuilder Builder;
+  static const flatbuffers::TypeTable *MiniReflectTypeTable() {
+    return DictionariesTypeTable();
+  }
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_STRINGS = 4,
+    VT_LONGS = 6
+  };
+  const HashIndexTest::StringMap *strings() const {
+    return GetPointer<const HashIndexTest::StringMap *>(VT_STRINGS);
+  }
+  HashIndexTest::StringMap *mutable_strings() {
+    return GetPointer<HashIndexTest::StringMap *>(VT_STRINGS);
+  }
+  const HashIndexTest::LongMap *longs() const {
+    return GetPointer<const HashIndexTest::LongMap *>(VT_LONGS);
+  }
+  HashIndexTest::LongMap *mutable_longs() {
+    return GetPointer<HashIndexTest::LongMap *>(VT_LONGS);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_STRINGS) &&
+           verifier.VerifyTable(strings()) &&
+           VerifyOffset(verifier, VT_LONGS) &&
+           verifier.VerifyTable(longs()) &&
+           verifier.EndTable();
+  }
+  DictionariesT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(DictionariesT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<Dictionaries> Pack(flatbuffers::FlatBufferBuilder &_fbb, const DictionariesT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
+
+struct DictionariesBuilder {
+  typedef Dictionaries Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_strings(flatbuffers::Offset<HashIndexTest::StringMap> strings) {
+    fbb_.AddOffset(Dictionaries::VT_STRINGS, strings);
+  }
+  void add_longs(flatbuffers::Offset<HashIndexTest::LongMap> longs) {
+    fbb_.AddOffset(Dictionaries::VT_LONGS, longs);
+  }
+  explicit DictionariesBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<Dictionaries> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<Dictionaries>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<Dictionaries> CreateDictionaries(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<HashIndexTest::StringMap> strings = 0,
+    flatbuffers::Offset<HashIndexTest::LongMap> longs = 0) {
+  DictionariesBuilder builder_(_fbb);
+  builder_.add_longs(longs);
+  builder_.add_strings(strings);
+  return builder_.Finish();
+}
+
+flatbuffers::Offset<Dictionaries> CreateDictionaries(flatbuffers::FlatBufferBuilder &_fbb, const DictionariesT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
+struct StringEntryT : public flatbuffers::NativeTable {
+  typedef StringEntry TableType;
+  std::string word{};
+  int32_t value = 0;
+};
+
+struct StringEntry FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef StringEntryT NativeTableType;
+  typedef StringEntryBuilder Builder;
+  static const flatbuffers::TypeTable *MiniReflectTypeTable() {
+    return StringEntryTypeTable();
+  }
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_WORD = 4,
+    VT_VALUE = 6
+  };
+  const flatbuffers::String *word() const {
+    return GetPointer<const flatbuffers::String *>(VT_WORD);
+  }
+  flatbuffers::String *mutable_word() {
+    return GetPointer<flatbuffers::String *>(VT_WORD);
+  }
+  bool KeyCompareLessThan(const StringEntry *o) const {
+    return *word() < *o->word();
+  }
+  int KeyCompareWithValue(const char *_word) const {
+    return strcmp(word()->c_str(), _word);
+  }
+  const flatbuffers::String *HashIndexKey() const {
+    return word();
+  }
+  int32_t value() const {
+    return GetField<int32_t>(VT_VALUE, 0);
+  }
+  bool mutate_value(int32_t _value = 0) {
+    return SetField<int32_t>(VT_VALUE, _value, 0);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffsetRequired(verifier, VT_WORD) &&
+           verifier.VerifyString(word()) &&
+           VerifyField<int32_t>(verifier, VT_VALUE, 4) &&
+           verifier.EndTable();
+  }
+  StringEntryT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(StringEntryT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<StringEntry> Pack(flatbuffers::FlatBufferBuilder &_fbb, const StringEntryT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
+
+struct StringEntryBuilder {
+  typedef StringEntry Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_word(flatbuffers::Offset<flatbuffers::String> word) {
+    fbb_.AddOffset(StringEntry::VT_WORD, word);
+  }
+  void add_value(int32_t value) {
+    fbb_.AddElement<int32_t>(StringEntry::VT_VALUE, value, 0);
+  }
+  explicit StringEntryBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<StringEntry> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<StringEntry>(end);
+    fbb_.Required(o, StringEntry::VT_WORD);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<StringEntry> CreateStringEntry(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::String> word = 0,
+    int32_t value = 0) {
+  StringEntryBuilder builder_(_fbb);
+  builder_.add_value(value);
+  builder_.add_word(word);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<StringEntry> CreateStringEntryDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const char *word = nullptr,
+    int32_t value = 0) {
+  auto word__ = word ? _fbb.CreateString(word) : 0;
+  return HashIndexTest::CreateStringEntry(
+      _fbb,
+      word__,
+      value);
+}
+
+flatbuffers::Offset<StringEntry> CreateStringEntry(flatbuffers::FlatBufferBuilder &_fbb, const StringEntryT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
+struct LongEntryT : public flatbuffers::NativeTable {
+  typedef LongEntry TableType;
+  int64_t key = 0;
+  float value = 0.0f;
+};
+
+struct LongEntry FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef LongEntryT NativeTableType;
+  typedef LongEntryBuilder Builder;
+  static const flatbuffers::TypeTable *MiniReflectTypeTable() {
+    return LongEntryTypeTable();
+  }
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_KEY = 4,
+    VT_VALUE = 6
+  };
+  int64_t key() const {
+    return GetField<int64_t>(VT_KEY, 0);
+  }
+  bool mutate_key(int64_t _key = 0) {
+    return SetField<int64_t>(VT_KEY, _key, 0);
+  }
+  bool KeyCompareLessThan(const LongEntry *o) const {
+    return key() < o->key();
+  }
+  int KeyCompareWithValue(int64_t _key) const {
+    return static_cast<int>(key() > _key) - static_cast<int>(key() < _key);
+  }
+  int64_t HashIndexKey() const {
+    return key();
+  }
+  float value() const {
+    return GetField<float>(VT_VALUE, 0.0f);
+  }
+  bool mutate_value(float _value = 0.0f) {
+    return SetField<float>(VT_VALUE, _value, 0.0f);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<int64_t>(verifier, VT_KEY, 8) &&
+           VerifyField<float>(verifier, VT_VALUE, 4) &&
+           verifier.EndTable();
+  }
+  LongEntryT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(LongEntryT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<LongEntry> Pack(flatbuffers::FlatBufferBuilder &_fbb, const LongEntryT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
+
+struct LongEntryBuilder {
+  typedef LongEntry Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_key(int64_t key) {
+    fbb_.AddElement<int64_t>(LongEntry::VT_KEY, key, 0);
+  }
+  void add_value(float value) {
+    fbb_.AddElement<float>(LongEntry::VT_VALUE, value, 0.0f);
+  }
+  explicit LongEntryBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<LongEntry> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<LongEntry>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<LongEntry> CreateLongEntry(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    int64_t key = 0,
+    float value = 0.0f) {
+  LongEntryBuilder builder_(_fbb);
+  builder_.add_key(key);
+  builder_.add_value(value);
+  return builder_.Finish();
+}
+
+flatbuffers::Offset<LongEntry> CreateLongEntry(flatbuffers::FlatBufferBuilder &_fbb, const LongEntryT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
+
+inline bool operator==(const StringMapT &lhs, const StringMapT &rhs) {
+  return
+      (lhs.entries.size() == rhs.entries.size() && std::equal(lhs.entries.cbegin(), lhs.entries.cend(), rhs.entries.cbegin(), [](flatbuffers::unique_ptr<HashIndexTest::StringEntryT> const &a, flatbuffers::unique_ptr<HashIndexTest::StringEntryT> const &b) { return (a == b) || (a && b && *a == *b); })) &&
+      (lhs.entries_index == rhs.entries_index);
+}
+
+inline bool operator!=(const StringMapT &lhs, const StringMapT &rhs) {
+    return !(lhs == rhs);
+}
+
+
+inline StringMapT::StringMapT(const StringMapT &o)
+      : entries_index(o.entries_index) {
+  entries.reserve(o.entries.size());
+  for (const auto &entries_ : o.entries) { entries.emplace_back((entries_) ? new HashIndexTest::StringEntryT(*entries_) : nullptr); }
+}
+
+inline StringMapT &StringMapT::operator=(StringMapT o) FLATBUFFERS_NOEXCEPT {
+  std::swap(entries, o.entries);
+  std::swap(entries_index, o.entries_index);
+  return *this;
+}
+
+inline StringMapT *StringMap::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = std::unique_ptr<StringMapT>(new StringMapT());
+  UnPackTo(_o.get(), _resolver);
+  return _o.release();
+}
+
+inline void StringMap::UnPackTo(StringMapT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = entries(); if (_e) { _o->entries.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { if(_o->entries[_i]) { _e->Get(_i)->UnPackTo(_o->entries[_i].get(), _resolver); } else { _o->entries[_i] = flatbuffers::unique_ptr<HashIndexTest::StringEntryT>(_e->Get(_i)->UnPack(_resolver)); }; } } else { _o->entries.resize(0); } }
+  { auto _e = entries_index(); if (_e) { _o->entries_index.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->entries_index[_i] = _e->Get(_i); } } else { _o->entries_index.resize(0); } }
+}
+
+inline flatbuffers::Offset<StringMap> StringMap::Pack(flatbuffers::FlatBufferBuilder &_fbb, const StringMapT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateStringMap(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<StringMap> CreateStringMap(flatbuffers::FlatBufferBuilder &_fbb, const StringMapT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  struct _VectorArgs { flatbuffers::FlatBufferBuilder *__fbb; const StringMapT* __o; const flatbuffers::rehasher_function_t *__rehasher; } _va = { &_fbb, _o, _rehasher}; (void)_va;
+  auto _entries = _o->entries.size() ? _fbb.CreateVector<flatbuffers::Offset<HashIndexTest::StringEntry>> (_o->entries.size(), [](size_t i, _VectorArgs *__va) { return CreateStringEntry(*__va->__fbb, __va->__o->entries[i].get(), __va->__rehasher); }, &_va ) : 0;
+  auto _entries_index = flatbuffers::CreateHashIndex(_fbb, _entries);
+  return HashIndexTest::CreateStringMap(
+      _fbb,
+      _entries,
+      _entries_index);
+}
+
+
+inline bool operator==(const LongMapT &lhs, const LongMapT &rhs) {
+  return
+      (lhs.entries_index == rhs.entries_index) &&
+      (lhs.entries.size() == rhs.entries.size() && std::equal(lhs.entries.cbegin(), lhs.entries.cend(), rhs.entries.cbegin(), [](flatbuffers::unique_ptr<HashIndexTest::LongEntryT> const &a, flatbuffers::unique_ptr<HashIndexTest::LongEntryT> const &b) { return (a == b) || (a && b && *a == *b); }));
+}
+
+inline bool operator!=(const LongMapT &lhs, const LongMapT &rhs) {
+    return !(lhs == rhs);
+}
+
+
+inline LongMapT::LongMapT(const LongMapT &o)
+      : entries_index(o.entries_index) {
+  entries.reserve(o.entries.size());
+  for (const auto &entries_ : o.entries) { entries.emplace_back((entries_) ? new HashIndexTest::LongEntryT(*entries_) : nullptr); }
+}
+
+inline LongMapT &LongMapT::operator=(LongMapT o) FLATBUFFERS_NOEXCEPT {
+  std::swap(entries_index, o.entries_index);
+  std::swap(entries, o.entries);
+  return *this;
+}
+
+inline LongMapT *LongMap::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = std::unique_ptr<LongMapT>(new LongMapT());
+  UnPackTo(_o.get(), _resolver);
+  return _o.release();
+}
+
+inline void LongMap::UnPackTo(LongMapT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = entries_index(); if (_e) { _o->entries_index.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->entries_index[_i] = _e->Get(_i); } } else { _o->entries_index.resize(0); } }
+  { auto _e = entries(); if (_e) { _o->entries.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { if(_o->entries[_i]) { _e->Get(_i)->UnPackTo(_o->entries[_i].get(), _resolver); } else { _o->entries[_i] = flatbuffers::unique_ptr<HashIndexTest::LongEntryT>(_e->Get(_i)->UnPack(_resolver)); }; } } else { _o->entries.resize(0); } }
+}
+
+inline flatbuffers::Offset<LongMap> LongMap::Pack(flatbuffers::FlatBufferBuilder &_fbb, const LongMapT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateLongMap(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<LongMap> CreateLongMap(flatbuffers::FlatBufferBuilder &_fbb, const LongMapT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  struct _VectorArgs { flatbuffers::FlatBufferBuilder *__fbb; const LongMapT* __o; const flatbuffers::rehasher_function_t *__rehasher; } _va = { &_fbb, _o, _rehasher}; (void)_va;
+  auto _entries = _o->entries.size() ? _fbb.CreateVector<flatbuffers::Offset<HashIndexTest::LongEntry>> (_o->entries.size(), [](size_t i, _VectorArgs *__va) { return CreateLongEntry(*__va->__fbb, __va->__o->entries[i].get(), __va->__rehasher); }, &_va ) : 0;
+  auto _entries_index = flatbuffers::CreateHashIndex(_fbb, _entries);
+  return HashIndexTest::CreateLongMap(
+      _fbb,
+      _entries_index,
+      _entries);
+}
+
+
+inline bool operator==(const DictionariesT &lhs, const DictionariesT &rhs) {
+  return
+      ((lhs.strings == rhs.strings) || (lhs.strings && rhs.strings && *lhs.strings == *rhs.strings)) &&
+      ((lhs.longs == rhs.longs) || (lhs.longs && rhs.longs && *lhs.longs == *rhs.longs));
+}
+
+inline bool operator!=(const DictionariesT &lhs, const DictionariesT &rhs) {
+    return !(lhs == rhs);
+}
+
+
+inline DictionariesT::DictionariesT(const DictionariesT &o)
+      : strings((o.strings) ? new HashIndexTest::StringMapT(*o.strings) : nullptr),
+        longs((o.longs) ? new HashIndexTest::LongMapT(*o.longs) : nullptr) {
+}
+
+inline DictionariesT &DictionariesT::operator=(DictionariesT o) FLATBUFFERS_NOEXCEPT {
+  std::swap(strings, o.strings);
+  std::swap(longs, o.longs);
+  return *this;
+}
+
+inline DictionariesT *Dictionaries::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = std::unique_ptr<DictionariesT>(new DictionariesT());
+  UnPackTo(_o.get(), _resolver);
+  return _o.release();
+}
+
+inline void Dictionaries::UnPackTo(DictionariesT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = strings(); if (_e) { if(_o->strings) { _e->UnPackTo(_o->strings.get(), _resolver); } else { _o->strings = flatbuffers::unique_ptr<HashIndexTest::StringMapT>(_e->UnPack(_resolver)); } } else if (_o->strings) { _o->strings.reset(); } }
+  { auto _e = longs(); if (_e) { if(_o->longs) { _e->UnPackTo(_o->longs.get(), _resolver); } else { _o->longs = flatbuffers::unique_ptr<HashIndexTest::LongMapT>(_e->UnPack(_resolver)); } } else if (_o->longs) { _o->longs.reset(); } }
+}
+
+inline flatbuffers::Offset<Dictionaries> Dictionaries::Pack(flatbuffers::FlatBufferBuilder &_fbb, const DictionariesT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateDictionaries(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<Dictionaries> CreateDictionaries(flatbuffers::FlatBufferBuilder &_fbb, const DictionariesT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  struct _VectorArgs { flatbuffers::FlatBufferBuilder *__fbb; const DictionariesT* __o; const flatbuffers::rehasher_function_t *__rehasher; } _va = { &_fbb, _o, _rehasher}; (void)_va;
+  auto _strings = _o->strings ? CreateStringMap(_fbb, _o->strings.get(), _rehasher) : 0;
+  auto _longs = _o->longs ? CreateLongMap(_fbb, _o->longs.get(), _rehasher) : 0;
+  return HashIndexTest::CreateDictionaries(
+      _fbb,
+      _strings,
+      _longs);
+}
+
+
+inline bool operator==(const StringEntryT &lhs, const StringEntryT &rhs) {
+  return
+      (lhs.word == rhs.word) &&
+      (lhs.value == rhs.value);
+}
+
+inline bool operator!=(const StringEntryT &lhs, const StringEntryT &rhs) {
+    return !(lhs == rhs);
+}
+
+
+inline StringEntryT *StringEntry::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = std::unique_ptr<StringEntryT>(new StringEntryT());
+  UnPackTo(_o.get(), _resolver);
+  return _o.release();
+}
+
+inline void StringEntry::UnPackTo(StringEntryT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = word(); if (_e) _o->word.assign(_e->c_str(), _e->size()); else _o->word.clear(); }
+  { auto _e = value(); _o->value = _e; }
+}
+
+inline flatbuffers::Offset<StringEntry> StringEntry::Pack(flatbuffers::FlatBufferBuilder &_fbb, const StringEntryT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateStringEntry(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<StringEntry> CreateStringEntry(flatbuffers::FlatBufferBuilder &_fbb, const StringEntryT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  struct _VectorArgs { flatbuffers::FlatBufferBuilder *__fbb; const StringEntryT* __o; const flatbuffers::rehasher_function_t *__rehasher; } _va = { &_fbb, _o, _rehasher}; (void)_va;
+  auto _word = _fbb.CreateString(_o->word);
+  auto _value = _o->value;
+  return HashIndexTest::CreateStringEntry(
+      _fbb,
+      _word,
+      _value);
+}
+
+
+inline bool operator==(const LongEntryT &lhs, const LongEntryT &rhs) {
+  return
+      (lhs.key == rhs.key) &&
+      (lhs.value == rhs.value);
+}
+
+inline bool operator!=(const LongEntryT &lhs, const LongEntryT &rhs) {
+    return !(lhs == rhs);
+}
+
+
+inline LongEntryT *LongEntry::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = std::unique_ptr<LongEntryT>(new LongEntryT());
+  UnPackTo(_o.get(), _resolver);
+  return _o.release();
+}
+
+inline void LongEntry::UnPackTo(LongEntryT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = key(); _o->key = _e; }
+  { auto _e = value(); _o->value = _e; }
+}
+
+inline flatbuffers::Offset<LongEntry> LongEntry::Pack(flatbuffers::FlatBufferBuilder &_fbb, const LongEntryT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateLongEntry(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<LongEntry> CreateLongEntry(flatbuffers::FlatBufferBuilder &_fbb, const LongEntryT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  struct _VectorArgs { flatbuffers::FlatBufferBuilder *__fbb; const LongEntryT* __o; const flatbuffers::rehasher_function_t *__rehasher; } _va = { &_fbb, _o, _rehasher}; (void)_va;
+  auto _key = _o->key;
+  auto _value = _o->value;
+  return HashIndexTest::CreateLongEntry(
+      _fbb,
+      _key,
+      _value);
+}
+
+inline const flatbuffers::TypeTable *StringMapTypeTable() {
+  static const flatbuffers::TypeCode type_codes[] = {
+    { flatbuffers::ET_SEQUENCE, 1, 0 },
+    { flatbuffers::ET_UINT, 1, -1 }
+  };
+  static const flatbuffers::TypeFunction type_refs[] = {
+    HashIndexTest::StringEntryTypeTable
+  };
+  static const char * const names[] = {
+    "entries",
+    "entries_index"
+  };
+  static const flatbuffers::TypeTable tt = {
+    flatbuffers::ST_TABLE, 2, type_codes, type_refs, nullptr, nullptr, names
+  };
+  return &tt;
+}
+
+inline const flatbuffers::TypeTable *LongMapTypeTable() {
+  static const flatbuffers::TypeCode type_codes[] = {
+    { flatbuffers::ET_UINT, 1, -1 },
+    { flatbuffers::ET_SEQUENCE, 1, 0 }
+  };
+  static const flatbuffers::TypeFunction type_refs[] = {
+    HashIndexTest::LongEntryTypeTable
+  };
+  static const char * const names[] = {
+    "entries_index",
+    "entries"
+  };
+  static const flatbuffers::TypeTable tt = {
+    flatbuffers::ST_TABLE, 2, type_codes, type_refs, nullptr, nullptr, names
+  };
+  return &tt;
+}
+
+inline const flatbuffers::TypeTable *DictionariesTypeTable() {
+  static const flatbuffers::TypeCode type_codes[] = {
+    { flatbuffers::ET_SEQUENCE, 0, 0 },
+    { flatbuffers::ET_SEQUENCE, 0, 1 }
+  };
+  static const flatbuffers::TypeFunction type_refs[] = {
+    HashIndexTest::StringMapTypeTable,
+    HashIndexTest::LongMapTypeTable
+  };
+  static const char * const names[] = {
+    "strings",
+    "longs"
+  };
+  static const flatbuffers::TypeTable tt = {
+    flatbuffers::ST_TABLE, 2, type_codes, type_refs, nullptr, nullptr, names
+  };
+  return &tt;
+}
+
+inline const flatbuffers::TypeTable *StringEntryTypeTable() {
+  static const flatbuffers::TypeCode type_codes[] = {
+    { flatbuffers::ET_STRING, 0, -1 },
+    { flatbuffers::ET_INT, 0, -1 }
+  };
+  static const char * const names[] = {
+    "word",
+    "value"
+  };
+  static const flatbuffers::TypeTable tt = {
+    flatbuffers::ST_TABLE, 2, type_codes, nullptr, nullptr, nullptr, names
+  };
+  return &tt;
+}
+
+inline const flatbuffers::TypeTable *LongEntryTypeTable() {
+  static const flatbuffers::TypeCode type_codes[] = {
+    { flatbuffers::ET_LONG, 0, -1 },
+    { flatbuffers::ET_FLOAT, 0, -1 }
+  };
+  static const char * const names[] = {
+    "key",
+    "value"
+  };
+  static const flatbuffers::TypeTable tt = {
+    flatbuffers::ST_TABLE, 2, type_codes, nullptr, nullptr, nullptr, names
+  };
+  return &tt;
+}
+
+inline const HashIndexTest::Dictionaries *GetDictionaries(const void *buf) {
+  return flatbuffers::GetRoot<HashIndexTest::Dictionaries>(buf);
+}
+
+inline const HashIndexTest::Dictionaries *GetSizePrefixedDictionaries(const void *buf) {
+  return flatbuffers::GetSizePrefixedRoot<HashIndexTest::Dictionaries>(buf);
+}
+
+inline Dictionaries *GetMutableDictionaries(void *buf) {
+  return flatbuffers::GetMutableRoot<Dictionaries>(buf);
+}
+
+inline HashIndexTest::Dictionaries *GetMutableSizePrefixedDictionaries(void *buf) {
+  return flatbuffers::GetMutableSizePrefixedRoot<HashIndexTest::Dictionaries>(buf);
+}
+
+inline bool VerifyDictionariesBuffer(
+    flatbuffers::Verifier &verifier) {
+  return verifier.VerifyBuffer<HashIndexTest::Dictionaries>(nullptr);
+}
+
+inline bool VerifySizePrefixedDictionariesBuffer(
+    flatbuffers::Verifier &verifier) {
+  return verifier.VerifySizePrefixedBuffer<HashIndexTest::Dictionaries>(nullptr);
+}
+
+inline void FinishDictionariesBuffer(
+    flatbuffers::FlatBufferBuilder &fbb,
+    flatbuffers::Offset<HashIndexTest::Dictionaries> root) {
+  fbb.Finish(root);
+}
+
+inline void FinishSizePrefixedDictionariesBuffer(
+    flatbuffers::FlatBufferBuilder &fbb,
+    flatbuffers::Offset<HashIndexTest::Dictionaries> root) {
+  fbb.FinishSizePrefixed(root);
+}
+
+inline flatbuffers::unique_ptr<HashIndexTest::DictionariesT> UnPackDictionaries(
+    const void *buf,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  return flatbuffers::unique_ptr<HashIndexTest::DictionariesT>(GetDictionaries(buf)->UnPack(res));
+}
+
+inline flatbuffers::unique_ptr<HashIndexTest::DictionariesT> UnPackSizePrefixedDictionaries(
+    const void *buf,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  return flatbuffers::unique_ptr<HashIndexTest::DictionariesT>(GetSizePrefixedDictionaries(buf)->UnPack(res));
+}
+
+inline void UnPackToDictionaries(
+    const void *buf, HashIndexTest::DictionariesT *_o,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  GetDictionaries(buf)->UnPackTo(_o, res);
+}
+
+inline void UnPackToSizePrefixedDictionaries(
+    const void *buf, HashIndexTest::DictionariesT *_o,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  GetSizePrefixedDictionaries(buf)->UnPackTo(_o, res);
+}
+
+}  // namespace HashIndexTest
+
+#endif  // FLATBUFFERS_GENERATED_HASHINDEXTEST_HASHINDEXTEST_H_
@@ -0,0 +1,164 @@
+#include "key_index_test.h"
+
+#include <string>
+#include <vector>
+
+#include "flatbuffers/flatbuffer_builder.h"
+#include "flatbuffers/key_index.h"
+#include "key_index_test_generated.h"
+#include "monster_test_generated.h"
+#include "test_assert.h"
+
+namespace flatbuffers {
+namespace tests {
+namespace {
+
+// Indexes vectors of a loaded buffer with MakeKeyIndex().
+void KeyIndexInMemoryTest() {
+  using namespace MyGame::Example;
+  FlatBufferBuilder fbb;
+  std::vector<Offset<Monster>> monsters;
+  std::vector<Offset<Stat>> stats;
+  for (int i = 0; i < 1000; i++) {
+    // Runs of names share their first 8 bytes, or differ in the first one.
+    auto name = i % 2 ? "monster_" + NumToString(i * 2) : NumToString(i * 2);
+    monsters.push_back(
+        CreateMonster(fbb, nullptr, 150, 80, fbb.CreateString(name)));
+    stats.push_back(CreateStat(fbb, 0, i, static_cast<uint16_t>(i * 2)));
+  }
+  auto monster_vec = fbb.CreateVectorOfSortedTables(&monsters);
+  auto stat_vec = fbb.CreateVectorOfSortedTables(&stats);
+  auto name = fbb.CreateString("root");
+  MonsterBuilder mb(fbb);
+  mb.add_name(name);
+  mb.add_testarrayoftables(monster_vec);
+  mb.add_scalar_key_sorted_tables(stat_vec);
+  FinishMonsterBuffer(fbb, mb.Finish());
+  auto root = GetMonster(fbb.GetBufferPointer());
+
+  auto names = MakeKeyIndex(root->testarrayoftables(), &Monster::name);
+  auto counts = MakeKeyIndex(root->scalar_key_sorted_tables(), &Stat::count);
+  for (int i = 0; i < 2000; i++) {
+    const bool present = i % 2 == 0;
+    const auto short_name = NumToString(i);
+    const auto long_name = "monster_" + short_name;
+    TEST_EQ(names.LookupByKey(short_name.c_str()) != nullptr,
+            present && i % 4 == 0);
+    TEST_EQ(names.LookupByKey(long_name.c_str()) != nullptr,
+            present && i % 4 == 2);
+    auto stat = counts.LookupByKey(static_cast<uint16_t>(i));
+    TEST_EQ(stat != nullptr, present);
+    if (stat) TEST_EQ(stat->val(), i / 2);
+  }
+  TEST_ASSERT(!names.LookupByKey(""));
+  TEST_ASSERT(!names.LookupByKey("zzz"));
+  TEST_EQ_STR(names.LookupByKey("monster_1998")->name()->c_str(),
+              "monster_1998");
+
+  // Scalar keys of other types are converted to the key type first.
+  TEST_EQ(counts.LookupByKey(6)->val(), 3);
+  TEST_ASSERT(!counts.LookupByKey(7));
+
+  // Small vectors are searched as is.
+  auto none = MakeKeyIndex(
+      root->testarrayoftables()->LookupByKey("0")->testarrayoftables(),
+      &Monster::name);
+  TEST_ASSERT(!none.LookupByKey("0"));
+
+  // Zeros of either sign are the same key.
+  TEST_EQ(KeyPrefix(-0.0), KeyPrefix(0.0));
+  TEST_EQ(KeyPrefix(-0.0f), KeyPrefix(0.0f));
+  TEST_EQ(KeyPrefix(-1e-30f) < KeyPrefix(-0.0f), true);
+}
+
+// Indexes vectors with the key_index attribute while building the buffer.
+void KeyIndexInBufferTest() {
+  using namespace KeyIndexTest;
+  FlatBufferBuilder builder;
+  std::vector<Offset<Item>> items;
+  std::vector<Offset<Reading>> readings;
+  for (int i = 0; i < 1000; i++) {
+    // Names like "item_100" and "item_1000" share their first 8 bytes.
+    const auto name = "item_" + NumToString(i * 2);
+    items.push_back(CreateItemDirect(builder, name.c_str(), i));
+    readings.push_back(CreateReading(builder, static_cast<uint16_t>(i * 2),
+                                     static_cast<float>(i)));
+  }
+  builder.Finish(
+      CreateInventoryDirect(builder, &items, nullptr, nullptr, &readings));
+
+  Verifier verifier(builder.GetBufferPointer(), builder.GetSize());
+  TEST_ASSERT(VerifyInventoryBuffer(verifier));
+
+  auto inventory = GetMutableInventory(builder.GetBufferPointer());
+  // The size, a prefix per element, then a position per 2 elements.
+  TEST_EQ(inventory->items_index()->size(), 1 + 1000 + 500);
+  for (int i = 0; i < 2000; i++) {
+    const auto name = "item_" + NumToString(i);
+    auto item = inventory->items_by_key(name.c_str());
+    auto reading = inventory->readings_by_key(static_cast<uint16_t>(i));
+    TEST_EQ(item != nullptr, i % 2 == 0);
+    TEST_EQ(reading != nullptr, i % 2 == 0);
+    if (item) TEST_EQ(item->count(), i / 2);
+    if (reading) TEST_EQ(reading->value(), static_cast<float>(i / 2));
+  }
+  TEST_ASSERT(!inventory->items_by_key(""));
+  TEST_ASSERT(!inventory->items_by_key("item_9999"));
+  // Scalar keys of other types are converted to the key type first.
+  TEST_EQ(LookupByKeyIndex(inventory->readings(), inventory->readings_index(),
+                           6)
+              ->value(),
+          3.0f);
+
+  // Positions out of range make lookups miss, without failing verification.
+  auto index = inventory->mutable_readings_index();
+  std::vector<uint64_t> saved(index->begin(), index->end());
+  for (uoffset_t i = 1 + 1000; i < index->size(); i++) {
+    index->Mutate(i, ~0ULL);
+  }
+  Verifier stale_verifier(builder.GetBufferPointer(), builder.GetSize());
+  TEST_ASSERT(VerifyInventoryBuffer(stale_verifier));
+  TEST_ASSERT(!inventory->readings_by_key(6));
+
+  // An index for a vector of another size fails verification, and is
+  // ignored by lookups.
+  index->Mutate(0, 999);
+  Verifier bad_verifier(builder.GetBufferPointer(), builder.GetSize());
+  TEST_ASSERT(!VerifyInventoryBuffer(bad_verifier));
+  TEST_EQ(inventory->readings_by_key(6)->value(), 3.0f);
+  for (uoffset_t i = 0; i < index->size(); i++) index->Mutate(i, saved[i]);
+
+  // The object API rebuilds the index.
+  InventoryT inventory_obj;
+  for (int i = 0; i < 100; i++) {
+    inventory_obj.readings.emplace_back(new ReadingT());
+    inventory_obj.readings.back()->sensor = static_cast<uint16_t>(i);
+    inventory_obj.readings.back()->value = static_cast<float>(i);
+  }
+  FlatBufferBuilder packed;
+  packed.Finish(Inventory::Pack(packed, &inventory_obj));
+  auto packed_inventory = GetInventory(packed.GetBufferPointer());
+  TEST_EQ(packed_inventory->readings_index()->size(), 1 + 100 + 50);
+  TEST_EQ(packed_inventory->readings_by_key(42)->value(), 42.0f);
+
+  // Unsorted vectors, and ones too small to need an index, get none.
+  std::swap(inventory_obj.readings[0], inventory_obj.readings[1]);
+  inventory_obj.items.emplace_back(new ItemT());
+  inventory_obj.items.back()->name = "item";
+  FlatBufferBuilder unsorted;
+  unsorted.Finish(Inventory::Pack(unsorted, &inventory_obj));
+  auto unsorted_inventory = GetInventory(unsorted.GetBufferPointer());
+  TEST_ASSERT(!unsorted_inventory->readings_index());
+  TEST_ASSERT(!unsorted_inventory->items_index());
+  TEST_EQ(unsorted_inventory->items_by_key("item")->count(), 0);
+}
+
+}  // namespace
+
+void KeyIndexTest() {
+  KeyIndexInMemoryTest();
+  KeyIndexInBufferTest();
+}
+
+}  // namespace tests
+}  // namespace flatbuffers
@@ -0,0 +1,12 @@
+#ifndef TESTS_KEY_INDEX_TEST_H
+#define TESTS_KEY_INDEX_TEST_H
+
+namespace flatbuffers {
+namespace tests {
+
+void KeyIndexTest();
+
+}  // namespace tests
+}  // namespace flatbuffers
+
+#endif
@@ -0,0 +1,624 @@
+// automatically generated by the FlatBuffers compiler, do not modify
+
+
+#ifndef FLATBUFFERS_GENERATED_KEYINDEXTEST_KEYINDEXTEST_H_
+#define FLATBUFFERS_GENERATED_KEYINDEXTEST_KEYINDEXTEST_H_
+
+#include "flatbuffers/flatbuffers.h"
+#include "flatbuffers/key_index.h"
+
+// Ensure the included flatbuffers.h is the same version as when this file was
+// generated, otherwise it may not be compatible.
+static_assert(FLATBUFFERS_VERSION_MAJOR == 22 &&
+              FLATBUFFERS_VERSION_MINOR == 9 &&
+              FLATBUFFERS_VERSION_REVISION == 29,
+             "Non-compatible flatbuffers version included");
+
+namespace KeyIndexTest {
+
+struct Inventory;
+struct InventoryBuilder;
+struct InventoryT;
+
+struct Item;
+struct ItemBuilder;
+struct ItemT;
+
+struct Reading;
+struct ReadingBuilder;
+struct ReadingT;
+
+bool operator==(const InventoryT &lhs, const InventoryT &rhs);
+bool operator!=(const InventoryT &lhs, const InventoryT &rhs);
+bool operator==(const ItemT &lhs, const ItemT &rhs);
+bool operator!=(const ItemT &lhs, const ItemT &rhs);
+bool operator==(const ReadingT &lhs, const ReadingT &rhs);
+bool operator!=(const ReadingT &lhs, const ReadingT &rhs);
+
+inline const flatbuffers::TypeTable *InventoryTypeTable();
+
+inline const flatbuffers::TypeTable *ItemTypeTable();
+
+inline const flatbuffers::TypeTable *ReadingTypeTable();
+
+struct InventoryT : public flatbuffers::NativeTable {
+  typedef Inventory TableType;
+  std::vector<flatbuffers::unique_ptr<KeyIndexTest::ItemT>> items{};
+  std::vector<uint64_t> items_index{};
+  std::vector<uint64_t> readings_index{};
+  std::vector<flatbuffers::unique_ptr<KeyIndexTest::ReadingT>> readings{};
+  InventoryT() = default;
+  InventoryT(const InventoryT &o);
+  InventoryT(InventoryT&&) FLATBUFFERS_NOEXCEPT = default;
+  InventoryT &operator=(InventoryT o) FLATBUFFERS_NOEXCEPT;
+};
+
+struct Inventory FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef InventoryT NativeTableType;
+  typedef InventoryBuilder Builder;
+  static const flatbuffers::TypeTable *MiniReflectTypeTable() {
+    return InventoryTypeTable();
+  }
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_ITEMS = 4,
+    VT_ITEMS_INDEX = 6,
+    VT_READINGS_INDEX = 8,
+    VT_READINGS = 10
+  };
+  const flatbuffers::Vector<flatbuffers::Offset<KeyIndexTest::Item>> *items() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<KeyIndexTest::Item>> *>(VT_ITEMS);
+  }
+  flatbuffers::Vector<flatbuffers::Offset<KeyIndexTest::Item>> *mutable_items() {
+    return GetPointer<flatbuffers::Vector<flatbuffers::Offset<KeyIndexTest::Item>> *>(VT_ITEMS);
+  }
+  const KeyIndexTest::Item *items_by_key(const char *key) const {
+    return flatbuffers::LookupByKeyIndex(items(), items_index(), key);
+  }
+  const flatbuffers::Vector<uint64_t> *items_index() const {
+    return GetPointer<const flatbuffers::Vector<uint64_t> *>(VT_ITEMS_INDEX);
+  }
+  flatbuffers::Vector<uint64_t> *mutable_items_index() {
+    return GetPointer<flatbuffers::Vector<uint64_t> *>(VT_ITEMS_INDEX);
+  }
+  const flatbuffers::Vector<uint64_t> *readings_index() const {
+    return GetPointer<const flatbuffers::Vector<uint64_t> *>(VT_READINGS_INDEX);
+  }
+  flatbuffers::Vector<uint64_t> *mutable_readings_index() {
+    return GetPointer<flatbuffers::Vector<uint64_t> *>(VT_READINGS_INDEX);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<KeyIndexTest::Reading>> *readings() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<KeyIndexTest::Reading>> *>(VT_READINGS);
+  }
+  flatbuffers::Vector<flatbuffers::Offset<KeyIndexTest::Reading>> *mutable_readings() {
+    return GetPointer<flatbuffers::Vector<flatbuffers::Offset<KeyIndexTest::Reading>> *>(VT_READINGS);
+  }
+  const KeyIndexTest::Reading *readings_by_key(uint16_t key) const {
+    return flatbuffers::LookupByKeyIndex(readings(), readings_index(), key);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_ITEMS) &&
+           verifier.VerifyVector(items()) &&
+           verifier.VerifyVectorOfTables(items()) &&
+           VerifyOffset(verifier, VT_ITEMS_INDEX) &&
+           verifier.VerifyVector(items_index()) &&
+           VerifyOffset(verifier, VT_READINGS_INDEX) &&
+           verifier.VerifyVector(readings_index()) &&
+           VerifyOffset(verifier, VT_READINGS) &&
+           verifier.VerifyVector(readings()) &&
+           verifier.VerifyVectorOfTables(readings()) &&
+           flatbuffers::VerifyKeyIndex(verifier, items(), items_index()) &&
+           flatbuffers::VerifyKeyIndex(verifier, readings(), readings_index()) &&
+           verifier.EndTable();
+  }
+  InventoryT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(InventoryT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<Inventory> Pack(flatbuffers::FlatBufferBuilder &_fbb, const InventoryT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
+
+struct InventoryBuilder {
+  typedef Inventory Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_items(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<KeyIndexTest::Item>>> items) {
+    fbb_.AddOffset(Inventory::VT_ITEMS, items);
+  }
+  void add_items_index(flatbuffers::Offset<flatbuffers::Vector<uint64_t>> items_index) {
+    fbb_.AddOffset(Inventory::VT_ITEMS_INDEX, items_index);
+  }
+  void add_readings_index(flatbuffers::Offset<flatbuffers::Vector<uint64_t>> readings_index) {
+    fbb_.AddOffset(Inventory::VT_READINGS_INDEX, readings_index);
+  }
+  void add_readings(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<KeyIndexTest::Reading>>> readings) {
+    fbb_.AddOffset(Inventory::VT_READINGS, readings);
+  }
+  explicit InventoryBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<Inventory> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<Inventory>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<Inventory> CreateInventory(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<KeyIndexTest::Item>>> items = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint64_t>> items_index = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint64_t>> readings_index = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<KeyIndexTest::Reading>>> readings = 0) {
+  InventoryBuilder builder_(_fbb);
+  builder_.add_readings(readings);
+  builder_.add_readings_index(readings_index);
+  builder_.add_items_index(items_index);
+  builder_.add_items(items);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<Inventory> CreateInventoryDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    std::vector<flatbuffers::Offset<KeyIndexTest::Item>> *items = nullptr,
+    const std::vector<uint64_t> *items_index = nullptr,
+    const std::vector<uint64_t> *readings_index = nullptr,
+    std::vector<flatbuffers::Offset<KeyIndexTest::Reading>> *readings = nullptr) {
+  auto items__ = items ? _fbb.CreateVectorOfSortedTables<KeyIndexTest::Item>(items) : 0;
+  auto readings__ = readings ? _fbb.CreateVectorOfSortedTables<KeyIndexTest::Reading>(readings) : 0;
+  auto items_index__ = items_index
+      ? _fbb.CreateVector<uint64_t>(*items_index)
+      : flatbuffers::CreateKeyIndex(_fbb, items__);
+  auto readings_index__ = readings_index
+      ? _fbb.CreateVector<uint64_t>(*readings_index)
+      : flatbuffers::CreateKeyIndex(_fbb, readings__);
+  return KeyIndexTest::CreateInventory(
+      _fbb,
+      items__,
+      items_index__,
+      readings_index__,
+      readings__);
+}
+
+flatbuffers::Offset<Inventory> CreateInventory(flatbuffers::FlatBufferBuilder &_fbb, const InventoryT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
+struct ItemT : public flatbuffers::NativeTable {
+  typedef Item TableType;
+  std::string name{};
+  int32_t count = 0;
+};
+
+struct Item FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef ItemT NativeTableType;
+  typedef ItemBuilder Builder;
+  static const flatbuffers::TypeTable *MiniReflectTypeTable() {
+    return ItemTypeTable();
+  }
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_NAME = 4,
+    VT_COUNT = 6
+  };
+  const flatbuffers::String *name() const {
+    return GetPointer<const flatbuffers::String *>(VT_NAME);
+  }
+  flatbuffers::String *mutable_name() {
+    return GetPointer<flatbuffers::String *>(VT_NAME);
+  }
+  bool KeyCompareLessThan(const Item *o) const {
+    return *name() < *o->name();
+  }
+  int KeyCompareWithValue(const char *_name) const {
+    return strcmp(name()->c_str(), _name);
+  }
+  const flatbuffers::String *KeyIndexKey() const {
+    return name();
+  }
+  int32_t count() const {
+    return GetField<int32_t>(VT_COUNT, 0);
+  }
+  bool mutate_count(int32_t _count = 0) {
+    return SetField<int32_t>(VT_COUNT, _count, 0);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffsetRequired(verifier, VT_NAME) &&
+           verifier.VerifyString(name()) &&
+           VerifyField<int32_t>(verifier, VT_COUNT, 4) &&
+           verifier.EndTable();
+  }
+  ItemT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(ItemT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<Item> Pack(flatbuffers::FlatBufferBuilder &_fbb, const ItemT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
+
+struct ItemBuilder {
+  typedef Item Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_name(flatbuffers::Offset<flatbuffers::String> name) {
+    fbb_.AddOffset(Item::VT_NAME, name);
+  }
+  void add_count(int32_t count) {
+    fbb_.AddElement<int32_t>(Item::VT_COUNT, count, 0);
+  }
+  explicit ItemBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<Item> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<Item>(end);
+    fbb_.Required(o, Item::VT_NAME);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<Item> CreateItem(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::String> name = 0,
+    int32_t count = 0) {
+  ItemBuilder builder_(_fbb);
+  builder_.add_count(count);
+  builder_.add_name(name);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<Item> CreateItemDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const char *name = nullptr,
+    int32_t count = 0) {
+  auto name__ = name ? _fbb.CreateString(name) : 0;
+  return KeyIndexTest::CreateItem(
+      _fbb,
+      name__,
+      count);
+}
+
+flatbuffers::Offset<Item> CreateItem(flatbuffers::FlatBufferBuilder &_fbb, const ItemT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
+struct ReadingT : public flatbuffers::NativeTable {
+  typedef Reading TableType;
+  uint16_t sensor = 0;
+  float value = 0.0f;
+};
+
+struct Reading FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef ReadingT NativeTableType;
+  typedef ReadingBuilder Builder;
+  static const flatbuffers::TypeTable *MiniReflectTypeTable() {
+    return ReadingTypeTable();
+  }
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_SENSOR = 4,
+    VT_VALUE = 6
+  };
+  uint16_t sensor() const {
+    return GetField<uint16_t>(VT_SENSOR, 0);
+  }
+  bool mutate_sensor(uint16_t _sensor = 0) {
+    return SetField<uint16_t>(VT_SENSOR, _sensor, 0);
+  }
+  bool KeyCompareLessThan(const Reading *o) const {
+    return sensor() < o->sensor();
+  }
+  int KeyCompareWithValue(uint16_t _sensor) const {
+    return static_cast<int>(sensor() > _sensor) - static_cast<int>(sensor() < _sensor);
+  }
+  uint16_t KeyIndexKey() const {
+    return sensor();
+  }
+  float value() const {
+    return GetField<float>(VT_VALUE, 0.0f);
+  }
+  bool mutate_value(float _value = 0.0f) {
+    return SetField<float>(VT_VALUE, _value, 0.0f);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint16_t>(verifier, VT_SENSOR, 2) &&
+           VerifyField<float>(verifier, VT_VALUE, 4) &&
+           verifier.EndTable();
+  }
+  ReadingT *UnPack(const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  void UnPackTo(ReadingT *_o, const flatbuffers::resolver_function_t *_resolver = nullptr) const;
+  static flatbuffers::Offset<Reading> Pack(flatbuffers::FlatBufferBuilder &_fbb, const ReadingT* _o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+};
+
+struct ReadingBuilder {
+  typedef Reading Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_sensor(uint16_t sensor) {
+    fbb_.AddElement<uint16_t>(Reading::VT_SENSOR, sensor, 0);
+  }
+  void add_value(float value) {
+    fbb_.AddElement<float>(Reading::VT_VALUE, value, 0.0f);
+  }
+  explicit ReadingBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  flatbuffers::Offset<Reading> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<Reading>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<Reading> CreateReading(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    uint16_t sensor = 0,
+    float value = 0.0f) {
+  ReadingBuilder builder_(_fbb);
+  builder_.add_value(value);
+  builder_.add_sensor(sensor);
+  return builder_.Finish();
+}
+
+flatbuffers::Offset<Reading> CreateReading(flatbuffers::FlatBufferBuilder &_fbb, const ReadingT *_o, const flatbuffers::rehasher_function_t *_rehasher = nullptr);
+
+
+inline bool operator==(const InventoryT &lhs, const InventoryT &rhs) {
+  return
+      (lhs.items.size() == rhs.items.size() && std::equal(lhs.items.cbegin(), lhs.items.cend(), rhs.items.cbegin(), [](flatbuffers::unique_ptr<KeyIndexTest::ItemT> const &a, flatbuffers::unique_ptr<KeyIndexTest::ItemT> const &b) { return (a == b) || (a && b && *a == *b); })) &&
+      (lhs.items_index == rhs.items_index) &&
+      (lhs.readings_index == rhs.readings_index) &&
+      (lhs.readings.size() == rhs.readings.size() && std::equal(lhs.readings.cbegin(), lhs.readings.cend(), rhs.readings.cbegin(), [](flatbuffers::unique_ptr<KeyIndexTest::ReadingT> const &a, flatbuffers::unique_ptr<KeyIndexTest::ReadingT> const &b) { return (a == b) || (a && b && *a == *b); }));
+}
+
+inline bool operator!=(const InventoryT &lhs, const InventoryT &rhs) {
+    return !(lhs == rhs);
+}
+
+
+inline InventoryT::InventoryT(const InventoryT &o)
+      : items_index(o.items_index),
+        readings_index(o.readings_index) {
+  items.reserve(o.items.size());
+  for (const auto &items_ : o.items) { items.emplace_back((items_) ? new KeyIndexTest::ItemT(*items_) : nullptr); }
+  readings.reserve(o.readings.size());
+  for (const auto &readings_ : o.readings) { readings.emplace_back((readings_) ? new KeyIndexTest::ReadingT(*readings_) : nullptr); }
+}
+
+inline InventoryT &InventoryT::operator=(InventoryT o) FLATBUFFERS_NOEXCEPT {
+  std::swap(items, o.items);
+  std::swap(items_index, o.items_index);
+  std::swap(readings_index, o.readings_index);
+  std::swap(readings, o.readings);
+  return *this;
+}
+
+inline InventoryT *Inventory::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = std::unique_ptr<InventoryT>(new InventoryT());
+  UnPackTo(_o.get(), _resolver);
+  return _o.release();
+}
+
+inline void Inventory::UnPackTo(InventoryT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = items(); if (_e) { _o->items.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { if(_o->items[_i]) { _e->Get(_i)->UnPackTo(_o->items[_i].get(), _resolver); } else { _o->items[_i] = flatbuffers::unique_ptr<KeyIndexTest::ItemT>(_e->Get(_i)->UnPack(_resolver)); }; } } else { _o->items.resize(0); } }
+  { auto _e = items_index(); if (_e) { _o->items_index.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->items_index[_i] = _e->Get(_i); } } else { _o->items_index.resize(0); } }
+  { auto _e = readings_index(); if (_e) { _o->readings_index.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { _o->readings_index[_i] = _e->Get(_i); } } else { _o->readings_index.resize(0); } }
+  { auto _e = readings(); if (_e) { _o->readings.resize(_e->size()); for (flatbuffers::uoffset_t _i = 0; _i < _e->size(); _i++) { if(_o->readings[_i]) { _e->Get(_i)->UnPackTo(_o->readings[_i].get(), _resolver); } else { _o->readings[_i] = flatbuffers::unique_ptr<KeyIndexTest::ReadingT>(_e->Get(_i)->UnPack(_resolver)); }; } } else { _o->readings.resize(0); } }
+}
+
+inline flatbuffers::Offset<Inventory> Inventory::Pack(flatbuffers::FlatBufferBuilder &_fbb, const InventoryT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateInventory(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<Inventory> CreateInventory(flatbuffers::FlatBufferBuilder &_fbb, const InventoryT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  struct _VectorArgs { flatbuffers::FlatBufferBuilder *__fbb; const InventoryT* __o; const flatbuffers::rehasher_function_t *__rehasher; } _va = { &_fbb, _o, _rehasher}; (void)_va;
+  auto _items = _o->items.size() ? _fbb.CreateVector<flatbuffers::Offset<KeyIndexTest::Item>> (_o->items.size(), [](size_t i, _VectorArgs *__va) { return CreateItem(*__va->__fbb, __va->__o->items[i].get(), __va->__rehasher); }, &_va ) : 0;
+  auto _readings = _o->readings.size() ? _fbb.CreateVector<flatbuffers::Offset<KeyIndexTest::Reading>> (_o->readings.size(), [](size_t i, _VectorArgs *__va) { return CreateReading(*__va->__fbb, __va->__o->readings[i].get(), __va->__rehasher); }, &_va ) : 0;
+  auto _items_index = flatbuffers::CreateKeyIndex(_fbb, _items);
+  auto _readings_index = flatbuffers::CreateKeyIndex(_fbb, _readings);
+  return KeyIndexTest::CreateInventory(
+      _fbb,
+      _items,
+      _items_index,
+      _readings_index,
+      _readings);
+}
+
+
+inline bool operator==(const ItemT &lhs, const ItemT &rhs) {
+  return
+      (lhs.name == rhs.name) &&
+      (lhs.count == rhs.count);
+}
+
+inline bool operator!=(const ItemT &lhs, const ItemT &rhs) {
+    return !(lhs == rhs);
+}
+
+
+inline ItemT *Item::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = std::unique_ptr<ItemT>(new ItemT());
+  UnPackTo(_o.get(), _resolver);
+  return _o.release();
+}
+
+inline void Item::UnPackTo(ItemT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = name(); if (_e) _o->name.assign(_e->c_str(), _e->size()); else _o->name.clear(); }
+  { auto _e = count(); _o->count = _e; }
+}
+
+inline flatbuffers::Offset<Item> Item::Pack(flatbuffers::FlatBufferBuilder &_fbb, const ItemT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateItem(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<Item> CreateItem(flatbuffers::FlatBufferBuilder &_fbb, const ItemT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  struct _VectorArgs { flatbuffers::FlatBufferBuilder *__fbb; const ItemT* __o; const flatbuffers::rehasher_function_t *__rehasher; } _va = { &_fbb, _o, _rehasher}; (void)_va;
+  auto _name = _fbb.CreateString(_o->name);
+  auto _count = _o->count;
+  return KeyIndexTest::CreateItem(
+      _fbb,
+      _name,
+      _count);
+}
+
+
+inline bool operator==(const ReadingT &lhs, const ReadingT &rhs) {
+  return
+      (lhs.sensor == rhs.sensor) &&
+      (lhs.value == rhs.value);
+}
+
+inline bool operator!=(const ReadingT &lhs, const ReadingT &rhs) {
+    return !(lhs == rhs);
+}
+
+
+inline ReadingT *Reading::UnPack(const flatbuffers::resolver_function_t *_resolver) const {
+  auto _o = std::unique_ptr<ReadingT>(new ReadingT());
+  UnPackTo(_o.get(), _resolver);
+  return _o.release();
+}
+
+inline void Reading::UnPackTo(ReadingT *_o, const flatbuffers::resolver_function_t *_resolver) const {
+  (void)_o;
+  (void)_resolver;
+  { auto _e = sensor(); _o->sensor = _e; }
+  { auto _e = value(); _o->value = _e; }
+}
+
+inline flatbuffers::Offset<Reading> Reading::Pack(flatbuffers::FlatBufferBuilder &_fbb, const ReadingT* _o, const flatbuffers::rehasher_function_t *_rehasher) {
+  return CreateReading(_fbb, _o, _rehasher);
+}
+
+inline flatbuffers::Offset<Reading> CreateReading(flatbuffers::FlatBufferBuilder &_fbb, const ReadingT *_o, const flatbuffers::rehasher_function_t *_rehasher) {
+  (void)_rehasher;
+  (void)_o;
+  struct _VectorArgs { flatbuffers::FlatBufferBuilder *__fbb; const ReadingT* __o; const flatbuffers::rehasher_function_t *__rehasher; } _va = { &_fbb, _o, _rehasher}; (void)_va;
+  auto _sensor = _o->sensor;
+  auto _value = _o->value;
+  return KeyIndexTest::CreateReading(
+      _fbb,
+      _sensor,
+      _value);
+}
+
+inline const flatbuffers::TypeTable *InventoryTypeTable() {
+  static const flatbuffers::TypeCode type_codes[] = {
+    { flatbuffers::ET_SEQUENCE, 1, 0 },
+    { flatbuffers::ET_ULONG, 1, -1 },
+    { flatbuffers::ET_ULONG, 1, -1 },
+    { flatbuffers::ET_SEQUENCE, 1, 1 }
+  };
+  static const flatbuffers::TypeFunction type_refs[] = {
+    KeyIndexTest::ItemTypeTable,
+    KeyIndexTest::ReadingTypeTable
+  };
+  static const char * const names[] = {
+    "items",
+    "items_index",
+    "readings_index",
+    "readings"
+  };
+  static const flatbuffers::TypeTable tt = {
+    flatbuffers::ST_TABLE, 4, type_codes, type_refs, nullptr, nullptr, names
+  };
+  return &tt;
+}
+
+inline const flatbuffers::TypeTable *ItemTypeTable() {
+  static const flatbuffers::TypeCode type_codes[] = {
+    { flatbuffers::ET_STRING, 0, -1 },
+    { flatbuffers::ET_INT, 0, -1 }
+  };
+  static const char * const names[] = {
+    "name",
+    "count"
+  };
+  static const flatbuffers::TypeTable tt = {
+    flatbuffers::ST_TABLE, 2, type_codes, nullptr, nullptr, nullptr, names
+  };
+  return &tt;
+}
+
+inline const flatbuffers::TypeTable *ReadingTypeTable() {
+  static const flatbuffers::TypeCode type_codes[] = {
+    { flatbuffers::ET_USHORT, 0, -1 },
+    { flatbuffers::ET_FLOAT, 0, -1 }
+  };
+  static const char * const names[] = {
+    "sensor",
+    "value"
+  };
+  static const flatbuffers::TypeTable tt = {
+    flatbuffers::ST_TABLE, 2, type_codes, nullptr, nullptr, nullptr, names
+  };
+  return &tt;
+}
+
+inline const KeyIndexTest::Inventory *GetInventory(const void *buf) {
+  return flatbuffers::GetRoot<KeyIndexTest::Inventory>(buf);
+}
+
+inline const KeyIndexTest::Inventory *GetSizePrefixedInventory(const void *buf) {
+  return flatbuffers::GetSizePrefixedRoot<KeyIndexTest::Inventory>(buf);
+}
+
+inline Inventory *GetMutableInventory(void *buf) {
+  return flatbuffers::GetMutableRoot<Inventory>(buf);
+}
+
+inline KeyIndexTest::Inventory *GetMutableSizePrefixedInventory(void *buf) {
+  return flatbuffers::GetMutableSizePrefixedRoot<KeyIndexTest::Inventory>(buf);
+}
+
+inline bool VerifyInventoryBuffer(
+    flatbuffers::Verifier &verifier) {
+  return verifier.VerifyBuffer<KeyIndexTest::Inventory>(nullptr);
+}
+
+inline bool VerifySizePrefixedInventoryBuffer(
+    flatbuffers::Verifier &verifier) {
+  return verifier.VerifySizePrefixedBuffer<KeyIndexTest::Inventory>(nullptr);
+}
+
+inline void FinishInventoryBuffer(
+    flatbuffers::FlatBufferBuilder &fbb,
+    flatbuffers::Offset<KeyIndexTest::Inventory> root) {
+  fbb.Finish(root);
+}
+
+inline void FinishSizePrefixedInventoryBuffer(
+    flatbuffers::FlatBufferBuilder &fbb,
+    flatbuffers::Offset<KeyIndexTest::Inventory> root) {
+  fbb.FinishSizePrefixed(root);
+}
+
+inline flatbuffers::unique_ptr<KeyIndexTest::InventoryT> UnPackInventory(
+    const void *buf,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  return flatbuffers::unique_ptr<KeyIndexTest::InventoryT>(GetInventory(buf)->UnPack(res));
+}
+
+inline flatbuffers::unique_ptr<KeyIndexTest::InventoryT> UnPackSizePrefixedInventory(
+    const void *buf,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  return flatbuffers::unique_ptr<KeyIndexTest::InventoryT>(GetSizePrefixedInventory(buf)->UnPack(res));
+}
+
+inline void UnPackToInventory(
+    const void *buf, KeyIndexTest::InventoryT *_o,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  GetInventory(buf)->UnPackTo(_o, res);
+}
+
+inline void UnPackToSizePrefixedInventory(
+    const void *buf, KeyIndexTest::InventoryT *_o,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  GetSizePrefixedInventory(buf)->UnPackTo(_o, res);
+}
+
+}  // namespace KeyIndexTest
+
+#endif  // FLATBUFFERS_GENERATED_KEYINDEXTEST_KEYINDEXTEST_H_
@@ -412,6 +412,18 @@ inline flatbuffers::unique_ptr<MyGame::MonsterExtraT> UnPackSizePrefixedMonsterE
   return flatbuffers::unique_ptr<MyGame::MonsterExtraT>(GetSizePrefixedMonsterExtra(buf)->UnPack(res));
 }
 
+inline void UnPackToMonsterExtra(
+    const void *buf, MyGame::MonsterExtraT *_o,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  GetMonsterExtra(buf)->UnPackTo(_o, res);
+}
+
+inline void UnPackToSizePrefixedMonsterExtra(
+    const void *buf, MyGame::MonsterExtraT *_o,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  GetSizePrefixedMonsterExtra(buf)->UnPackTo(_o, res);
+}
+
 }  // namespace MyGame
 
 #endif  // FLATBUFFERS_GENERATED_MONSTEREXTRA_MYGAME_H_
@@ -792,6 +792,61 @@ void ParseAndGenerateTextTest(const std::string &tests_data_path, bool binary) {
   // If this fails, check registry.lasterror_.
   TEST_EQ(ok, true);
   TEST_EQ_STR(text.c_str(), jsonfile.c_str());
+  // Later calls reuse the parsed schema.
+  auto buf2 = registry.TextToFlatBuffer(jsonfile.c_str(), MonsterIdentifier());
+  TEST_EQ(buf2.size(), buf.size());
+  TEST_EQ(memcmp(buf2.data(), buf.data(), buf.size()), 0);
+  text.clear();
+  TEST_EQ(registry.FlatBufferToText(buf2.data(), buf2.size(), &text), true);
+  TEST_EQ_STR(text.c_str(), jsonfile.c_str());
+  TEST_ASSERT(!registry.TextToFlatBuffer("{ nope: 1 }", MonsterIdentifier())
+                   .data());
+  TEST_EQ(registry.GetLastError().empty(), false);
+  // The parser that failed was dropped, so the next one is deserialized from
+  // the binary form of the schema, and must still know color is bit_flags.
+  flatbuffers::FlatBufferBuilder flags_fbb;
+  const auto flags = static_cast<Color>(Color_Red | Color_Green);
+  FinishMonsterBuffer(flags_fbb, CreateMonster(flags_fbb, nullptr, 150, 80,
+                                               flags_fbb.CreateString("Flags"),
+                                               0, flags));
+  text.clear();
+  TEST_EQ(registry.FlatBufferToText(flags_fbb.GetBufferPointer(),
+                                    flags_fbb.GetSize(), &text),
+          true);
+  TEST_NOTNULL(strstr(text.c_str(), "color: \"Red Green\""));
+  TEST_ASSERT(!registry.TextToFlatBuffer(jsonfile.c_str(), "NONE").data());
+  // Changing the options reloads the schema.
+  registry.SetOptions(flatbuffers::IDLOptions());
+  buf2 = registry.TextToFlatBuffer(jsonfile.c_str(), MonsterIdentifier());
+  TEST_EQ(buf2.size(), buf.size());
+  // Schemas that can't be loaded say so.
+  registry.Register("NONE", "does_not_exist.fbs");
+  TEST_ASSERT(!registry.TextToFlatBuffer("{}", "NONE").data());
+  TEST_EQ_STR(registry.GetLastError().c_str(),
+              "could not load schema: does_not_exist.fbs");
+
+  // Binary schemas can be registered from files or memory.
+  flatbuffers::Registry bfbs_registry;
+  bfbs_registry.Register(MonsterIdentifier(),
+                         (tests_data_path + "monster_test.bfbs").c_str());
+  text.clear();
+  TEST_EQ(bfbs_registry.FlatBufferToText(buf.data(), buf.size(), &text), true);
+  TEST_EQ_STR(text.c_str(), jsonfile.c_str());
+  std::string bfbs;
+  TEST_EQ(flatbuffers::LoadFile((tests_data_path + "monster_test.bfbs").c_str(),
+                                true, &bfbs),
+          true);
+  TEST_EQ(bfbs_registry.RegisterBinarySchema(
+              MonsterIdentifier(),
+              reinterpret_cast<const uint8_t *>(bfbs.data()), bfbs.size()),
+          true);
+  buf2 = bfbs_registry.TextToFlatBuffer(jsonfile.c_str(), MonsterIdentifier());
+  TEST_EQ(buf2.size(), buf.size());
+  TEST_EQ(bfbs_registry.RegisterBinarySchema(
+              MonsterIdentifier(),
+              reinterpret_cast<const uint8_t *>(jsonfile.data()),
+              jsonfile.size()),
+          false);
 
   // Generate text for UTF-8 strings without escapes.
   std::string jsonfile_utf8;
@@ -839,6 +894,62 @@ void UnPackTo(const uint8_t *flatbuf) {
 
   // The monster shouldn't have any enemies, because monster didn't.
   TEST_ASSERT(mon.enemy == nullptr);
+
+  // Unpacking into it again reuses what it has allocated: strings keep their
+  // capacity, and the union value and struct are unpacked in place.
+  mon.name.reserve(1000);
+  const auto name_capacity = mon.name.capacity();
+  const auto test_monster = mon.test.AsMonster();
+  const auto pos = mon.pos.get();
+  TEST_NOTNULL(test_monster);
+  TEST_NOTNULL(pos);
+  test_monster->name = "Not Fred";
+  mon.any_unique.Set(TestSimpleTableWithEnumT());
+  UnPackToMonster(flatbuf, &mon);
+  TEST_EQ_STR(mon.name.c_str(), "MyMonster");
+  TEST_EQ(mon.name.capacity(), name_capacity);
+  TEST_EQ(mon.test.AsMonster(), test_monster);
+  TEST_EQ_STR(test_monster->name.c_str(), "Fred");
+  TEST_EQ(mon.pos.get(), pos);
+  TEST_EQ(pos->z(), 3);
+  // Unions the buffer doesn't have are cleared.
+  TEST_EQ(mon.any_unique.type, AnyUniqueAliases_NONE);
+  TEST_ASSERT(mon.any_unique.value == nullptr);
+
+  // A union value of another type is replaced.
+  mon.test.Set(TestSimpleTableWithEnumT());
+  orig_monster->UnPackTo(&mon);
+  TEST_NOTNULL(mon.test.AsMonster());
+  TEST_EQ_STR(mon.test.AsMonster()->name.c_str(), "Fred");
+
+  // Fields absent from the next buffer don't survive in the reused object,
+  // including those of a union value that is unpacked in place.
+  MonsterT full;
+  full.name = "Full";
+  full.inventory = { 1, 2, 3 };
+  full.native_inline = Test(1, 2);
+  full.pos.reset(new Vec3(1, 2, 3, 0, Color_Red, Test(10, 20)));
+  MonsterT inner;
+  inner.name = "Inner";
+  inner.inventory = { 4, 5 };
+  inner.testnestedflatbuffer = { 6 };
+  full.test.Set(inner);
+  MonsterT sparse;
+  sparse.name = "Sparse";
+  inner.inventory.clear();
+  inner.testnestedflatbuffer.clear();
+  sparse.test.Set(inner);
+  flatbuffers::FlatBufferBuilder fbb_full, fbb_sparse;
+  FinishMonsterBuffer(fbb_full, Monster::Pack(fbb_full, &full));
+  FinishMonsterBuffer(fbb_sparse, Monster::Pack(fbb_sparse, &sparse));
+  MonsterT reused;
+  UnPackToMonster(fbb_full.GetBufferPointer(), &reused);
+  TEST_ASSERT(reused == *UnPackMonster(fbb_full.GetBufferPointer()));
+  UnPackToMonster(fbb_sparse.GetBufferPointer(), &reused);
+  TEST_ASSERT(reused == *UnPackMonster(fbb_sparse.GetBufferPointer()));
+  TEST_EQ(reused.test.AsMonster()->inventory.size(), 0);
+  TEST_EQ(reused.native_inline.a(), 0);
+  TEST_ASSERT(reused.pos == nullptr);
 }
 
 }  // namespace tests
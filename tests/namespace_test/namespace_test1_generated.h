@@ -105,6 +105,7 @@ struct UnionInNestedNSUnion {
   }
 
   static void *UnPack(const void *obj, UnionInNestedNS type, const flatbuffers::resolver_function_t *resolver);
+  void UnPackTo(const void *obj, UnionInNestedNS obj_type, const flatbuffers::resolver_function_t *resolver);
   flatbuffers::Offset<void> Pack(flatbuffers::FlatBufferBuilder &_fbb, const flatbuffers::rehasher_function_t *_rehasher = nullptr) const;
 
   NamespaceA::NamespaceB::TableInNestedNST *AsTableInNestedNS() {
@@ -357,6 +358,23 @@ inline void *UnionInNestedNSUnion::UnPack(const void *obj, UnionInNestedNS type,
   }
 }
 
+inline void UnionInNestedNSUnion::UnPackTo(const void *obj, UnionInNestedNS obj_type, const flatbuffers::resolver_function_t *resolver) {
+  if (!obj || obj_type != type || !value) {
+    Reset();
+    if (obj) value = UnPack(obj, obj_type, resolver);
+    type = obj_type;
+    return;
+  }
+  switch (type) {
+    case UnionInNestedNS_TableInNestedNS: {
+      auto ptr = reinterpret_cast<const NamespaceA::NamespaceB::TableInNestedNS *>(obj);
+      ptr->UnPackTo(reinterpret_cast<NamespaceA::NamespaceB::TableInNestedNST *>(value), resolver);
+      break;
+    }
+    default: break;
+  }
+}
+
 inline flatbuffers::Offset<void> UnionInNestedNSUnion::Pack(flatbuffers::FlatBufferBuilder &_fbb, const flatbuffers::rehasher_function_t *_rehasher) const {
   (void)_rehasher;
   switch (type) {
@@ -333,6 +333,18 @@ inline flatbuffers::unique_ptr<Geometry::ApplicationDataT> UnPackSizePrefixedApp
   return flatbuffers::unique_ptr<Geometry::ApplicationDataT>(GetSizePrefixedApplicationData(buf)->UnPack(res));
 }
 
+inline void UnPackToApplicationData(
+    const void *buf, Geometry::ApplicationDataT *_o,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  GetApplicationData(buf)->UnPackTo(_o, res);
+}
+
+inline void UnPackToSizePrefixedApplicationData(
+    const void *buf, Geometry::ApplicationDataT *_o,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  GetSizePrefixedApplicationData(buf)->UnPackTo(_o, res);
+}
+
 }  // namespace Geometry
 
 #endif  // FLATBUFFERS_GENERATED_NATIVETYPETEST_GEOMETRY_H_
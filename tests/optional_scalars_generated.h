@@ -956,6 +956,18 @@ inline flatbuffers::unique_ptr<optional_scalars::ScalarStuffT> UnPackSizePrefixe
   return flatbuffers::unique_ptr<optional_scalars::ScalarStuffT>(GetSizePrefixedScalarStuff(buf)->UnPack(res));
 }
 
+inline void UnPackToScalarStuff(
+    const void *buf, optional_scalars::ScalarStuffT *_o,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  GetScalarStuff(buf)->UnPackTo(_o, res);
+}
+
+inline void UnPackToSizePrefixedScalarStuff(
+    const void *buf, optional_scalars::ScalarStuffT *_o,
+    const flatbuffers::resolver_function_t *res = nullptr) {
+  GetSizePrefixedScalarStuff(buf)->UnPackTo(_o, res);
+}
+
 }  // namespace optional_scalars
 
 #endif  // FLATBUFFERS_GENERATED_OPTIONALSCALARS_OPTIONAL_SCALARS_H_
@@ -104,6 +104,29 @@ void ErrorTest() {
   TestError("union X { Y }", "referenced");
   TestError("union Z { X } struct X { Y:int; }", "only tables");
   TestError("table X { Y:[int]; YLength:int; }", "clash");
+  TestError("table E { k:int (key); } table X { y:[E] (hash_index: 1); }",
+            "must be a string");
+  TestError(
+      "table E { k:int; } table X { y:[E] (hash_index: \"i\"); i:[uint]; }",
+      "vector of tables with a key");
+  TestError("table X { y:[int] (hash_index: \"i\"); i:[uint]; }",
+            "vector of tables with a key");
+  TestError("table E { k:int (key); } table X { y:[E] (hash_index: \"i\"); }",
+            "must name a [uint] field");
+  TestError(
+      "table E { k:int (key); } table X { y:[E] (hash_index: \"i\"); "
+      "i:[int]; }",
+      "must name a [uint] field");
+  TestError("table E { k:int (key); } table X { y:[E] (key_index: \"i\"); "
+            "i:[uint]; }",
+            "must name a [ulong] field");
+  TestError(
+      "table E { k:int; } table X { y:[E] (key_index: \"i\"); i:[ulong]; }",
+      "vector of tables with a key");
+  TestError(
+      "table E { k:int (key); } table X { y:[E] (key_index: \"i\", "
+      "hash_index: \"j\"); i:[ulong]; j:[uint]; }",
+      "only have one of hash_index and key_index");
   TestError("table X { Y:byte; } root_type X; { Y:1, Y:2 }", "more than once");
   // float to integer conversion is forbidden
   TestError("table X { Y:int; } root_type X; { Y:1.0 }", "float");
@@ -777,6 +800,46 @@ void UnicodeSurrogatesTest() {
 
 
 
+void StringConstantTest() {
+  flatbuffers::Parser parser;
+  TEST_EQ(parser.Parse("table T { F:string (id: 0); G:[string] (id: 1); }"
+                       "root_type T;\n"
+                       "/// Long runs of blanks and plain characters, with\n"
+                       "/// escapes and quotes at odd places.\n"
+                       "{\n"
+                       "                        F: \"0123456789abcdef\\t"
+                       "0123456789\\\"0123456789abcdef0123\\u00e9\",\n"
+                       "\t\t\t\t\t\t\t\t\t  \t \t \tG: ['single \"quoted\" "
+                       "string, long enough', \"\", \"\\\\\"]\n"
+                       "}"),
+          true);
+  auto root = flatbuffers::GetRoot<flatbuffers::Table>(
+      parser.builder_.GetBufferPointer());
+  auto string = root->GetPointer<flatbuffers::String *>(
+      flatbuffers::FieldIndexToOffset(0));
+  TEST_EQ_STR(string->c_str(),
+              "0123456789abcdef\t0123456789\"0123456789abcdef0123\xC3\xA9");
+  auto strings =
+      root->GetPointer<flatbuffers::Vector<flatbuffers::Offset<String>> *>(
+          flatbuffers::FieldIndexToOffset(1));
+  TEST_EQ(strings->size(), 3);
+  TEST_EQ_STR(strings->Get(0)->c_str(),
+              "single \"quoted\" string, long enough");
+  TEST_EQ_STR(strings->Get(1)->c_str(), "");
+  TEST_EQ_STR(strings->Get(2)->c_str(), "\\");
+
+  TestError(
+      "table T { F:string; }"
+      "root_type T;"
+      "{ F:\"\\uD800abcdefghijklmnopqrstuvwxyz\"}",
+      "unpaired high surrogate");
+  TestError(
+      "table T { F:string; }"
+      "root_type T;"
+      "{ F:\"abcdefghijklmnopqrstuvwxyz",
+      "illegal character in string constant");
+}
+
 void UnknownFieldsTest() {
   flatbuffers::IDLOptions opts;
   opts.skip_unexpected_fields_in_json = true;
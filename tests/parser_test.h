@@ -20,6 +20,7 @@ void UnicodeTest();
 void UnicodeTestAllowNonUTF8();
 void UnicodeTestGenerateTextFailsOnNonUTF8();
 void UnicodeSurrogatesTest();
+void StringConstantTest();
 void UnknownFieldsTest();
 void ParseUnionTest();
 void ValidSameNameDifferentNamespaceTest();
@@ -1,5 +1,7 @@
 #include "reflection_test.h"
 #include "arrays_test_generated.h"
+#include "flatbuffers/compiled_schema.h"
+#include "flatbuffers/idl.h"
 #include "flatbuffers/minireflect.h"
 #include "flatbuffers/reflection.h"
 #include "flatbuffers/reflection_generated.h"
@@ -245,6 +247,460 @@ void ReflectionTest(const std::string& tests_data_path, uint8_t *flatbuf, size_t
   TEST_EQ(flatbuffers::Verify(schema, *schema.root_table(),
                               fbb.GetBufferPointer(), fbb.GetSize()),
           true);
+
+  // Without string pooling, subtrees that were built in one go are copied
+  // as is. Not this whole buffer, which also holds unreferenced vectors.
+  fbb.Clear();
+  fbb.Finish(flatbuffers::CopyTable(fbb, schema, *root_table,
+                                    *flatbuffers::GetAnyRoot(flatbuf)),
+             MonsterIdentifier());
+  AccessFlatBufferTest(fbb.GetBufferPointer(), fbb.GetSize(), false);
+  // But a copy holds nothing else, so copying that is a memcpy.
+  std::vector<uint8_t> copy(fbb.GetBufferPointer(),
+                            fbb.GetBufferPointer() + fbb.GetSize());
+  fbb.Clear();
+  fbb.Finish(flatbuffers::CopyTable(fbb, schema, *root_table,
+                                    *flatbuffers::GetAnyRoot(copy.data())),
+             MonsterIdentifier());
+  TEST_EQ(fbb.GetSize(), copy.size());
+  TEST_EQ(memcmp(fbb.GetBufferPointer(), copy.data(), copy.size()), 0);
+  // Their names were created ahead of all of them, and two share a vtable.
+  auto tables = GetMonster(flatbuf)->testarrayoftables();
+  for (uoffset_t i = 0; i < tables->size(); i++) {
+    fbb.Clear();
+    fbb.CreateString("offset everything by a bit");
+    fbb.Finish(flatbuffers::CopyTable(
+                   fbb, schema, *root_table,
+                   *reinterpret_cast<const Table *>(tables->Get(i))),
+               MonsterIdentifier());
+    flatbuffers::Verifier copy_verifier(fbb.GetBufferPointer(),
+                                        fbb.GetSize());
+    TEST_EQ(VerifyMonsterBuffer(copy_verifier), true);
+    TEST_EQ_STR(GetMonster(fbb.GetBufferPointer())->name()->c_str(),
+                tables->Get(i)->name()->c_str());
+  }
+
+  // Only padding between the bytes of a subtree is copied along, not a short
+  // string of its parent's that happens to sit in a gap narrower than the
+  // alignment.
+  flatbuffers::Parser node_parser;
+  TEST_EQ(node_parser.Parse("struct Wide (force_align: 16) { x:long; }"
+                            "table Node { wide:Wide; name:string; child:Node; }"
+                            "root_type Node;"),
+          true);
+  node_parser.Serialize();
+  auto &node_schema =
+      *reflection::GetSchema(node_parser.builder_.GetBufferPointer());
+  auto &node = *node_schema.root_table();
+  fbb.Clear();
+  // Sized so that no padding precedes the struct, leaving only "secret"
+  // between the child's table and its name.
+  auto child_name = fbb.CreateString("child's name");
+  auto parent_name = fbb.CreateString("secret");
+  FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(16) Wide { int64_t x; };
+  FLATBUFFERS_STRUCT_END(Wide, 16);
+  const Wide wide = { 1 };
+  auto start = fbb.StartTable();
+  fbb.AddStruct(4, &wide);
+  fbb.AddOffset(6, child_name);
+  auto child = fbb.EndTable(start);
+  start = fbb.StartTable();
+  fbb.AddOffset(6, parent_name);
+  fbb.AddOffset(8, Offset<Table>(child));
+  fbb.Finish(Offset<Table>(fbb.EndTable(start)));
+  auto child_table = GetFieldT(*flatbuffers::GetAnyRoot(fbb.GetBufferPointer()),
+                               *node.fields()->LookupByKey("child"));
+  flatbuffers::FlatBufferBuilder node_fbb;
+  node_fbb.Finish(
+      flatbuffers::CopyTable(node_fbb, node_schema, node, *child_table));
+  TEST_EQ(flatbuffers::Verify(node_schema, node, node_fbb.GetBufferPointer(),
+                              node_fbb.GetSize()),
+          true);
+  const std::string node_copy(
+      reinterpret_cast<const char *>(node_fbb.GetBufferPointer()),
+      node_fbb.GetSize());
+  TEST_EQ(node_copy.find("child's name") != std::string::npos, true);
+  TEST_EQ(node_copy.find("secret"), std::string::npos);
+}
+
+void ResizeSessionTest(const std::string &tests_data_path, uint8_t *flatbuf,
+                       size_t length) {
+  std::string bfbsfile;
+  TEST_EQ(flatbuffers::LoadFile((tests_data_path + "monster_test.bfbs").c_str(),
+                                true, &bfbsfile),
+          true);
+  auto &schema = *reflection::GetSchema(bfbsfile.c_str());
+  std::vector<uint8_t> resizingbuf(flatbuf, flatbuf + length);
+
+  // Nothing queued, nothing changes.
+  flatbuffers::ResizeSession session(schema, &resizingbuf);
+  session.Apply();
+  TEST_EQ(resizingbuf.size(), length);
+
+  // Queue changes all over the buffer, growing and shrinking. They all refer
+  // to the buffer as it was before Apply().
+  auto monster = GetMonster(resizingbuf.data());
+  session.SetString("MyMonster, now with a much longer name", monster->name());
+  // "fred" is pooled, so this also changes testarrayofstring[3], which then
+  // gets dropped by the resize below.
+  session.SetString("frederick the great",
+                    monster->testarrayofstring()->Get(1));
+  session.ResizeVector<Offset<String>>(3, 0, monster->testarrayofstring());
+  session.SetString("Wilma Flintstone",
+                    monster->testarrayoftables()->Get(2)->name());
+  session.SetString("", monster->testarrayofstring2()->Get(0));
+  session.ResizeVector<uint8_t>(1, 0, monster->inventory());
+  session.ResizeVector<uint8_t>(20, Color_Blue, monster->vector_of_enums());
+  TEST_EQ(session.size(), 7);
+  session.Apply();
+  TEST_EQ(session.size(), 0);
+
+  auto check = [&](const char *fred, const char *wilma) {
+    flatbuffers::Verifier verifier(resizingbuf.data(), resizingbuf.size());
+    TEST_EQ(VerifyMonsterBuffer(verifier), true);
+    TEST_EQ(flatbuffers::Verify(schema, *schema.root_table(),
+                                resizingbuf.data(), resizingbuf.size()),
+            true);
+    auto m = GetMonster(resizingbuf.data());
+    TEST_EQ(m->hp(), 80);
+    TEST_EQ(m->pos()->z(), 3);
+    TEST_EQ(m->testarrayofstring()->size(), 3);
+    TEST_EQ_STR(m->testarrayofstring()->Get(0)->c_str(), "bob");
+    TEST_EQ_STR(m->testarrayofstring()->Get(1)->c_str(), fred);
+    TEST_EQ_STR(m->testarrayofstring()->Get(2)->c_str(), "bob");
+    TEST_EQ_STR(m->testarrayoftables()->Get(0)->name()->c_str(), "Barney");
+    TEST_EQ_STR(m->testarrayoftables()->Get(2)->name()->c_str(), wilma);
+    TEST_EQ_STR(m->testarrayofstring2()->Get(0)->c_str(), "");
+    TEST_EQ_STR(m->testarrayofstring2()->Get(1)->c_str(), "mary");
+    TEST_EQ(m->inventory()->size(), 1);
+    TEST_EQ(m->inventory()->Get(0), 0);
+    TEST_EQ(m->vector_of_enums()->size(), 20);
+    TEST_EQ(m->vector_of_enums()->Get(1), Color_Green);
+    TEST_EQ(m->vector_of_enums()->Get(19), Color_Blue);
+    TEST_EQ_STR(m->test_as_Monster()->name()->c_str(), "Fred");
+    TEST_EQ(m->testnestedflatbuffer_nested_root()->name()->size(), 13);
+  };
+  check("frederick the great", "Wilma Flintstone");
+  TEST_EQ_STR(GetMonster(resizingbuf.data())->name()->c_str(),
+              "MyMonster, now with a much longer name");
+
+  // A session can be reused, and shrinking gives back the space.
+  auto size = resizingbuf.size();
+  monster = GetMonster(resizingbuf.data());
+  session.SetString("M", monster->name());
+  session.SetString("", monster->testarrayoftables()->Get(2)->name());
+  session.SetString("frederick the great, king of prussia",
+                    monster->testarrayofstring()->Get(1));
+  session.Apply();
+  TEST_EQ(resizingbuf.size(), size - 32 - 16 + 24);
+  check("frederick the great, king of prussia", "");
+  TEST_EQ_STR(GetMonster(resizingbuf.data())->name()->c_str(), "M");
+}
+
+void CompiledSchemaTest(const std::string &tests_data_path, uint8_t *flatbuf,
+                        size_t length) {
+  std::string bfbsfile;
+  TEST_EQ(flatbuffers::LoadFile((tests_data_path + "monster_test.bfbs").c_str(),
+                                true, &bfbsfile),
+          true);
+  auto &schema = *reflection::GetSchema(bfbsfile.c_str());
+  flatbuffers::CompiledSchema compiled(schema);
+  TEST_EQ(compiled.objects().size(), schema.objects()->size());
+  auto &monster = *compiled.root();
+  TEST_EQ(monster.def, schema.root_table());
+  TEST_EQ(compiled.LookupObject("MyGame.Example.Monster"), &monster);
+  TEST_ASSERT(!compiled.LookupObject("MyGame.Example.Dragon"));
+  TEST_ASSERT(!monster.LookupField("dragon"));
+
+  // Every scalar reads the same as through the schema. Defaults of absent
+  // fields are only stored in the schema as the field's own type.
+  auto &root = *flatbuffers::GetAnyRoot(flatbuf);
+  for (auto it = monster.fields.begin(); it != monster.fields.end(); ++it) {
+    TEST_EQ(it->def, schema.root_table()->fields()->LookupByKey(
+                         it->def->name()->c_str()));
+    if (it->kind != flatbuffers::CompiledSchema::kScalar) continue;
+    auto present = root.CheckField(it->offset);
+    if (present || !IsFloat(it->type)) {
+      TEST_EQ(flatbuffers::CompiledSchema::GetFieldI(root, *it),
+              flatbuffers::GetAnyFieldI(root, *it->def));
+    }
+    if (present || IsFloat(it->type)) {
+      TEST_EQ(flatbuffers::CompiledSchema::GetFieldF(root, *it),
+              flatbuffers::GetAnyFieldF(root, *it->def));
+    }
+  }
+  auto &hp = *monster.LookupField("hp");
+  TEST_EQ(flatbuffers::CompiledSchema::GetFieldI(root, hp), 80);
+  auto &pos = *monster.LookupField("pos");
+  TEST_EQ(pos.kind, flatbuffers::CompiledSchema::kStruct);
+  auto &vec3 = *pos.object;
+  TEST_EQ(flatbuffers::CompiledSchema::GetFieldF(
+              *root.GetStruct<const Struct *>(pos.offset),
+              *vec3.LookupField("z")),
+          3);
+  TEST_EQ_STR(flatbuffers::CompiledSchema::GetFieldS(
+                  root, *monster.LookupField("name"))
+                  ->c_str(),
+              "MyMonster");
+  auto &test = *monster.LookupField("test");
+  auto member = flatbuffers::CompiledSchema::GetUnionMember(root, test);
+  TEST_EQ(member.base_type, reflection::Obj);
+  TEST_EQ(member.object, &monster);
+  TEST_EQ_STR(flatbuffers::CompiledSchema::GetFieldS(
+                  *flatbuffers::CompiledSchema::GetFieldT(root, test),
+                  *monster.LookupField("name"))
+                  ->c_str(),
+              "Fred");
+
+  // The visit sees exactly the fields that are present.
+  size_t visited = 0;
+  flatbuffers::CompiledSchema::ForAllFields(
+      root, monster,
+      [&](const flatbuffers::CompiledSchema::Field &field,
+          const uint8_t *data) {
+        TEST_ASSERT(data == root.GetAddressOf(field.offset));
+        visited++;
+      });
+  size_t present = 0;
+  for (auto it = monster.fields.begin(); it != monster.fields.end(); ++it) {
+    present += root.CheckField(it->offset);
+  }
+  TEST_EQ(visited, present);
+
+  TEST_EQ(compiled.Verify(monster, flatbuf, length), true);
+  // Too short, or pointing out of the buffer.
+  TEST_EQ(compiled.Verify(monster, flatbuf, length / 2), false);
+  std::vector<uint8_t> corrupt(flatbuf, flatbuf + length);
+  auto name = GetMonster(corrupt.data())->name();
+  WriteScalar(reinterpret_cast<uint8_t *>(const_cast<String *>(name)),
+              static_cast<uoffset_t>(length));
+  TEST_EQ(compiled.Verify(monster, corrupt.data(), corrupt.size()), false);
+  TEST_EQ(flatbuffers::Verify(schema, *schema.root_table(), corrupt.data(),
+                              corrupt.size()),
+          false);
+
+  flatbuffers::FlatBufferBuilder fbb;
+  fbb.Finish(compiled.CopyTable(fbb, monster, root, true),
+             MonsterIdentifier());
+  AccessFlatBufferTest(fbb.GetBufferPointer(), fbb.GetSize());
+  TEST_EQ(compiled.Verify(monster, fbb.GetBufferPointer(), fbb.GetSize()),
+          true);
+  TEST_EQ(flatbuffers::Verify(schema, *schema.root_table(),
+                              fbb.GetBufferPointer(), fbb.GetSize()),
+          true);
+
+  // The verifier accepts vtables too short to hold their own sizes, which
+  // then have no fields.
+  auto &stat = *compiled.LookupObject("MyGame.Example.Stat");
+  for (uint8_t vsize = 0; vsize <= 2; vsize += 2) {
+    // The root offset, a vtable of "vsize" bytes at 4 and a table at 8.
+    const uint8_t bytes[] = { 8, 0, 0, 0, vsize, 0, 0, 0, 4, 0, 0, 0 };
+    const std::vector<uint8_t> buf(bytes, bytes + sizeof(bytes));
+    TEST_EQ(compiled.Verify(stat, buf.data(), buf.size()), true);
+    auto &table = *flatbuffers::GetAnyRoot(buf.data());
+    visited = 0;
+    flatbuffers::CompiledSchema::ForAllFields(
+        table, stat,
+        [&](const flatbuffers::CompiledSchema::Field &, const uint8_t *) {
+          visited++;
+        });
+    TEST_EQ(visited, 0);
+    fbb.Clear();
+    fbb.Finish(flatbuffers::CopyTable(fbb, schema, *stat.def, table));
+    TEST_EQ(compiled.Verify(stat, fbb.GetBufferPointer(), fbb.GetSize()),
+            true);
+  }
+}
+
+// Parses a schema, returning it as a binary schema.
+static std::string SerializeSchema(flatbuffers::Parser &parser,
+                                   const std::string &source) {
+  TEST_EQ(parser.Parse(source.c_str()), true);
+  parser.Serialize();
+  return std::string(
+      reinterpret_cast<const char *>(parser.builder_.GetBufferPointer()),
+      parser.builder_.GetSize());
+}
+
+void SchemaConverterTest(const std::string &tests_data_path,
+                         uint8_t *flatbuf) {
+  // A schema converts to itself as is.
+  std::string bfbsfile;
+  TEST_EQ(flatbuffers::LoadFile((tests_data_path + "monster_test.bfbs").c_str(),
+                                true, &bfbsfile),
+          true);
+  auto &schema = *reflection::GetSchema(bfbsfile.c_str());
+  flatbuffers::SchemaConverter same(schema, schema);
+  TEST_EQ_STR(same.error().c_str(), "");
+  flatbuffers::FlatBufferBuilder fbb;
+  same.Convert(fbb, flatbuf);
+  AccessFlatBufferTest(fbb.GetBufferPointer(), fbb.GetSize(), false);
+
+  // Every kind of change the converter supports: widened scalars and structs,
+  // renumbered enums, reordered unions, a renamed field and fields moved into
+  // a new table.
+  flatbuffers::Parser old_parser;
+  const auto old_bfbs = SerializeSchema(
+      old_parser,
+      "namespace Evo;"
+      "enum Color : byte { Red, Green, Blue }"
+      "table Sword { damage:short; }"
+      "table Shield { armor:int; }"
+      "struct Pos { x:float; y:float; }"
+      "union Equipment { Sword, Shield }"
+      "table Monster {"
+      "  name:string; hp:short = 100; mana:short = 50; color:Color = Green;"
+      "  pos:Pos; equipped:Equipment; inventory:[ubyte]; friends:[Monster];"
+      "  nick:string; path:[Pos]; level:ubyte = 1; loot:[Equipment];"
+      "}"
+      "root_type Monster;");
+  flatbuffers::Parser new_parser;
+  const auto new_bfbs = SerializeSchema(
+      new_parser,
+      "namespace Evo;"
+      "enum Color : short { Blue = 0, Red = 5, Green = 7 }"
+      "table Bow { range:float; }"
+      "table Shield { armor:long; }"
+      "table Sword { damage:int; }"
+      "struct Pos { x:double; y:double; z:double; }"
+      "union Equipment { Bow, Shield, Sword }"
+      "table Stats { hp:int = 100; mana:int = 50; }"
+      "table Monster {"
+      "  name:string (id: 0);"
+      "  hp:short = 100 (id: 1, deprecated);"
+      "  mana:short = 50 (id: 2, deprecated);"
+      "  color:Color = Green (id: 3);"
+      "  pos:Pos (id: 4);"
+      "  equipped:Equipment (id: 6);"
+      "  inventory:[ushort] (id: 7);"
+      "  friends:[Monster] (id: 8);"
+      "  nickname:string (id: 9);"
+      "  path:[Pos] (id: 10);"
+      "  level:int = 2 (id: 11);"
+      "  loot:[Equipment] (id: 13);"
+      "  stats:Stats (id: 14);"
+      "}"
+      "root_type Monster;"
+      "file_identifier \"EVO2\";");
+  auto &new_schema = *reflection::GetSchema(new_bfbs.c_str());
+  flatbuffers::SchemaConverter converter(
+      *reflection::GetSchema(old_bfbs.c_str()), new_schema);
+  TEST_EQ_STR(converter.error().c_str(), "");
+  TEST_EQ(old_parser.Parse(
+              "{ name: \"Orc\", hp: 300, color: Blue, pos: { x: 1, y: 2 },"
+              "  equipped_type: Sword, equipped: { damage: 7 },"
+              "  inventory: [1, 2, 255],"
+              "  friends: [{ name: \"Elf\", mana: 10 },"
+              "            { name: \"Imp\", color: Red }],"
+              "  nick: \"orcy\", path: [{ x: 1, y: 2 }, { x: 3, y: 4 }],"
+              "  loot_type: [Shield, Sword],"
+              "  loot: [{ armor: 3 }, { damage: 1 }] }"),
+          true);
+  fbb.Clear();
+  converter.Convert(fbb, old_parser.builder_.GetBufferPointer());
+  TEST_EQ(flatbuffers::BufferHasIdentifier(fbb.GetBufferPointer(), "EVO2"),
+          true);
+  TEST_EQ(flatbuffers::Verify(new_schema, *new_schema.root_table(),
+                              fbb.GetBufferPointer(), fbb.GetSize()),
+          true);
+  std::string converted;
+  TEST_EQ(GenerateText(new_parser, fbb.GetBufferPointer(), &converted), true);
+  // The old default level is written out, as the default changed.
+  TEST_EQ(new_parser.Parse(
+              "{ name: \"Orc\", color: Blue, pos: { x: 1, y: 2, z: 0 },"
+              "  equipped_type: Sword, equipped: { damage: 7 },"
+              "  inventory: [1, 2, 255],"
+              "  friends: [{ name: \"Elf\", level: 1, stats: { mana: 10 } },"
+              "            { name: \"Imp\", color: Red, level: 1 }],"
+              "  nickname: \"orcy\","
+              "  path: [{ x: 1, y: 2, z: 0 }, { x: 3, y: 4, z: 0 }],"
+              "  level: 1, loot_type: [Shield, Sword],"
+              "  loot: [{ armor: 3 }, { damage: 1 }], stats: { hp: 300 } }"),
+          true);
+  std::string expected;
+  TEST_EQ(GenerateText(new_parser, new_parser.builder_.GetBufferPointer(),
+                       &expected),
+          true);
+  TEST_EQ_STR(converted.c_str(), expected.c_str());
+
+  // Narrowing is refused: evolution_v2 changed an int to a uint.
+  std::string v1, v2;
+  TEST_EQ(flatbuffers::LoadFile(
+              (tests_data_path + "evolution_test/evolution_v1.fbs").c_str(),
+              false, &v1),
+          true);
+  TEST_EQ(flatbuffers::LoadFile(
+              (tests_data_path + "evolution_test/evolution_v2.fbs").c_str(),
+              false, &v2),
+          true);
+  flatbuffers::Parser v1_parser, v2_parser;
+  const auto v1_bfbs = SerializeSchema(v1_parser, v1);
+  const auto v2_bfbs = SerializeSchema(v2_parser, v2);
+  flatbuffers::SchemaConverter v1_to_v2(
+      *reflection::GetSchema(v1_bfbs.c_str()),
+      *reflection::GetSchema(v2_bfbs.c_str()));
+  TEST_EQ_STR(v1_to_v2.error().c_str(),
+              "Evolution.V2.Root.i: can't convert Int to UInt");
+
+  // So are enum values that were dropped, and bit_flags that moved.
+  flatbuffers::Parser abc_parser, ac_parser;
+  const auto abc_bfbs = SerializeSchema(
+      abc_parser, "enum E : byte { A, B, C } table T { e:E; } root_type T;");
+  const auto ac_bfbs = SerializeSchema(
+      ac_parser, "enum E : byte { A, C } table T { e:E; } root_type T;");
+  flatbuffers::SchemaConverter abc_to_ac(
+      *reflection::GetSchema(abc_bfbs.c_str()),
+      *reflection::GetSchema(ac_bfbs.c_str()));
+  TEST_EQ_STR(abc_to_ac.error().c_str(),
+              "T.e: enum value B has no counterpart");
+  flatbuffers::Parser ab_parser, ba_parser;
+  ab_parser.opts.binary_schema_builtins = true;
+  ba_parser.opts.binary_schema_builtins = true;
+  const auto ab_bfbs = SerializeSchema(
+      ab_parser,
+      "enum F : ubyte (bit_flags) { A, B } table T { f:F; } root_type T;");
+  const auto ba_bfbs = SerializeSchema(
+      ba_parser,
+      "enum F : ubyte (bit_flags) { B, A } table T { f:F; } root_type T;");
+  flatbuffers::SchemaConverter ab_to_ba(
+      *reflection::GetSchema(ab_bfbs.c_str()),
+      *reflection::GetSchema(ba_bfbs.c_str()));
+  TEST_EQ_STR(ab_to_ba.error().c_str(),
+              "T.f: bit_flags value A changed bits\n"
+              "T.f: bit_flags value B changed bits");
+
+  // Vectors of unions, and unions of structs and strings, can't be copied
+  // with CopyTable(), even when they didn't change.
+  std::string movie_schema, movie_json;
+  TEST_EQ(flatbuffers::LoadFile(
+              (tests_data_path + "union_vector/union_vector.fbs").c_str(),
+              false, &movie_schema),
+          true);
+  TEST_EQ(flatbuffers::LoadFile(
+              (tests_data_path + "union_vector/union_vector.json").c_str(),
+              false, &movie_json),
+          true);
+  flatbuffers::IDLOptions movie_opts;
+  movie_opts.lang_to_generate |= flatbuffers::IDLOptions::kBinary;
+  flatbuffers::Parser movie_parser(movie_opts);
+  const auto movie_bfbs = SerializeSchema(movie_parser, movie_schema);
+  auto &movie = *reflection::GetSchema(movie_bfbs.c_str());
+  flatbuffers::SchemaConverter same_movie(movie, movie);
+  TEST_EQ_STR(same_movie.error().c_str(), "");
+  TEST_EQ(movie_parser.Parse(movie_json.c_str()), true);
+  fbb.Clear();
+  same_movie.Convert(fbb, movie_parser.builder_.GetBufferPointer());
+  TEST_EQ(flatbuffers::Verify(movie, *movie.root_table(),
+                              fbb.GetBufferPointer(), fbb.GetSize()),
+          true);
+  std::string movie_text, converted_movie_text;
+  TEST_EQ(GenerateText(movie_parser, movie_parser.builder_.GetBufferPointer(),
+                       &movie_text),
+          true);
+  TEST_EQ(GenerateText(movie_parser, fbb.GetBufferPointer(),
+                       &converted_movie_text),
+          true);
+  TEST_EQ_STR(converted_movie_text.c_str(), movie_text.c_str());
 }
 
 void MiniReflectFlatBuffersTest(uint8_t *flatbuf) {
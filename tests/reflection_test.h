@@ -7,6 +7,11 @@ namespace flatbuffers {
 namespace tests {
 
 void ReflectionTest(const std::string& tests_data_path, uint8_t *flatbuf, size_t length);
+void ResizeSessionTest(const std::string &tests_data_path, uint8_t *flatbuf,
+                       size_t length);
+void CompiledSchemaTest(const std::string &tests_data_path, uint8_t *flatbuf,
+                        size_t length);
+void SchemaConverterTest(const std::string &tests_data_path, uint8_t *flatbuf);
 void MiniReflectFixedLengthArrayTest();
 void MiniReflectFlatBuffersTest(uint8_t *flatbuf);
 
@@ -17,17 +17,25 @@
 
 #include <cmath>
 #include <memory>
+#include <new>
 #include <string>
 
 #include "evolution_test.h"
 #include "alignment_test.h"
+#include "flatbuffers/arena_allocator.h"
+#include "flatbuffers/builder_pool.h"
 #include "flatbuffers/flatbuffers.h"
 #include "flatbuffers/idl.h"
+#include "flatbuffers/mapped_file.h"
 #include "flatbuffers/minireflect.h"
 #include "flatbuffers/registry.h"
 #include "flatbuffers/util.h"
+#include "flatbuffers/verification_cache.h"
+#include "flatbuffers/virtual_memory_allocator.h"
 #include "fuzz_test.h"
+#include "hash_index_test.h"
 #include "json_test.h"
+#include "key_index_test.h"
 #include "monster_test.h"
 #include "monster_test_generated.h"
 #include "optional_scalars_test.h"
@@ -509,8 +517,9 @@ void EqualOperatorTest() {
   }
 }
 
-void CreateSharedStringTest() {
+void CreateSharedStringTest(bool index_shared_strings = false) {
   flatbuffers::FlatBufferBuilder builder;
+  builder.IndexSharedStrings(index_shared_strings);
   const auto one1 = builder.CreateSharedString("one");
   const auto two = builder.CreateSharedString("two");
   const auto one2 = builder.CreateSharedString("one");
@@ -566,6 +575,550 @@ void CreateSharedStringTest() {
   TEST_EQ((*a[6]) < (*a[5]), true);
 }
 
+// Builds tables with `num_shapes` distinct layouts (twice each, so half of
+// the vtables are deduped), switching on the vtable index from table number
+// `index_from` onwards.
+std::vector<uint8_t> BuildManyVtables(int num_shapes, int index_from) {
+  flatbuffers::FlatBufferBuilder builder;
+  std::vector<flatbuffers::Offset<flatbuffers::Table>> tables;
+  for (int i = 0; i < 2 * num_shapes; i++) {
+    if (i == index_from) builder.IndexVtables(true);
+    const int shape = i % num_shapes + 1;
+    const auto start = builder.StartTable();
+    for (flatbuffers::voffset_t field = 0; field < 16; field++) {
+      if (shape & (1 << field)) {
+        builder.AddElement<int32_t>(flatbuffers::FieldIndexToOffset(field),
+                                    i, 0);
+      }
+    }
+    tables.push_back(
+        flatbuffers::Offset<flatbuffers::Table>(builder.EndTable(start)));
+  }
+  builder.Finish(builder.CreateVector(tables));
+  return std::vector<uint8_t>(builder.GetBufferPointer(),
+                              builder.GetBufferPointer() + builder.GetSize());
+}
+
+void VtableIndexTest() {
+  const auto scanned = BuildManyVtables(1000, -1);
+  const auto indexed = BuildManyVtables(1000, 0);
+  // Vtables written before the index was switched on must still be found.
+  const auto mixed = BuildManyVtables(1000, 500);
+  TEST_EQ(scanned.size(), indexed.size());
+  TEST_EQ(scanned == indexed, true);
+  TEST_EQ(scanned == mixed, true);
+
+  // The index must be dropped along with the buffer when clearing.
+  flatbuffers::FlatBufferBuilder builder;
+  builder.IndexVtables(true);
+  for (int round = 0; round < 2; round++) {
+    builder.Clear();
+    const auto start = builder.StartTable();
+    builder.AddElement<int32_t>(flatbuffers::FieldIndexToOffset(1), 7, 0);
+    builder.Finish(flatbuffers::Offset<flatbuffers::Table>(
+        builder.EndTable(start)));
+    const auto table = flatbuffers::GetRoot<flatbuffers::Table>(
+        builder.GetBufferPointer());
+    TEST_EQ(table->GetField<int32_t>(flatbuffers::FieldIndexToOffset(1), 0),
+            7);
+  }
+}
+
+void FlatBufferBuilderPoolTest() {
+  flatbuffers::FlatBufferBuilderPool pool;
+  const uint8_t *released_data[2];
+  for (int i = 0; i < 2; i++) {
+    auto fbb = pool.Acquire();
+    fbb->Finish(CreateMonster(*fbb, nullptr, 150, 80, fbb->CreateString("a")));
+    flatbuffers::DetachedBuffer buffer = fbb->Release();
+    released_data[i] = buffer.data();
+    TEST_EQ(GetMonster(buffer.data())->hp(), 80);
+  }
+  // The memory of the first released buffer was recycled for the second.
+  TEST_EQ(released_data[0], released_data[1]);
+
+  // Builders come back cleared, and are handed out again.
+  flatbuffers::FlatBufferBuilder *returned;
+  {
+    auto fbb = pool.Acquire();
+    fbb->CreateString("unfinished");
+    returned = fbb.get();
+  }
+  auto fbb = pool.Acquire();
+  TEST_EQ(fbb.get(), returned);
+  TEST_EQ(fbb->GetSize(), 0u);
+
+  // Builders whose buffer grew too large give it up, even if they were
+  // cleared before being returned.
+  flatbuffers::FlatBufferBuilderPool::Options opts;
+  opts.max_retained_size = 4096;
+  flatbuffers::FlatBufferBuilderPool small_pool(opts);
+  {
+    auto large = small_pool.Acquire();
+    large->CreateVector(std::vector<uint8_t>(8192, 1));
+    large->Clear();
+  }
+  auto large = small_pool.Acquire();
+  TEST_EQ(large->GetBufferCapacity(), 0u);
+}
+
+void ArenaAllocatorTest() {
+  uint8_t region[4096];
+  flatbuffers::ArenaAllocator arena(region, sizeof(region));
+  for (int round = 0; round < 2; round++) {
+    {
+      // Start small, so the buffer has to grow many times. Growing by copying
+      // would need more than the region holds.
+      flatbuffers::FlatBufferBuilder fbb(64, &arena);
+      std::vector<uint8_t> inventory(1000, 42);
+      auto inv = fbb.CreateVector(inventory);
+      auto name = fbb.CreateString("arena");
+      fbb.Finish(CreateMonster(fbb, nullptr, 150, 80, name, inv));
+      const uint8_t *data = fbb.GetBufferPointer();
+      TEST_EQ(data >= region && data < region + sizeof(region), true);
+      auto monster = GetMonster(data);
+      TEST_EQ_STR(monster->name()->c_str(), "arena");
+      TEST_EQ(monster->inventory()->size(), 1000u);
+      TEST_EQ(monster->inventory()->Get(999), 42);
+    }
+    // The builder gave back its buffer, as the most recent allocation.
+    TEST_EQ(arena.bytes_in_use(), 0u);
+    arena.reset();
+  }
+
+  // Falls back to blocks from upstream when the region is exhausted.
+  uint8_t *small = arena.allocate(1024);
+  uint8_t *large = arena.allocate(8192);
+  TEST_EQ(small >= region && small < region + sizeof(region), true);
+  TEST_EQ(large >= region && large < region + sizeof(region), false);
+  memset(large, 0, 8192);
+  arena.reset();
+  TEST_EQ(arena.allocate(16), small);
+}
+
+void VirtualMemoryAllocatorTest() {
+  flatbuffers::VirtualMemoryAllocator allocator(16 * 1024 * 1024);
+  flatbuffers::FlatBufferBuilder fbb(64, &allocator);
+  auto name = fbb.CreateString("virtual");
+  // The end of the buffer never moves, since growing doesn't copy.
+  const uint8_t *end = fbb.GetCurrentBufferPointer() + fbb.GetSize();
+  std::vector<flatbuffers::Offset<Monster>> monsters;
+  for (int i = 0; i < 10000; i++) {
+    monsters.push_back(CreateMonster(fbb, nullptr, 150, 80, name));
+  }
+  TEST_EQ(fbb.GetCurrentBufferPointer() + fbb.GetSize(), end);
+  auto vec = fbb.CreateVector(monsters);
+  FinishMonsterBuffer(fbb, CreateMonster(fbb, nullptr, 150, 80, name, 0,
+                                         Color_Blue, Any_NONE, 0, 0, 0, vec));
+  flatbuffers::Verifier verifier(fbb.GetBufferPointer(), fbb.GetSize());
+  TEST_EQ(VerifyMonsterBuffer(verifier), true);
+  auto monster = GetMonster(fbb.GetBufferPointer());
+  TEST_EQ(monster->testarrayoftables()->size(), 10000u);
+  TEST_EQ_STR(monster->testarrayoftables()->Get(9999)->name()->c_str(),
+              "virtual");
+
+  // Beyond the reservation, allocating and growing fail.
+  // clang-format off
+  #if FLATBUFFERS_HAS_VIRTUAL_MEMORY
+    flatbuffers::VirtualMemoryAllocator small(64 * 1024);
+    TEST_ASSERT(!small.allocate(128 * 1024));
+    uint8_t *p = small.allocate(1024);
+    TEST_ASSERT(p);
+    TEST_ASSERT(!small.reallocate_downward(p, 1024, 128 * 1024, 0, 0));
+    small.deallocate(p, 1024);
+    #if FLATBUFFERS_HAS_EXCEPTIONS
+      // A builder fails cleanly, and still owns its buffer.
+      flatbuffers::FlatBufferBuilder small_fbb(1024, &small);
+      bool failed = false;
+      try {
+        for (int i = 0; i < 100000; i++) small_fbb.CreateString("virtual");
+      } catch (const std::bad_alloc &) {
+        failed = true;
+      }
+      TEST_ASSERT(failed);
+      TEST_ASSERT(small_fbb.GetSize() <= 64 * 1024);
+    #endif
+  #endif
+  // clang-format on
+}
+
+void ParallelVerifierTest() {
+  flatbuffers::FlatBufferBuilder fbb;
+  std::vector<flatbuffers::Offset<Monster>> monsters;
+  for (int i = 0; i < 1000; i++) {
+    auto name = fbb.CreateString("monster" + flatbuffers::NumToString(i));
+    monsters.push_back(CreateMonster(fbb, nullptr, 150, 80, name));
+  }
+  auto vec = fbb.CreateVector(monsters);
+  FinishMonsterBuffer(fbb, CreateMonster(fbb, nullptr, 150, 80,
+                                         fbb.CreateString("root"), 0,
+                                         Color_Blue, Any_NONE, 0, 0, 0, vec));
+
+  // Runs the tasks back to front, so they don't happen to run in order.
+  size_t num_tasks_run = 0;
+  const flatbuffers::Verifier::Executor executor =
+      [&](size_t num_tasks, const std::function<void(size_t)> &task) {
+        for (size_t i = num_tasks; i > 0; i--) task(i - 1);
+        num_tasks_run += num_tasks;
+      };
+  auto verify = [&](const flatbuffers::Verifier::Options &opts,
+                    bool parallel) {
+    flatbuffers::Verifier verifier(fbb.GetBufferPointer(), fbb.GetSize(),
+                                   opts);
+    if (parallel) verifier.SetExecutor(&executor, 64);
+    return VerifyMonsterBuffer(verifier);
+  };
+
+  flatbuffers::Verifier::Options opts;
+  TEST_EQ(verify(opts, false), true);
+  TEST_EQ(verify(opts, true), true);
+  TEST_EQ(num_tasks_run, 16u);
+
+  // Tables are counted across tasks.
+  opts.max_tables = 1001;
+  TEST_EQ(verify(opts, false), true);
+  TEST_EQ(verify(opts, true), true);
+  opts.max_tables = 1000;
+  TEST_EQ(verify(opts, false), false);
+  TEST_EQ(verify(opts, true), false);
+
+  // An error in any one task fails the whole buffer.
+  opts = flatbuffers::Verifier::Options();
+  auto name = GetMonster(fbb.GetBufferPointer())
+                  ->testarrayoftables()
+                  ->Get(700)
+                  ->name();
+  flatbuffers::WriteScalar<flatbuffers::uoffset_t>(
+      const_cast<flatbuffers::String *>(name), 0x7FFFFFF0);
+  TEST_EQ(verify(opts, false), false);
+  TEST_EQ(verify(opts, true), false);
+}
+
+void VerificationCacheTest() {
+  flatbuffers::FlatBufferBuilder fbb;
+  FinishMonsterBuffer(fbb, CreateMonster(fbb, nullptr, 150, 80,
+                                         fbb.CreateString("cached")));
+  std::vector<uint8_t> buf(fbb.GetBufferPointer(),
+                           fbb.GetBufferPointer() + fbb.GetSize());
+
+  // Byte-identical buffers are only verified once.
+  flatbuffers::VerificationCache cache("MyGame.Example.Monster");
+  TEST_EQ(cache.VerifyBuffer<Monster>(buf.data(), buf.size(),
+                                      MonsterIdentifier()),
+          true);
+  TEST_EQ(cache.size(), 1u);
+  std::vector<uint8_t> copy = buf;
+  TEST_EQ(cache.VerifyBuffer<Monster>(copy.data(), copy.size(),
+                                      MonsterIdentifier()),
+          true);
+  TEST_EQ(cache.size(), 1u);
+
+  // Other options are verified and cached separately.
+  flatbuffers::Verifier::Options opts;
+  opts.max_depth = 1;
+  TEST_EQ(cache.VerifyBuffer<Monster>(buf.data(), buf.size(),
+                                      MonsterIdentifier(), opts),
+          true);
+  TEST_EQ(cache.size(), 2u);
+  opts.max_tables = 0;
+  TEST_EQ(cache.VerifyBuffer<Monster>(buf.data(), buf.size(),
+                                      MonsterIdentifier(), opts),
+          false);
+  TEST_EQ(cache.size(), 2u);
+
+  // Failures are not cached.
+  auto name = GetMonster(copy.data())->name();
+  flatbuffers::WriteScalar<flatbuffers::uoffset_t>(
+      const_cast<flatbuffers::String *>(name), 0x7FFFFFF0);
+  TEST_EQ(cache.VerifyBuffer<Monster>(copy.data(), copy.size(),
+                                      MonsterIdentifier()),
+          false);
+  TEST_EQ(cache.size(), 2u);
+
+  // Entries survive serialization, but not a change of schema.
+  std::string sidecar;
+  cache.Serialize(&sidecar);
+  flatbuffers::VerificationCache restored("MyGame.Example.Monster");
+  TEST_EQ(restored.Deserialize(sidecar), true);
+  TEST_EQ(restored.size(), 2u);
+  TEST_EQ(restored.VerifyBuffer<Monster>(buf.data(), buf.size(),
+                                         MonsterIdentifier()),
+          true);
+  TEST_EQ(restored.size(), 2u);
+  flatbuffers::VerificationCache other("MyGame.Example.Monster v2");
+  TEST_EQ(other.Deserialize(sidecar), true);
+  TEST_EQ(other.VerifyBuffer<Monster>(buf.data(), buf.size(),
+                                      MonsterIdentifier()),
+          true);
+  TEST_EQ(other.size(), 3u);
+  TEST_EQ(other.Deserialize(sidecar.substr(1)), false);
+  TEST_EQ(other.Deserialize(sidecar.substr(0, sidecar.size() - 1)), false);
+
+  // A damaged digest matches nothing.
+  std::string tampered = sidecar;
+  tampered[sizeof(uint64_t)] ^= 1;
+  flatbuffers::VerificationCache tampered_cache("MyGame.Example.Monster");
+  TEST_EQ(tampered_cache.Deserialize(tampered), true);
+  TEST_EQ(tampered_cache.VerifyBuffer<Monster>(buf.data(), buf.size(),
+                                               MonsterIdentifier()),
+          true);
+  TEST_EQ(tampered_cache.size(), 3u);
+
+  // The cache is bounded, and drops the oldest entries first.
+  flatbuffers::VerificationCache::Options cache_opts;
+  cache_opts.max_entries = 1;
+  flatbuffers::VerificationCache small("MyGame.Example.Monster", cache_opts);
+  TEST_EQ(small.Deserialize(sidecar), true);
+  TEST_EQ(small.size(), 1u);
+  TEST_EQ(small.VerifyBuffer<Monster>(buf.data(), buf.size()), true);
+  TEST_EQ(small.size(), 1u);
+
+  // The digests are plain SHA-256 (FIPS 180-4 test vectors).
+  auto sha256 = [](const std::string &message) {
+    flatbuffers::Sha256 sha;
+    // Split the message to exercise buffering across blocks.
+    sha.Update(message.data(), message.size() / 3);
+    sha.Update(message.data() + message.size() / 3,
+               message.size() - message.size() / 3);
+    uint8_t digest[flatbuffers::Sha256::kDigestSize];
+    sha.Finish(digest);
+    std::string hex;
+    for (size_t i = 0; i < sizeof(digest); i++) {
+      hex += flatbuffers::IntToStringHex(digest[i], 2);
+    }
+    return hex;
+  };
+  TEST_EQ_STR(sha256("").c_str(),
+              "E3B0C44298FC1C149AFBF4C8996FB924"
+              "27AE41E4649B934CA495991B7852B855");
+  TEST_EQ_STR(sha256("abc").c_str(),
+              "BA7816BF8F01CFEA414140DE5DAE2223"
+              "B00361A396177A9CB410FF61F20015AD");
+  TEST_EQ_STR(
+      sha256("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq")
+          .c_str(),
+      "248D6A61D20638B8E5C026930C3E6039"
+      "A33CE45964FF2167F6ECEDD419DB06C1");
+  TEST_EQ_STR(sha256(std::string(1000000, 'a')).c_str(),
+              "CDC76E5C9914FB9281A1C7E284D73E67"
+              "F1809A48A497200E046D39CCC7112CD0");
+}
+
+void VerifyVectorOfStringsTest() {
+  flatbuffers::FlatBufferBuilder fbb;
+  std::vector<std::string> strings;
+  // Not a multiple of 4, so some strings are checked by the scalar tail.
+  for (int i = 0; i < 39; i++) strings.push_back(std::string(i % 7, 'x'));
+  auto vec = fbb.CreateVectorOfStrings(strings);
+  auto name = fbb.CreateString("strings");
+  MonsterBuilder mb(fbb);
+  mb.add_name(name);
+  mb.add_testarrayofstring(vec);
+  FinishMonsterBuffer(fbb, mb.Finish());
+  const std::vector<uint8_t> good(fbb.GetBufferPointer(),
+                                  fbb.GetBufferPointer() + fbb.GetSize());
+
+  auto verify = [](std::vector<uint8_t> &buf) {
+    flatbuffers::Verifier verifier(buf.data(), buf.size());
+    return VerifyMonsterBuffer(verifier);
+  };
+  // Returns the position of the offset to string `i`, and of that string.
+  auto locate = [](std::vector<uint8_t> &buf, flatbuffers::uoffset_t i,
+                   size_t *str) {
+    auto strings = GetMutableMonster(buf.data())->testarrayofstring();
+    const auto elem = reinterpret_cast<const uint8_t *>(strings->Data()) +
+                      i * sizeof(flatbuffers::uoffset_t) - buf.data();
+    *str = reinterpret_cast<const uint8_t *>(strings->Get(i)) - buf.data();
+    return static_cast<size_t>(elem);
+  };
+
+  std::vector<uint8_t> buf = good;
+  TEST_EQ(verify(buf), true);
+  // Break strings covered by the bulk checks and by the scalar tail.
+  for (flatbuffers::uoffset_t i = 0; i < 39; i += 37) {
+    size_t str;
+    // Out of bounds.
+    buf = good;
+    auto elem = locate(buf, i, &str);
+    flatbuffers::WriteScalar<flatbuffers::uoffset_t>(
+        &buf[elem], static_cast<flatbuffers::uoffset_t>(buf.size()));
+    TEST_EQ(verify(buf), false);
+    flatbuffers::WriteScalar<flatbuffers::uoffset_t>(&buf[elem], 0xFFFFFFF0);
+    TEST_EQ(verify(buf), false);
+    // Misaligned.
+    buf = good;
+    elem = locate(buf, i, &str);
+    flatbuffers::WriteScalar<flatbuffers::uoffset_t>(
+        &buf[elem], static_cast<flatbuffers::uoffset_t>(str - elem + 1));
+    TEST_EQ(verify(buf), false);
+    // Too long.
+    buf = good;
+    locate(buf, i, &str);
+    flatbuffers::WriteScalar<flatbuffers::uoffset_t>(
+        &buf[str], static_cast<flatbuffers::uoffset_t>(buf.size()));
+    TEST_EQ(verify(buf), false);
+    // Not terminated.
+    buf = good;
+    locate(buf, i, &str);
+    buf[str + sizeof(flatbuffers::uoffset_t) + i % 7] = 'x';
+    TEST_EQ(verify(buf), false);
+  }
+}
+
+void MappedFileTest(const std::string &tests_data_path) {
+  const std::string filename = tests_data_path + "monsterdata_test.mon";
+  std::string contents;
+  TEST_EQ(flatbuffers::LoadFile(filename.c_str(), true, &contents), true);
+
+  flatbuffers::MappedFile file;
+  TEST_EQ(flatbuffers::LoadFileMapped(filename.c_str(), &file), true);
+  TEST_EQ(file.size(), contents.size());
+  TEST_EQ(memcmp(file.data(), contents.data(), contents.size()), 0);
+  if (file.mapped()) TEST_EQ(file.Advise(file.kAdviceNormal), true);
+
+  // Moving keeps the contents where they are.
+  const uint8_t *data = file.data();
+  flatbuffers::MappedFile moved(std::move(file));
+  TEST_EQ(moved.data(), data);
+  TEST_ASSERT(!file.data());
+  auto monster = moved.GetVerifiedRoot<Monster>(MonsterIdentifier());
+  TEST_NOTNULL(monster);
+  TEST_EQ_STR(monster->name()->c_str(), "MyMonster");
+  TEST_EQ(moved.GetVerifiedRoot<Monster>(MonsterIdentifier()), monster);
+
+  // Buffers that don't verify have no verified root.
+  TEST_EQ(file.Open((tests_data_path + "monster_test.bfbs").c_str()), true);
+  TEST_ASSERT(!file.GetVerifiedRoot<Monster>(MonsterIdentifier()));
+  TEST_EQ(file.GetRoot<Monster>() != nullptr, true);
+
+  TEST_EQ(file.Open((tests_data_path + "no_such_file.mon").c_str()), false);
+  TEST_EQ(file.size(), 0u);
+  TEST_EQ(file.Open(tests_data_path.c_str()), false);
+}
+
+template<typename T> flatbuffers::span<T> SpanOf(std::vector<T> &v) {
+  return flatbuffers::span<T>(v.data(), v.size());
+}
+
+template<typename T>
+flatbuffers::span<const T> SpanOf(const std::vector<T> &v) {
+  return flatbuffers::span<const T>(v.data(), v.size());
+}
+
+void LookupByKeysTest() {
+  flatbuffers::FlatBufferBuilder fbb;
+  std::vector<flatbuffers::Offset<Monster>> monsters;
+  std::vector<flatbuffers::Offset<Stat>> stats;
+  for (int i = 0; i < 100; i++) {
+    auto name = fbb.CreateString("m" + flatbuffers::NumToString(i * 2));
+    monsters.push_back(CreateMonster(fbb, nullptr, 150, 80, name));
+    stats.push_back(CreateStat(fbb, 0, i, static_cast<uint16_t>(i * 2)));
+  }
+  auto monster_vec = fbb.CreateVectorOfSortedTables(&monsters);
+  auto stat_vec = fbb.CreateVectorOfSortedTables(&stats);
+  auto name = fbb.CreateString("root");
+  MonsterBuilder mb(fbb);
+  mb.add_name(name);
+  mb.add_testarrayoftables(monster_vec);
+  mb.add_scalar_key_sorted_tables(stat_vec);
+  FinishMonsterBuffer(fbb, mb.Finish());
+  auto root = GetMonster(fbb.GetBufferPointer());
+  auto monster_tables = root->testarrayoftables();
+  auto stat_tables = root->scalar_key_sorted_tables();
+
+  // Present and missing keys, in shuffled, sorted and descending order, with
+  // repeats, and ones beyond both ends.
+  std::vector<uint16_t> counts;
+  for (int i = 0; i < 203; i++) counts.push_back((i * 71) % 203);
+  std::vector<uint16_t> sorted_counts(counts);
+  std::sort(sorted_counts.begin(), sorted_counts.end());
+  sorted_counts.push_back(4);
+  sorted_counts.push_back(4);
+  sorted_counts.push_back(0);
+  std::vector<uint16_t> descending_counts(sorted_counts.rbegin(),
+                                          sorted_counts.rend());
+  const std::vector<uint16_t> *count_lists[] = { &counts, &sorted_counts,
+                                                 &descending_counts };
+  for (auto keys : count_lists) {
+    std::vector<const Stat *> found(keys->size()), sorted_found(keys->size());
+    stat_tables->LookupByKeys(SpanOf(*keys), SpanOf(found));
+    stat_tables->LookupBySortedKeys(SpanOf(*keys), SpanOf(sorted_found));
+    for (size_t i = 0; i < keys->size(); i++) {
+      auto expected = stat_tables->LookupByKey((*keys)[i]);
+      TEST_EQ(found[i], expected);
+      TEST_EQ(sorted_found[i], expected);
+      TEST_EQ(expected != nullptr, (*keys)[i] % 2 == 0 && (*keys)[i] < 200);
+    }
+  }
+
+  std::vector<std::string> names;
+  for (int i = 0; i < 201; i++) {
+    names.push_back("m" + flatbuffers::NumToString(i));
+  }
+  names.push_back("");
+  names.push_back("z");
+  std::sort(names.begin(), names.end());
+  std::vector<const char *> name_keys;
+  for (auto &n : names) name_keys.push_back(n.c_str());
+  std::vector<const Monster *> found(name_keys.size());
+  monster_tables->LookupBySortedKeys(SpanOf(name_keys), SpanOf(found));
+  for (size_t i = 0; i < name_keys.size(); i++) {
+    TEST_EQ(found[i], monster_tables->LookupByKey(name_keys[i]));
+  }
+  std::reverse(name_keys.begin(), name_keys.end());
+  monster_tables->LookupByKeys(SpanOf(name_keys), SpanOf(found));
+  for (size_t i = 0; i < name_keys.size(); i++) {
+    TEST_EQ(found[i], monster_tables->LookupByKey(name_keys[i]));
+  }
+
+  // An empty vector finds nothing.
+  flatbuffers::FlatBufferBuilder empty_fbb;
+  std::vector<flatbuffers::Offset<Stat>> no_stats;
+  empty_fbb.Finish(empty_fbb.CreateVectorOfSortedTables(&no_stats));
+  auto empty = flatbuffers::GetRoot<
+      flatbuffers::Vector<flatbuffers::Offset<Stat>>>(
+      empty_fbb.GetBufferPointer());
+  std::vector<const Stat *> none(counts.size(), stat_tables->Get(0));
+  empty->LookupByKeys(SpanOf(counts), SpanOf(none));
+  for (auto stat : none) TEST_ASSERT(!stat);
+  none.assign(sorted_counts.size(), stat_tables->Get(0));
+  empty->LookupBySortedKeys(SpanOf(sorted_counts), SpanOf(none));
+  for (auto stat : none) TEST_ASSERT(!stat);
+  // As does an empty batch.
+  stat_tables->LookupByKeys(flatbuffers::span<const uint16_t>(),
+                            flatbuffers::span<const Stat *>());
+
+  // Large vectors are searched in lockstep. Both ways find the first of
+  // duplicate keys.
+  for (int num_stats : { 1000, 160000 }) {
+    flatbuffers::FlatBufferBuilder dup_fbb;
+    std::vector<flatbuffers::Offset<Stat>> dups;
+    for (int i = 0; i < num_stats; i++) {
+      dups.push_back(CreateStat(dup_fbb, 0, i, static_cast<uint16_t>(i / 4)));
+    }
+    dup_fbb.Finish(dup_fbb.CreateVectorOfSortedTables(&dups));
+    auto dup_tables = flatbuffers::GetRoot<
+        flatbuffers::Vector<flatbuffers::Offset<Stat>>>(
+        dup_fbb.GetBufferPointer());
+    std::vector<uint16_t> dup_keys;
+    for (int i = 0; i < 1000; i++) {
+      dup_keys.push_back(static_cast<uint16_t>(i * 7919 % (num_stats / 4 + 5)));
+    }
+    std::vector<const Stat *> dup_found(dup_keys.size());
+    dup_tables->LookupByKeys(SpanOf(dup_keys), SpanOf(dup_found));
+    for (size_t i = 0; i < dup_keys.size(); i++) {
+      auto first = std::lower_bound(
+          dup_tables->begin(), dup_tables->end(), dup_keys[i],
+          [](const Stat *stat, uint16_t key) { return stat->count() < key; });
+      auto expected = first != dup_tables->end() &&
+                              first->count() == dup_keys[i]
+                          ? *first
+                          : nullptr;
+      TEST_EQ(dup_found[i], expected);
+    }
+  }
+}
+
 #if !defined(FLATBUFFERS_USE_STD_SPAN) && !defined(FLATBUFFERS_SPAN_MINIMAL)
 void FlatbuffersSpanTest() {
   // Compile-time checking of non-const [] to const [] conversions.
@@ -1418,6 +1971,7 @@ int FlatBufferTests(const std::string &tests_data_path) {
   SizePrefixedTest();
 
   AlignmentTest();
+  HashIndexTest();
 
 #ifndef FLATBUFFERS_NO_FILE_TESTS
   ParseAndGenerateTextTest(tests_data_path, false);
@@ -1425,6 +1979,9 @@ int FlatBufferTests(const std::string &tests_data_path) {
   FixedLengthArrayJsonTest(tests_data_path, false);
   FixedLengthArrayJsonTest(tests_data_path, true);
   ReflectionTest(tests_data_path, flatbuf.data(), flatbuf.size());
+  ResizeSessionTest(tests_data_path, flatbuf.data(), flatbuf.size());
+  CompiledSchemaTest(tests_data_path, flatbuf.data(), flatbuf.size());
+  SchemaConverterTest(tests_data_path, flatbuf.data());
   ParseProtoTest(tests_data_path);
   ParseProtoTestWithSuffix(tests_data_path);
   ParseProtoTestWithIncludes(tests_data_path);
@@ -1442,6 +1999,7 @@ int FlatBufferTests(const std::string &tests_data_path) {
   TestMonsterExtraFloats(tests_data_path);
   ParseIncorrectMonsterJsonTest(tests_data_path);
   FixedLengthArraySpanTest(tests_data_path);
+  MappedFileTest(tests_data_path);
 #endif
 
   UtilConvertCase();
@@ -1463,6 +2021,7 @@ int FlatBufferTests(const std::string &tests_data_path) {
   UnicodeTestAllowNonUTF8();
   UnicodeTestGenerateTextFailsOnNonUTF8();
   UnicodeSurrogatesTest();
+  StringConstantTest();
   UnicodeInvalidSurrogatesTest();
   InvalidUTF8Test();
   UnknownFieldsTest();
@@ -1473,13 +2032,30 @@ int FlatBufferTests(const std::string &tests_data_path) {
   TypeAliasesTest();
   EndianSwapTest();
   CreateSharedStringTest();
+  CreateSharedStringTest(true);
+  VtableIndexTest();
+  FlatBufferBuilderPoolTest();
+  ArenaAllocatorTest();
+  VirtualMemoryAllocatorTest();
+  ParallelVerifierTest();
+  VerificationCacheTest();
+  VerifyVectorOfStringsTest();
+  KeyIndexTest();
+  LookupByKeysTest();
   FlexBuffersTest();
   FlexBuffersReuseBugTest();
   FlexBuffersDeprecatedTest();
+  FlexBuffersMapKeyHashesTest();
+  FlexBuffersSortedMapTest();
+  FlexBuffersShareKeyVectorsTest();
+  FlexBuffersJsonLinesTest();
   UninitializedVectorTest();
   EqualOperatorTest();
   NumericUtilsTest();
+  StringToNumberTest();
   IsAsciiUtilsTest();
+  AppendNumToStringTest();
+  EscapeStringTest();
   ValidFloatTest();
   InvalidFloatTest();
   FixedLengthArrayTest();
@@ -1,5 +1,7 @@
 #include "util_test.h"
 
+#include <cmath>
+
 #include "flatbuffers/util.h"
 #include "test_assert.h"
 
@@ -32,6 +34,12 @@ void NumericUtilsTestFloat(const char *lower, const char *upper) {
   TEST_EQ(flatbuffers::StringToNumber(lower, &f), true);
   TEST_EQ(f, -flatbuffers::numeric_limits<T>::infinity());
 }
+template<typename T> void CheckAppendNumToString(T t) {
+  std::string s = "x";
+  AppendNumToString(t, &s);
+  TEST_EQ_STR(s.c_str(), ("x" + NumToString(t)).c_str());
+}
+
 }  // namespace
 
 void NumericUtilsTest() {
@@ -44,6 +52,66 @@ void NumericUtilsTest() {
   NumericUtilsTestFloat<float>("-1.7977e+308", "+1.7977e+308");
 }
 
+void StringToNumberTest() {
+  double d;
+  TEST_ASSERT(StringToNumber("0.1", &d) && d == 0.1);
+  TEST_ASSERT(StringToNumber("-.5e+3", &d) && d == -500);
+  TEST_ASSERT(StringToNumber("5.", &d) && d == 5);
+  TEST_ASSERT(StringToNumber("1e-22", &d) && d == 1e-22);
+  // Past the fast path: too many digits, or a power of ten too large.
+  TEST_ASSERT(StringToNumber("1e23", &d) && d == 1e23);
+  TEST_ASSERT(StringToNumber("0.30000000000000004441", &d) &&
+              d == 0.30000000000000004441);
+  // Rounds to even.
+  TEST_ASSERT(StringToNumber("9007199254740993", &d) &&
+              d == 9007199254740992.0);
+  TEST_ASSERT(StringToNumber("-0", &d) && d == 0 && std::signbit(d));
+  TEST_ASSERT(!StringToNumber("1e", &d));
+  TEST_ASSERT(!StringToNumber(".", &d));
+  TEST_ASSERT(!StringToNumber("1.5 ", &d));
+
+  float f;
+  // Halfway between two floats, rounded to even.
+  TEST_ASSERT(StringToNumber("16777217", &f) && f == 16777216.0f);
+  TEST_ASSERT(StringToNumber("16777219", &f) && f == 16777220.0f);
+  TEST_ASSERT(StringToNumber("3.4028235e38", &f) &&
+              f == flatbuffers::numeric_limits<float>::max());
+
+  int64_t i;
+  TEST_ASSERT(StringToNumber("-0012", &i) && i == -12);
+  TEST_ASSERT(StringToNumber("+9223372036854775807", &i) &&
+              i == flatbuffers::numeric_limits<int64_t>::max());
+  TEST_ASSERT(StringToNumber("-9223372036854775808", &i) &&
+              i == flatbuffers::numeric_limits<int64_t>::lowest());
+  TEST_ASSERT(StringToNumber("0x10", &i) && i == 16);
+  TEST_ASSERT(!StringToNumber("1.0", &i));
+  uint64_t u;
+  TEST_ASSERT(StringToNumber("18446744073709551615", &u) &&
+              u == flatbuffers::numeric_limits<uint64_t>::max());
+  TEST_ASSERT(!StringToNumber("-1", &u));
+
+  // The fast path agrees with strtod() on random decimals.
+  uint64_t x = 88172645463325252ULL;
+  for (int n = 0; n < 20000; n++) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    std::string s = x >> 63 ? "-" : "";
+    const int num_digits = 1 + static_cast<int>(x % 19);
+    const int dot = static_cast<int>((x >> 8) % 32);
+    uint64_t digits = x * 0x9E3779B97F4A7C15ULL;
+    for (int k = 0; k < num_digits; k++, digits /= 10) {
+      if (k == dot) s += '.';
+      s += static_cast<char>('0' + digits % 10);
+    }
+    if (x >> 40 & 1) {
+      s += "e" + NumToString(static_cast<int>(x >> 48) % 60 - 30);
+    }
+    TEST_ASSERT(StringToNumber(s.c_str(), &d));
+    TEST_EQ(d, strtod(s.c_str(), nullptr));
+  }
+}
+
 void IsAsciiUtilsTest() {
   char c = -128;
   for (int cnt = 0; cnt < 256; cnt++) {
@@ -58,6 +126,79 @@ void IsAsciiUtilsTest() {
   }
 }
 
+void AppendNumToStringTest() {
+  CheckAppendNumToString<int8_t>(-128);
+  CheckAppendNumToString<uint8_t>(255);
+  CheckAppendNumToString<int32_t>(0);
+  CheckAppendNumToString<int64_t>(flatbuffers::numeric_limits<int64_t>::min());
+  CheckAppendNumToString<int64_t>(flatbuffers::numeric_limits<int64_t>::max());
+  CheckAppendNumToString<uint64_t>(
+      flatbuffers::numeric_limits<uint64_t>::max());
+
+  const double doubles[] = {
+    0.0, -0.0, 1.0, -1.5, 0.1, 3.14159265358979, 1e-12, 5e-13, 4.9e-13,
+    -1e-20, 1e15, 123456789.123456789, 9.2e18, 1.8e19, 1e100, 4.9e-324,
+    // Exact ties at the last printed digit round to even.
+    1.0 / (1 << 13) / (1 << 27), 3.0 / (1 << 13) / (1 << 27), 0.5e-12,
+    flatbuffers::numeric_limits<double>::infinity(),
+    -flatbuffers::numeric_limits<double>::infinity(),
+    flatbuffers::numeric_limits<double>::max(),
+  };
+  for (auto d : doubles) {
+    CheckAppendNumToString(d);
+    CheckAppendNumToString(static_cast<float>(d));
+  }
+  // Doubles of all magnitudes, from random bits.
+  uint64_t x = 88172645463325252ULL;
+  for (int i = 0; i < 20000; i++) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    // Mostly exponents near 0, where the numbers are printed here.
+    const uint64_t bits =
+        i % 2 ? x : (x & 0x800FFFFFFFFFFFFFULL) | ((1000 + x % 100) << 52);
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    if (d != d) continue;  // NaN prints differently depending on its bits.
+    CheckAppendNumToString(d);
+    CheckAppendNumToString(static_cast<float>(d));
+  }
+}
+
+void EscapeStringTest() {
+  struct TestCase {
+    std::string input;
+    std::string expected_output;
+  };
+  std::vector<TestCase> cases;
+  cases.push_back({ "", "\"\"" });
+  cases.push_back({ "short", "\"short\"" });
+  cases.push_back({ "a string longer than a word, without escapes",
+                    "\"a string longer than a word, without escapes\"" });
+  cases.push_back({ "tab\tafter 3, \"quotes\" after 12 and a \\ at the end",
+                    "\"tab\\tafter 3, \\\"quotes\\\" after 12 and a "
+                    "\\\\ at the end\"" });
+  cases.push_back({ std::string("nul\0 and \x7F and \x01", 16),
+                    "\"nul\\u0000 and \\u007F and \\u0001\"" });
+  cases.push_back({ "unicode \xE2\x82\xAC and \xF0\x9F\x98\x80 0123456789",
+                    "\"unicode \\u20AC and \\uD83D\\uDE00 0123456789\"" });
+  for (auto &test_case : cases) {
+    std::string text;
+    TEST_ASSERT(EscapeString(test_case.input.c_str(), test_case.input.size(),
+                             &text, false, false));
+    TEST_EQ_STR(text.c_str(), test_case.expected_output.c_str());
+  }
+
+  std::string text;
+  TEST_ASSERT(!EscapeString("invalid \xFF utf-8", 15, &text, false, false));
+  text.clear();
+  TEST_ASSERT(EscapeString("invalid \xFF utf-8", 15, &text, true, false));
+  TEST_EQ_STR(text.c_str(), "\"invalid \\xFF utf-8\"");
+  text.clear();
+  TEST_ASSERT(EscapeString("\xE2\x82\xAC", 3, &text, false, true));
+  TEST_EQ_STR(text.c_str(), "\"\xE2\x82\xAC\"");
+}
+
 void UtilConvertCase() {
   {
     struct TestCase {
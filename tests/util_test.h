@@ -5,7 +5,10 @@ namespace flatbuffers {
 namespace tests {
 
 void NumericUtilsTest();
+void StringToNumberTest();
 void IsAsciiUtilsTest();
+void AppendNumToStringTest();
+void EscapeStringTest();
 void UtilConvertCase();
 
 